@@ -0,0 +1,65 @@
+""" Reads time series written by Dumux::TimeSeriesRecorder (dumux/io/timeseriesrecorder.hh) in binary format,
+    and converts them into comma separated text files.
+
+    usage: python3 timeseries2csv.py file.ts [file.csv] [--header]
+
+    Without output file name, the extension .ts is replaced by .txt (e.g. name_actual_transpiration.ts
+    becomes name_actual_transpiration.txt), i.e. the text file the simulation writes without TimeSeries.Binary = true,
+    scripts using np.loadtxt(..., delimiter = ',') work with both.
+"""
+import sys
+import numpy as np
+
+_types = { 0: np.float64, 1: np.int64 }
+
+
+def read_timeseries(filename):
+    """ returns the column names and a dictionary of numpy arrays (one per column) """
+    with open(filename, "rb") as f:
+        data = f.read()
+    if data[0:8] != b"DUMUXTSR":
+        raise IOError("read_timeseries: " + filename + " is not a time series file")
+    version, num_columns = np.frombuffer(data, dtype = np.uint32, count = 2, offset = 8)
+    if version != 1:
+        raise IOError("read_timeseries: " + filename + " has unknown version {:d}".format(int(version)))
+    pos = 16
+    names, types = [], []
+    for i in range(0, int(num_columns)):
+        n = int(np.frombuffer(data, dtype = np.uint32, count = 1, offset = pos)[0])
+        names.append(data[pos + 4:pos + 4 + n].decode())
+        types.append(_types[data[pos + 4 + n]])
+        pos += 5 + n
+    chunks = { name: [] for name in names }
+    while pos < len(data):
+        rows = int(np.frombuffer(data, dtype = np.uint64, count = 1, offset = pos)[0])
+        pos += 8
+        for name, t in zip(names, types):
+            chunks[name].append(np.frombuffer(data, dtype = t, count = rows, offset = pos))
+            pos += rows * np.dtype(t).itemsize
+    columns = { name: (np.concatenate(chunks[name]) if chunks[name] else np.zeros((0,), dtype = t)) for name, t in zip(names, types) }
+    return names, columns
+
+
+def load_timeseries(filename):
+    """ the time series as 2d array (rows are time steps), like np.loadtxt of the text file """
+    names, columns = read_timeseries(filename)
+    return np.column_stack([columns[name].astype(np.float64) for name in names])
+
+
+def write_csv(filename, names, columns, header = False):
+    """ writes the columns as comma separated values (full precision) """
+    data = np.column_stack([columns[name] for name in names])
+    fmt = ["%d" if columns[name].dtype == np.int64 else "%.17g" for name in names]
+    np.savetxt(filename, data, fmt = fmt, delimiter = ", ", header = ", ".join(names) if header else "")
+
+
+if __name__ == "__main__":
+    args = [a for a in sys.argv[1:] if a != "--header"]
+    if len(args) < 1:
+        print(__doc__)
+        sys.exit(1)
+    infile = args[0]
+    outfile = args[1] if len(args) > 1 else (infile[:-3] if infile.endswith(".ts") else infile) + ".txt"
+    names, columns = read_timeseries(infile)
+    write_csv(outfile, names, columns, "--header" in sys.argv)
+    print("wrote", len(columns[names[0]]) if names else 0, "rows of", ", ".join(names), "to", outfile)
@@ -1,2 +1,16 @@
 # File for module specific CMake tests.
 find_package(CPlantBox)
+
+# zlib compression of the asynchronous vtk output (dumux/io/asyncvtkwriter.hh)
+find_package(ZLIB)
+if(ZLIB_FOUND)
+  dune_register_package_flags(LIBRARIES "${ZLIB_LIBRARIES}"
+                              INCLUDE_DIRS "${ZLIB_INCLUDE_DIRS}"
+                              COMPILE_DEFINITIONS "HAVE_ZLIB=1")
+endif()
+
+# wall time of the solver phases (dumux/common/profiler.hh), e.g. cmake -DDUMUX_ROSI_PROFILING=ON
+option(DUMUX_ROSI_PROFILING "Record the profiling zones of the drivers and write <name>_profile.json" OFF)
+if(DUMUX_ROSI_PROFILING)
+  dune_register_package_flags(COMPILE_DEFINITIONS "DUMUX_PROFILING=1")
+endif()
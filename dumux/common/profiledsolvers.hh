@@ -0,0 +1,105 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \brief Assembler and linear solver wrappers, that profile the phases of the Newton solver
+ */
+#ifndef DUMUX_PROFILED_SOLVERS_HH
+#define DUMUX_PROFILED_SOLVERS_HH
+
+#include <type_traits>
+#include <utility>
+
+#include <dumux/common/profiler.hh>
+#include <dumux/linear/linearsolveracceptsmultitypematrix.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Common
+ * \brief Wraps an assembler (e.g. FVAssembler, ParallelMultiDomainFVAssembler), and profiles the zones
+ *        "assembly" (Jacobian and residual), "residual", and "newton update" (update of the grid variables)
+ *
+ * Use it as the assembler type of the Newton solver, the Newton solver calls the functions of its assembler type,
+ * so the wrapped functions are hidden (not overridden).
+ */
+template<class Assembler>
+class ProfiledAssembler : public Assembler
+{
+public:
+    using Assembler::Assembler;
+
+    // the return types only exist for valid arguments, e.g. the Newton solver tests the support of partial reassembly
+    template<class... Args>
+    auto assembleJacobianAndResidual(Args&&... args)
+    -> decltype(std::declval<Assembler&>().assembleJacobianAndResidual(std::forward<Args>(args)...))
+    {
+        DUMUX_PROFILE_ZONE("assembly");
+        return Assembler::assembleJacobianAndResidual(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    auto assembleResidual(Args&&... args)
+    -> decltype(std::declval<Assembler&>().assembleResidual(std::forward<Args>(args)...))
+    {
+        DUMUX_PROFILE_ZONE("residual");
+        return Assembler::assembleResidual(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    auto updateGridVariables(Args&&... args)
+    -> decltype(std::declval<Assembler&>().updateGridVariables(std::forward<Args>(args)...))
+    {
+        DUMUX_PROFILE_ZONE("newton update");
+        return Assembler::updateGridVariables(std::forward<Args>(args)...);
+    }
+};
+
+/*!
+ * \ingroup Common
+ * \brief Wraps a linear solver backend, and profiles the zone "linear solve"
+ *
+ * The arguments are forwarded as given, e.g. AMGBackend::solve takes the matrix and the right hand side
+ * as non-const references (and modifies them in prepareLinearAlgebra).
+ */
+template<class Solver>
+class ProfiledLinearSolver : public Solver
+{
+public:
+    using Solver::Solver;
+
+    template<class... Args>
+    auto solve(Args&&... args)
+    -> decltype(std::declval<Solver&>().solve(std::forward<Args>(args)...))
+    {
+        DUMUX_PROFILE_ZONE("linear solve");
+        return Solver::solve(std::forward<Args>(args)...);
+    }
+};
+
+//! the wrapper accepts multi type matrices, if the solver does
+template<class Solver>
+struct LinearSolverAcceptsMultiTypeMatrix<ProfiledLinearSolver<Solver>>
+: public LinearSolverAcceptsMultiTypeMatrix<Solver>
+{};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,413 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \brief Wall time of named zones (e.g. assembly, linear solve, grid growth), enabled at compile time
+ */
+#ifndef DUMUX_PROFILER_HH
+#define DUMUX_PROFILER_HH
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#ifndef DUMUX_PROFILING
+#define DUMUX_PROFILING 0 //!< set by the CMake option DUMUX_ROSI_PROFILING
+#endif
+
+namespace Dumux {
+
+/*!
+ * \ingroup Common
+ * \brief Collects the wall time of the zones (see DUMUX_PROFILE_ZONE) of all threads of a process.
+ *
+ * Per zone name the number of calls, the total, and the maximal time are summed up. Additionally, each call
+ * is kept as trace event (up to maxTraceEvents(), the later ones are only counted).
+ * write() aggregates the zones over all MPI ranks and writes
+ *  - <name>_profile.json: per zone the calls (summed over ranks), the total time (min, mean, max over ranks), and the longest call,
+ *  - <name>_trace-<rank>.json: the trace events in the Chrome trace format (chrome://tracing, or https://ui.perfetto.dev).
+ *
+ * Zones only record anything if the code is compiled with DUMUX_PROFILING=1, otherwise write() does nothing.
+ */
+class Profiler
+{
+public:
+    static constexpr bool enabled = DUMUX_PROFILING;
+
+    struct ZoneStatistics
+    {
+        std::string name;
+        long calls = 0;
+        double total = 0.; //!< [s]
+        double max = 0.; //!< longest call [s]
+    };
+
+    //! the profiler of this process
+    static Profiler& instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    //! [s] since the profiler was created
+    double now() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    //! adds a call of the zone name (a string literal) from begin to end [s]
+    void record(const char* name, double begin, double end)
+    {
+        const int thread = threadIndex_();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& z = zones_[name];
+        z.calls++;
+        z.total += end - begin;
+        z.max = std::max(z.max, end - begin);
+        if (events_.size() < maxTraceEvents_)
+            events_.push_back(Event{ name, begin, end - begin, thread });
+        else
+            droppedEvents_++;
+    }
+
+    //! maximal number of trace events kept (default 1e6)
+    std::size_t maxTraceEvents() const
+    { return maxTraceEvents_; }
+
+    void setMaxTraceEvents(std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxTraceEvents_ = n;
+    }
+
+    //! removes all recorded zones and events
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        zones_.clear();
+        events_.clear();
+        droppedEvents_ = 0;
+    }
+
+    //! the zones of this process, sorted by total time (descending)
+    std::vector<ZoneStatistics> statistics() const
+    {
+        std::map<std::string, ZoneStatistics> merged; // the same name might be given by different literals
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& z : zones_) {
+                auto& m = merged[z.first];
+                m.name = z.first;
+                m.calls += z.second.calls;
+                m.total += z.second.total;
+                m.max = std::max(m.max, z.second.max);
+            }
+        }
+        std::vector<ZoneStatistics> s;
+        for (const auto& m : merged)
+            s.push_back(m.second);
+        std::sort(s.begin(), s.end(), [](const auto& a, const auto& b) { return a.total > b.total; });
+        return s;
+    }
+
+    /*!
+     * \brief Writes the aggregated zones (rank 0) and the trace events (every rank), and prints a summary (rank 0)
+     *
+     * Collective, must be called by all ranks of the communicator (e.g. Dune::MPIHelper::getCollectiveCommunication()).
+     */
+    template<class Communication>
+    void write(const std::string& name, const Communication& comm, std::ostream& out = std::cout) const
+    {
+        if (!enabled)
+            return;
+
+        const auto local = statistics();
+        const double elapsed = now();
+
+        // all zone names of all ranks
+        std::string names;
+        for (const auto& z : local)
+            names += z.name + '\n';
+        std::vector<int> lengths(comm.size());
+        int length = names.size();
+        comm.allgather(&length, 1, lengths.data());
+        std::vector<int> displacements(comm.size(), 0);
+        for (int i = 1; i < comm.size(); ++i)
+            displacements[i] = displacements[i-1] + lengths[i-1];
+        std::vector<char> allNames(displacements.back() + lengths.back() + 1);
+        comm.allgatherv(names.data(), length, allNames.data(), lengths.data(), displacements.data());
+        std::set<std::string> nameSet;
+        std::string current;
+        for (std::size_t i = 0; i + 1 < allNames.size(); ++i) {
+            if (allNames[i] == '\n') {
+                nameSet.insert(current);
+                current.clear();
+            }
+            else
+                current += allNames[i];
+        }
+        const std::vector<std::string> zoneNames(nameSet.begin(), nameSet.end());
+
+        // per zone values of this rank (0, if the rank has not called the zone)
+        const std::size_t n = zoneNames.size();
+        std::vector<double> calls(n, 0.), totalMin(n, 0.), totalMax(n, 0.), totalSum(n, 0.), maxCall(n, 0.);
+        for (const auto& z : local) {
+            const auto i = std::lower_bound(zoneNames.begin(), zoneNames.end(), z.name) - zoneNames.begin();
+            calls[i] = z.calls;
+            totalMin[i] = totalMax[i] = totalSum[i] = z.total;
+            maxCall[i] = z.max;
+        }
+        if (n > 0) {
+            comm.sum(calls.data(), n);
+            comm.min(totalMin.data(), n);
+            comm.max(totalMax.data(), n);
+            comm.sum(totalSum.data(), n);
+            comm.max(maxCall.data(), n);
+        }
+        const double elapsedMax = comm.max(elapsed);
+
+        if (comm.rank() == 0) {
+            std::vector<std::size_t> order(n);
+            for (std::size_t i = 0; i < n; ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&](auto a, auto b) { return totalMax[a] > totalMax[b]; });
+
+            std::ofstream json(name + "_profile.json");
+            json << std::setprecision(9) << "{\n  \"ranks\": " << comm.size() << ",\n  \"elapsed\": " << elapsedMax << ",\n  \"zones\": [";
+            for (std::size_t k = 0; k < n; ++k) {
+                const auto i = order[k];
+                json << (k > 0 ? ",\n" : "\n") << "    {\"name\": \"" << escape_(zoneNames[i]) << "\", \"calls\": " << long(calls[i])
+                     << ", \"total\": {\"min\": " << totalMin[i] << ", \"mean\": " << totalSum[i]/comm.size()
+                     << ", \"max\": " << totalMax[i] << "}, \"maxCall\": " << maxCall[i] << "}";
+            }
+            json << "\n  ]\n}\n";
+            if (!json)
+                DUNE_THROW(Dune::IOError, "Profiler: could not write " << name << "_profile.json");
+
+            out << "Profile (" << comm.size() << " ranks, " << elapsedMax << " s, max over ranks):\n";
+            for (const auto i : order)
+                out << "  " << std::left << std::setw(24) << zoneNames[i] << std::right << std::setw(12) << totalMax[i] << " s "
+                    << std::setw(6) << std::fixed << std::setprecision(1) << 100.*totalMax[i]/elapsedMax << std::defaultfloat
+                    << std::setprecision(6) << " %, " << long(calls[i]) << " calls\n";
+        }
+        writeTrace_(name + "_trace-" + std::to_string(comm.rank()) + ".json", comm.rank());
+    }
+
+private:
+    struct Event
+    {
+        const char* name;
+        double begin;
+        double duration;
+        int thread;
+    };
+
+    struct Zone
+    {
+        long calls = 0;
+        double total = 0.;
+        double max = 0.;
+    };
+
+    Profiler()
+    : start_(std::chrono::steady_clock::now())
+    { }
+
+    //! small consecutive indices for the threads (for the trace)
+    static int threadIndex_()
+    {
+        static std::atomic<int> numThreads(0);
+        thread_local const int index = numThreads++;
+        return index;
+    }
+
+    static std::string escape_(const std::string& s)
+    {
+        std::string e;
+        for (const char c : s) {
+            if (c == '"' || c == '\\')
+                e += '\\';
+            e += c;
+        }
+        return e;
+    }
+
+    void writeTrace_(const std::string& fileName, int rank) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::ofstream trace(fileName);
+        trace << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\": \"ms\", \"droppedEvents\": " << droppedEvents_
+              << ", \"traceEvents\": [\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << rank
+              << ", \"args\": {\"name\": \"rank " << rank << "\"}}";
+        for (const auto& e : events_) // [s] -> [us]
+            trace << ",\n{\"name\": \"" << escape_(e.name) << "\", \"ph\": \"X\", \"ts\": " << 1.e6*e.begin << ", \"dur\": " << 1.e6*e.duration
+                  << ", \"pid\": " << rank << ", \"tid\": " << e.thread << "}";
+        trace << "\n]}\n";
+        if (!trace)
+            DUNE_THROW(Dune::IOError, "Profiler: could not write " << fileName);
+    }
+
+    std::chrono::steady_clock::time_point start_;
+    mutable std::mutex mutex_;
+    std::unordered_map<const char*, Zone> zones_;
+    std::vector<Event> events_;
+    std::size_t maxTraceEvents_ = 1000000;
+    std::size_t droppedEvents_ = 0;
+};
+
+/*!
+ * \ingroup Common
+ * \brief Records the wall time from its construction to its destruction as a call of the zone name (use DUMUX_PROFILE_ZONE)
+ */
+class ProfileZone
+{
+public:
+    //! \param name a string literal (zones are identified by the pointer, and merged by name in the output)
+    explicit ProfileZone(const char* name)
+    : name_(name), begin_(Profiler::instance().now())
+    { }
+
+    ~ProfileZone()
+    {
+        auto& profiler = Profiler::instance();
+        profiler.record(name_, begin_, profiler.now());
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    double begin_;
+};
+
+} // end namespace Dumux
+
+#define DUMUX_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DUMUX_PROFILE_CONCAT(a, b) DUMUX_PROFILE_CONCAT_IMPL(a, b)
+
+/*!
+ * \ingroup Common
+ * \brief Profiles the rest of the enclosing scope as zone name (a string literal), nothing if DUMUX_PROFILING is 0
+ */
+#if DUMUX_PROFILING
+#define DUMUX_PROFILE_ZONE(name) const ::Dumux::ProfileZone DUMUX_PROFILE_CONCAT(dumuxProfileZone, __LINE__)(name)
+#else
+#define DUMUX_PROFILE_ZONE(name) do {} while (false)
+#endif
+
+namespace Dumux {
+
+/*!
+ * \ingroup Common
+ * \brief The coupling steps of the coupled root soil drivers, profiled as zones "coupling init", "point source map", and "jacobian pattern"
+ *
+ * init() computes the coupling maps and the point sources of both problems, updateAfterGrowth() updates them
+ * after the root grid grew, either incrementally (the changed root elements only) or as a whole.
+ */
+template<class CouplingManager, class SoilProblem, class RootProblem>
+class ProfiledCoupling
+{
+public:
+    ProfiledCoupling(std::shared_ptr<CouplingManager> couplingManager,
+                     std::shared_ptr<SoilProblem> soilProblem,
+                     std::shared_ptr<RootProblem> rootProblem)
+    : couplingManager_(couplingManager), soilProblem_(soilProblem), rootProblem_(rootProblem)
+    { }
+
+    //! initial coupling maps and point sources
+    template<class SolutionVector>
+    void init(const SolutionVector& sol)
+    {
+        {
+            DUMUX_PROFILE_ZONE("coupling init");
+            couplingManager_->init(soilProblem_, rootProblem_, sol);
+        }
+        computePointSourceMaps_();
+    }
+
+    /*!
+     * \brief Coupling maps, point sources, and matrix pattern after the root grid grew
+     *
+     * After the incremental update the point source maps of the problems are updated by id, and the Jacobian
+     * pattern is only rebuilt if the coupling manager added root elements or coupling stencil entries.
+     *
+     * \param changedElements the new and moved root elements (incremental update), or nullptr to recompute all coupling maps
+     */
+    template<class SoilGridGeometry, class RootGridGeometry, class SolutionVector, class Assembler>
+    void updateAfterGrowth(std::shared_ptr<SoilGridGeometry> soilGridGeometry, std::shared_ptr<RootGridGeometry> rootGridGeometry,
+                           const std::vector<std::size_t>* changedElements, const SolutionVector& sol, Assembler& assembler)
+    {
+        {
+            DUMUX_PROFILE_ZONE("coupling init");
+            if (changedElements) {
+                couplingManager_->update(*changedElements, sol);
+            } else {
+                couplingManager_->updateAfterGridAdaption(soilGridGeometry, rootGridGeometry);
+                couplingManager_->init(soilProblem_, rootProblem_, sol);
+            }
+        }
+        couplingManager_->updateSolution(sol);
+
+        const bool incremental = changedElements && !couplingManager_->pointSourcesRenumbered();
+        if (incremental) {
+            DUMUX_PROFILE_ZONE("point source map");
+            soilProblem_->updatePointSourceMap();
+            rootProblem_->updatePointSourceMap();
+        } else {
+            computePointSourceMaps_();
+        }
+
+        if (!incremental || couplingManager_->couplingStencilsGrew()) {
+            DUMUX_PROFILE_ZONE("jacobian pattern");
+            assembler.setJacobianPattern(assembler.jacobian());
+            assembler.setResidualSize(assembler.residual());
+        }
+    }
+
+private:
+    void computePointSourceMaps_()
+    {
+        DUMUX_PROFILE_ZONE("point source map");
+        soilProblem_->computePointSourceMap();
+        rootProblem_->computePointSourceMap();
+    }
+
+    std::shared_ptr<CouplingManager> couplingManager_;
+    std::shared_ptr<SoilProblem> soilProblem_;
+    std::shared_ptr<RootProblem> rootProblem_;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,171 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief A minimal pool of worker threads for parallel loops over independent tasks
+ */
+#ifndef DUMUX_THREAD_POOL_HH
+#define DUMUX_THREAD_POOL_HH
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Dumux {
+
+/*!
+ * A pool of worker threads, which are started once and wait for work.
+ *
+ * parallelFor(n, f) calls f(i) for all i in [0, n). The tasks are handed out one by one
+ * (dynamic scheduling), the calling thread works as well and returns when all tasks are done.
+ * The first exception thrown by a task is rethrown in the calling thread.
+ *
+ * The pool is meant for coarse tasks (e.g. a chunk of elements), and it is not reentrant,
+ * i.e. f must not call parallelFor of the same pool.
+ */
+class ThreadPool
+{
+public:
+
+    /**
+     * @param numThreads    total number of threads including the calling thread,
+     *                      0 uses std::thread::hardware_concurrency()
+     */
+    explicit ThreadPool(int numThreads = 0) {
+        if (numThreads <= 0) {
+            numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+        }
+        for (int i = 0; i < numThreads - 1; i++) {
+            workers_.emplace_back([this] { work_(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_) {
+            w.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //! number of threads including the calling thread
+    int size() const {
+        return int(workers_.size()) + 1;
+    }
+
+    /**
+     * Calls @param f (i) for all i in [0, @param n), and waits until all calls returned
+     */
+    void parallelFor(int n, const std::function<void(int)>& f) {
+        if (n <= 0) {
+            return;
+        }
+        if (workers_.empty() || n == 1) { // nothing to distribute
+            for (int i = 0; i < n; i++) {
+                f(i);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &f;
+            numTasks_ = n;
+            next_ = 0;
+            busy_ = int(workers_.size());
+            error_ = nullptr;
+            generation_++;
+        }
+        wake_.notify_all();
+        run_();
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return busy_ == 0; });
+        task_ = nullptr;
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+
+    //! worker thread main loop
+    void work_() {
+        unsigned long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+            run_();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                busy_--;
+            }
+            done_.notify_one();
+        }
+    }
+
+    //! processes tasks until none are left
+    void run_() {
+        int i;
+        while ((i = next_.fetch_add(1)) < numTasks_) {
+            try {
+                (*task_)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+                next_ = numTasks_; // skip the remaining tasks
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    const std::function<void(int)>* task_ = nullptr;
+    int numTasks_ = 0;
+    std::atomic<int> next_ { 0 };
+    int busy_ = 0;
+    unsigned long generation_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,232 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief A growth model accumulating several growth steps of another growth model
+ */
+#ifndef DUMUX_BATCHED_GROWTH_HH
+#define DUMUX_BATCHED_GROWTH_HH
+
+#include <array>
+#include <map>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include "growthinterface.hh"
+
+namespace Dumux {
+
+namespace GrowthModule {
+
+/**
+ * Wraps a growth model, and accumulates the changes of all calls of simulate() since the last call of clear(),
+ * i.e. updatedNodes(), newNodes(), newSegments(), etc. describe all these growth steps as a single one.
+ *
+ * This way GridGrowth modifies the grid only once after several growth steps (see GridGrowth::simulate
+ * and GridGrowth::update), and the parameters and coupling maps are only updated once.
+ *
+ * Nodes that were created and moved within the batch are reported as new nodes at their final position,
+ * the creation times of their segments are updated accordingly. Segment parameters (segmentParameter())
+ * are only accumulated for the names passed to the constructor.
+ */
+template<class GlobalPosition>
+class BatchedGrowth :public GrowthInterface<GlobalPosition> {
+
+    using Growth = GrowthInterface<GlobalPosition>;
+
+public:
+
+    /**
+     * @param growth            the wrapped growth model (not owned)
+     * @param parameterNames    segment parameters that are accumulated (see segmentParameter())
+     */
+    BatchedGrowth(Growth* growth, std::vector<std::string> parameterNames = { "order", "id", "radius" }) :
+        growth_(growth) {
+        this->root2dune = growth->root2dune;
+        for (const auto& name : parameterNames) {
+            parameters_[name] = std::vector<double>();
+        }
+    }
+
+    virtual ~BatchedGrowth() { }; // nothing to do
+
+    //! simulates the next dt seconds with the wrapped growth model, and adds the changes to the batch
+    void simulate(double dt) override {
+        growth_->simulate(dt);
+        numSteps_++;
+
+        // nodes that moved (they existed before this step)
+        const auto uni = growth_->updatedNodeIndices();
+        const auto un = growth_->updatedNodes();
+        const auto ucts = growth_->updatedNodeCTs();
+        for (size_t i = 0; i < uni.size(); i++) {
+            if (!newNodes_.empty() && uni[i] >= firstNewNode_) { // created in this batch, update the new node and its segment
+                const size_t j = uni[i] - firstNewNode_;
+                newNodes_.at(j) = un[i];
+                auto s = segmentOfNode_.find(uni[i]);
+                if (s != segmentOfNode_.end()) {
+                    segCTs_[s->second] = ucts[i];
+                }
+            } else {
+                updated_[uni[i]] = std::make_pair(un[i], ucts[i]);
+            }
+        }
+
+        // new nodes and segments
+        const auto nni = growth_->newNodeIndices();
+        const auto nn = growth_->newNodes();
+        if (!nni.empty()) {
+            if (newNodes_.empty()) {
+                firstNewNode_ = nni.front();
+            } else if (nni.front() != firstNewNode_ + newNodes_.size()) {
+                DUNE_THROW(Dune::InvalidStateException, "BatchedGrowth: new nodes are not consecutively numbered");
+            }
+        }
+        newNodes_.insert(newNodes_.end(), nn.begin(), nn.end());
+
+        const auto segs = growth_->newSegments();
+        const auto cts = growth_->segmentCreationTimes();
+        const auto radii = growth_->segmentRadii();
+        for (size_t i = 0; i < segs.size(); i++) {
+            segmentOfNode_[segs[i][1]] = newSegments_.size() + i; // segment ending in the node
+        }
+        newSegments_.insert(newSegments_.end(), segs.begin(), segs.end());
+        segCTs_.insert(segCTs_.end(), cts.begin(), cts.end());
+        segRadii_.insert(segRadii_.end(), radii.begin(), radii.end());
+        for (auto& p : parameters_) {
+            const auto v = growth_->segmentParameter(p.first);
+            p.second.insert(p.second.end(), v.begin(), v.end());
+        }
+    }
+
+    //! starts a new batch, call after the accumulated changes were applied (e.g. by GridGrowth::update and updateParameters)
+    void clear() {
+        updated_.clear();
+        newNodes_.clear();
+        newSegments_.clear();
+        segmentOfNode_.clear();
+        segCTs_.clear();
+        segRadii_.clear();
+        for (auto& p : parameters_) {
+            p.second.clear();
+        }
+        numSteps_ = 0;
+    }
+
+    //! number of growth steps in the current batch
+    int numSteps() const {
+        return numSteps_;
+    }
+
+    double simTime() const override {
+        return growth_->simTime();
+    }
+
+    void store() override { // currently unused
+        growth_->store();
+    }
+
+    void restore() override { // currently unused
+        growth_->restore();
+    }
+
+    std::vector<size_t> updatedNodeIndices() const override {
+        std::vector<size_t> ni;
+        ni.reserve(updated_.size());
+        for (const auto& u : updated_) {
+            ni.push_back(u.first);
+        }
+        return ni;
+    }
+
+    std::vector<GlobalPosition> updatedNodes() const override {
+        std::vector<GlobalPosition> p;
+        p.reserve(updated_.size());
+        for (const auto& u : updated_) {
+            p.push_back(u.second.first);
+        }
+        return p;
+    }
+
+    std::vector<double> updatedNodeCTs() const override {
+        std::vector<double> cts;
+        cts.reserve(updated_.size());
+        for (const auto& u : updated_) {
+            cts.push_back(u.second.second);
+        }
+        return cts;
+    }
+
+    std::vector<size_t> newNodeIndices() const override {
+        auto v = std::vector<size_t>(newNodes_.size());
+        std::iota(v.begin(), v.end(), firstNewNode_);
+        return v;
+    }
+
+    std::vector<GlobalPosition> newNodes() const override {
+        return newNodes_;
+    }
+
+    std::vector<std::array<size_t, 2>> newSegments() const override {
+        return newSegments_;
+    }
+
+    std::vector<double> segmentCreationTimes() const override {
+        return segCTs_;
+    }
+
+    std::vector<double> segmentRadii() const override {
+        return segRadii_;
+    }
+
+    std::vector<double> segmentParameter(std::string name) const override {
+        auto p = parameters_.find(name);
+        if (p == parameters_.end()) {
+            DUNE_THROW(Dune::InvalidStateException, "BatchedGrowth: segment parameter " << name << " is not accumulated");
+        }
+        return p->second;
+    }
+
+private:
+
+    Growth* growth_;
+    int numSteps_ = 0;
+
+    std::map<size_t, std::pair<GlobalPosition, double>> updated_; // moved nodes, that existed before the batch: index -> (position, creation time)
+
+    size_t firstNewNode_ = 0; // index of the first node created in the batch
+    std::vector<GlobalPosition> newNodes_;
+    std::map<size_t, size_t> segmentOfNode_; // node index -> index of the new segment ending in this node
+
+    std::vector<std::array<size_t, 2>> newSegments_;
+    std::vector<double> segCTs_;
+    std::vector<double> segRadii_;
+    std::map<std::string, std::vector<double>> parameters_;
+
+};
+
+} // end namespace GridGrowth
+
+} // end namespace Dumux
+
+#endif
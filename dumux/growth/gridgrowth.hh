@@ -24,6 +24,10 @@
 #define DUMUX_GRIDGROWTH_HH
 
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <future>
+#include <numeric>
 
 #include <dune/common/version.hh>
 #include <dune/common/exceptions.hh>
@@ -32,6 +36,7 @@
 #include <dune/grid/utility/persistentcontainer.hh>
 #include <dumux/common/properties.hh>
 #include <dumux/common/entitymap.hh>
+#include <dumux/common/profiler.hh>
 
 #include "growthinterface.hh" // holds base class, and crootbox interface
 
@@ -53,6 +58,7 @@ class GridGrowth {
     using Element = typename GridView::template Codim<0>::Entity;
     using GlobalPosition = typename Element::Geometry::GlobalCoordinate;
     using PersistentContainer = Dune::PersistentContainer<Grid, PrimaryVariables>;
+    using IndexContainer = Dune::PersistentContainer<Grid, std::size_t>;
     using Growth = GrowthInterface<GlobalPosition>*;
 
 public:
@@ -64,6 +70,7 @@ public:
         growth_(growth),
         indexToVertex_(*grid, fvGridGeometry->vertexMapper()),
         data_(*grid, 0),
+        oldIndices_(*grid, 0),
         sol_(sol) {
         const auto& gv = grid->leafGridView();
         indexMap_.resize(gv.size(Grid::dimension));  // TODO: we assume that in the beginning the node indices are the same
@@ -73,6 +80,65 @@ public:
 
     //! \param dt the time step size in seconds
     void grow(double dt) {
+        simulate(dt);
+        update();
+    }
+
+    /**
+     * Runs the growth model for dt seconds, without modifying the grid (see update()).
+     * \param dt the time step size in seconds
+     */
+    void simulate(double dt) {
+        wait();
+        {
+            DUMUX_PROFILE_ZONE("growth simulate");
+            growth_->simulate(dt);
+        }
+        pendingSteps_.push_back(dt);
+        std::cout << "simulate \n" << std::flush;
+    }
+
+    /**
+     * Runs the growth model for dt seconds on a worker thread and returns immediately.
+     *
+     * The growth model must only read data that is not modified until the next call of update() or wait(),
+     * e.g. a soil look up referencing a copy of the soil state. The grid, the solution, and the growth model
+     * must not be accessed in the meantime, the grid is modified by the next call of update().
+     *
+     * \param dt the time step size in seconds
+     */
+    void simulateAsync(double dt) {
+        wait();
+        pendingSteps_.push_back(dt);
+        pending_ = std::async(std::launch::async, [this, dt]() {
+            DUMUX_PROFILE_ZONE("growth simulate");
+            growth_->simulate(dt);
+        });
+    }
+
+    //! true, if a growth step (e.g. started by simulateAsync()) was not yet applied by update(), also after wait()
+    bool pending() const {
+        return !pendingSteps_.empty();
+    }
+
+    //! waits for a growth step started by simulateAsync() (rethrows its exceptions)
+    void wait() {
+        if (pending_.valid()) {
+            DUMUX_PROFILE_ZONE("growth wait"); // time the caller waits for the asynchronous growth step
+            pending_.get();
+        }
+    }
+
+    /**
+     * Applies the last growth step of the growth model to the grid, i.e. moves the updated nodes,
+     * inserts the new nodes and segments, and transfers the solution to the new grid.
+     * Waits for an asynchronous growth step first.
+     */
+    void update() {
+        wait();
+        DUMUX_PROFILE_ZONE("grid grow");
+        appliedSteps_.insert(appliedSteps_.end(), pendingSteps_.begin(), pendingSteps_.end());
+        pendingSteps_.clear();
 
         // remember the old segment and vertex amount
         const auto& gv = grid_->leafGridView();
@@ -82,14 +148,10 @@ public:
         //! store the old grid data
         storeData_();
 
-        //! grow the root system
-        growth_->simulate(dt);
-
-        std::cout << "simulate \n" << std::flush;
-        auto newNodes2 = growth_->newNodes();
-
         //! get nodes that changed their position
         auto updatedNodeIndices = growth_->updatedNodeIndices();
+        changedElements_.clear();
+        indicesStable_ = true;
         auto updatedNodes = growth_->updatedNodes();
         assert((updatedNodeIndices.size() == updatedNodes.size()) && "GridGrowth: number of updated nodes <> updated indices"); // a little trust...
         for (unsigned int i = 0; i < updatedNodeIndices.size(); i++) {
@@ -176,6 +238,7 @@ public:
                     // rIdx - 1  = root box segment index, where rIdx is the rootbox node index
                     // std::cout << " element: growth insertion index " << insertionIdx << " vs. " << insertionIdx2 << ", final index " << eIdx << "\n"<< std::flush;
                     growth_->root2dune[insertionIdx2] = eIdx; // root2dune[rIdx] = eIdx
+                    changedElements_.push_back(eIdx);
                 }
             }
 
@@ -204,6 +267,50 @@ public:
             DUNE_THROW(Dune::GridError, "Not all segments could be inserted!");
         }
 
+        // the incremental coupling update assumes that old elements keep their index (FoamGrid appends the new ones),
+        // if the grid renumbered them, all elements are reported as changed (i.e. everything is recomputed)
+        if (!indicesStable_) {
+            std::cout << "GridGrowth: the grid renumbered old elements, all elements are marked as changed\n" << std::flush;
+            changedElements_.resize(gv.size(0));
+            std::iota(changedElements_.begin(), changedElements_.end(), 0);
+            return;
+        }
+
+        // segments ending in a moved node (segment rIdx-1 ends in node rIdx)
+        for (auto rIdx : updatedNodeIndices) {
+            if ((rIdx > 0) && (rIdx - 1 < growth_->root2dune.size())) {
+                changedElements_.push_back(growth_->root2dune[rIdx - 1]);
+            }
+        }
+        std::sort(changedElements_.begin(), changedElements_.end());
+        changedElements_.erase(std::unique(changedElements_.begin(), changedElements_.end()), changedElements_.end());
+    }
+
+    /**
+     * Dune element indices of the segments that were created or moved by the last call of grow() or update(),
+     * e.g. to update the coupling manager locally (see EmbeddedCouplingManager1d3d::update).
+     *
+     * The indices of all other elements are unchanged: update() checks that the grid kept the index of each old element,
+     * otherwise all elements are returned.
+     */
+    const std::vector<size_t>& changedElements() const {
+        return changedElements_;
+    }
+
+    /**
+     * Time step sizes [s] of all growth steps that were applied to the grid. Together with the seed of the growth model
+     * they reproduce the current root system, e.g. to restart a simulation from a checkpoint.
+     */
+    const std::vector<double>& growthSteps() const {
+        return appliedSteps_;
+    }
+
+    /**
+     * Time step sizes [s] of the growth steps that were simulated, but not yet applied to the grid (see pending()).
+     * Call wait() first, if a step was started by simulateAsync().
+     */
+    const std::vector<double>& pendingSteps() const {
+        return pendingSteps_;
     }
 
 private:
@@ -224,10 +331,12 @@ private:
      */
     void storeData_() {
         data_.resize();
+        oldIndices_.resize();
         const auto& gv = grid_->leafGridView();
         for (const auto& element : elements(gv)) {
             const auto eIdx = fvGridGeometry_->elementMapper().index(element);
             data_[element] = sol_[eIdx];
+            oldIndices_[element] = eIdx;
         }
     }
 
@@ -237,12 +346,15 @@ private:
      */
     void reconstructData_() {
         data_.resize();
+        oldIndices_.resize();
+        indicesStable_ = true;
         const auto& gv = grid_->leafGridView();
         sol_.resize(gv.size(0));
         for (const auto& element : elements(gv)) { // old elements get their old variables assigned
             if (!element.isNew()) { // get your primary variables from the map
                 const auto eIdx = fvGridGeometry_->elementMapper().index(element);
                 sol_[eIdx] = data_[element];
+                indicesStable_ = indicesStable_ && (oldIndices_[element] == eIdx);
             } else { // initialize new elements with the pressure of the surrounding soil (todo)
                 const auto newEIdx = fvGridGeometry_->elementMapper().index(element);
                 // const auto insertionIdx = grid_->growthInsertionIndex(element); // rhs
@@ -253,6 +365,7 @@ private:
         data_.resize(typename PersistentContainer::Value());
         data_.shrinkToFit();
         data_.fill(typename PersistentContainer::Value());
+        oldIndices_.shrinkToFit();
     }
 
     std::shared_ptr<Grid> grid_; //! the dune-foamgrid
@@ -265,8 +378,16 @@ private:
     std::vector<size_t> indexMapInv_;
 
     PersistentContainer data_; //! data container with persistent ids as key to transfer element data from old to new grid
+    IndexContainer oldIndices_; //! element indices before the last growth step (to check that they did not change)
+    bool indicesStable_ = true; //! old elements kept their indices in the last growth step
 
     SolutionVector& sol_; // the data (non-const) to transfer from the old to the new grid
+
+    std::vector<size_t> changedElements_; //! dune element indices of new and moved segments of the last growth step
+
+    std::future<void> pending_; //! growth step running on a worker thread (see simulateAsync)
+    std::vector<double> pendingSteps_; //! time step sizes of the growth steps, that are not yet applied to the grid
+    std::vector<double> appliedSteps_; //! time step sizes of the growth steps, that are applied to the grid
 };
 
 } // end namespace GridGrowth
@@ -24,11 +24,18 @@
 #ifndef DUMUX_SOIL_LOOKUP_BBOXTREE_HH
 #define DUMUX_SOIL_LOOKUP_BBOXTREE_HH
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
+#include <dune/geometry/typeindex.hh>
 #include <dune/localfunctions/lagrange/pqkfactory.hh>
 #include <dune/grid/common/mcmgmapper.hh>
 #include <soil.h>
 
+#include <dumux/common/threadpool.hh>
+#include <dumux/common/geometry/intersectspointgeometry.hh>
+#include <dumux/common/geometry/intersectingentities.hh>
 #include <dumux/io/inputfilefunction.hh>
 
 namespace Dumux {
@@ -40,6 +47,13 @@ namespace GrowthModule {
  * using a BoundingBoxTree to obtain the soil element,
  * and linear finite elements for interpolation of the point
  *
+ * getValue is reentrant (it may be called concurrently, e.g. for the tropisms of different roots),
+ * and remembers the last hit element: successive samples of a root tip are usually in the same soil
+ * element, and are found without a descent in the bounding box tree. getValues evaluates a batch
+ * of samples, optionally on a thread pool (CPlantBox's tropisms sample single points with getValue,
+ * so it is not called during growth). The local bases of the grid's element types are looked up
+ * in the constructor, because the finite element cache creates its elements lazily (not thread safe).
+ *
  * todo: do i have to update the mappers??? better use fvGridGeometry?
  */
 template<class FVGridGeometry>
@@ -47,15 +61,22 @@ class SoilLookUpBBoxTree : public CPlantBox::SoilLookUp
 {
     using Grid = typename FVGridGeometry::Grid;
     using FeCache = Dune::PQkLocalFiniteElementCache<typename Grid::ctype, double, 3, 1>;
+    using LocalBasis = typename FeCache::FiniteElementType::Traits::LocalBasisType;
     using ShapeValue = typename Dune::FieldVector<double, 1>;
     using BBoxTree = typename FVGridGeometry::BoundingBoxTree;
+    using GlobalPosition = Dune::FieldVector<double, 3>;
 
 public:
 
     SoilLookUpBBoxTree(const FVGridGeometry& fvGridGeometry, const std::vector<double>& sat, bool periodic = true) :
         fvGridGeometry_(fvGridGeometry),
         sat_(sat),
-        bBoxTree_(fvGridGeometry.boundingBoxTree())    {
+        bBoxTree_(fvGridGeometry.boundingBoxTree()),
+        localBasis_(Dune::LocalGeometryTypeIndex::size(Grid::dimension), nullptr) {
+
+        for (const auto& type : fvGridGeometry_.gridView().indexSet().types(0)) {
+            localBasis_[Dune::LocalGeometryTypeIndex::index(type)] = &feCache_.get(type).localBasis();
+        }
 
         if (periodic) {
             const auto size = fvGridGeometry_.bBoxMax() - fvGridGeometry_.bBoxMin();
@@ -70,33 +91,36 @@ public:
      */
     double getValue(const CPlantBox::Vector3d& pos,
     		const std::shared_ptr<CPlantBox::Organ> organ = nullptr) const final {
+        int hint = lastHit_.load(std::memory_order_relaxed);
+        const double sat = value_(pos, hint);
+        lastHit_.store(hint, std::memory_order_relaxed);
+        return sat;
+    }
 
-        auto p = periodic(pos.plus(shiftRB)); // periodic mapping
-        const auto globalPos = Dune::FieldVector<double, 3>( { p.x * 0.01, p.y * 0.01, p.z * 0.01 });
-
-        // std::cout << "getValue() "<< pos.toString() << "->" << p.toString() << " [cm] \n" << std::flush;
-
-        const auto entities = intersectingEntities(globalPos, bBoxTree_); // function from <dumux/common/geometry/intersectingentities.hh>
-
-        if (entities.empty()) {
-            return 0.0;
-        }
-
-        const auto element = bBoxTree_.entitySet().entity(entities[0]);
-        const auto geo = element.geometry();
-        double sat = 0.0;
-
-        const auto& localBasis = feCache_.get(geo.type()).localBasis();
-        const auto ipLocal = geo.local(globalPos);
-        localBasis.evaluateFunction(ipLocal, shapeValues_);
-
-
-        auto vMapper = fvGridGeometry_.vertexMapper();
-        for (int i = 0; i < geo.corners(); ++i) {
-            sat += shapeValues_[i][0]*sat_[vMapper.subIndex(element, i, Grid::dimension)];
+    /**
+     * Returns the interpolated saturations of a batch of points, pos [cm].
+     * The points are evaluated in chunks (in parallel, if a thread pool is given),
+     * successive points should be close to each other (e.g. along a root).
+     */
+    std::vector<double> getValues(const std::vector<CPlantBox::Vector3d>& pos, ThreadPool* pool = nullptr) const {
+        constexpr std::size_t chunkSize = 1024;
+        std::vector<double> values(pos.size());
+        const std::size_t numChunks = (pos.size() + chunkSize - 1) / chunkSize;
+        auto evalChunk = [&](std::size_t c) {
+            int hint = lastHit_.load(std::memory_order_relaxed);
+            const std::size_t end = std::min(pos.size(), (c + 1)*chunkSize);
+            for (std::size_t i = c*chunkSize; i < end; i++) {
+                values[i] = value_(pos[i], hint);
+            }
+        };
+        if (pool && numChunks > 1) {
+            pool->parallelFor(numChunks, [&](int c) { evalChunk(c); });
+        } else {
+            for (std::size_t c = 0; c < numChunks; c++) {
+                evalChunk(c);
+            }
         }
-
-        return sat;
+        return values;
     }
 
     /*
@@ -133,12 +157,48 @@ public:
 
 private:
 
+    /**
+     * Interpolated saturation at pos [cm], @param hint is the entity set index of the last hit element
+     * (-1 for none), and is set to the element containing pos
+     */
+    double value_(const CPlantBox::Vector3d& pos, int& hint) const {
+
+        auto p = periodic(pos.plus(shiftRB)); // periodic mapping
+        const GlobalPosition globalPos({ p.x * 0.01, p.y * 0.01, p.z * 0.01 });
+
+        const auto& entitySet = bBoxTree_.entitySet();
+        if (hint < 0 || !intersectsPointGeometry(globalPos, entitySet.entity(hint).geometry())) {
+            const auto entities = intersectingEntities(globalPos, bBoxTree_); // function from <dumux/common/geometry/intersectingentities.hh>
+            if (entities.empty()) {
+                return 0.0;
+            }
+            hint = entities[0];
+        }
+
+        const auto element = entitySet.entity(hint);
+        const auto geo = element.geometry();
+
+        // scratch space per thread, linear elements have at most 8 shape functions
+        thread_local std::vector<ShapeValue> shapeValues;
+        const auto& localBasis = *localBasis_[Dune::LocalGeometryTypeIndex::index(geo.type())];
+        localBasis.evaluateFunction(geo.local(globalPos), shapeValues);
+
+        const auto& vMapper = fvGridGeometry_.vertexMapper();
+        double sat = 0.0;
+        for (int i = 0; i < geo.corners(); ++i) {
+            sat += shapeValues[i][0]*sat_[vMapper.subIndex(element, i, Grid::dimension)];
+        }
+        return sat;
+    }
+
     const FeCache feCache_;
-    mutable std::vector<ShapeValue> shapeValues_;
 
     const FVGridGeometry& fvGridGeometry_;
     const std::vector<double>& sat_;
     const BBoxTree& bBoxTree_;
+    std::vector<const LocalBasis*> localBasis_; // per local geometry type index, of the element types of the grid
+
+    mutable std::atomic<int> lastHit_ { -1 }; // entity set index of the last hit element (only a hint, relaxed access)
 
     Dune::FieldVector<double, 3> shift = { 0., 0., 0. };
     CPlantBox::Vector3d shiftRB = CPlantBox::Vector3d();
@@ -0,0 +1,177 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief A VtkOutputModule, that optionally writes its fields on a background thread (AsyncVtkWriter)
+ */
+#ifndef DUMUX_ASYNC_VTK_OUTPUT_MODULE_HH
+#define DUMUX_ASYNC_VTK_OUTPUT_MODULE_HH
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/grid/io/file/vtk/common.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/discretization/method.hh>
+#include <dumux/io/vtkoutputmodule.hh>
+#include <dumux/io/asyncvtkwriter.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief A VtkOutputModule, that copies its fields into a VtkSnapshot, which is written by an AsyncVtkWriter
+ *
+ * With Vtk.AsynchronousOutput = true, write() copies the volume variable fields and the fields added with
+ * addField (and the process rank) into a snapshot, i.e. the same data as the VtkOutputModule, and returns while
+ * the file is written (at most Vtk.MaxPendingOutputs snapshots wait, default 2). Otherwise it is the VtkOutputModule.
+ * Only scalar fields can be copied, vector valued volume variables, fields with more than one component,
+ * and the velocity output (Vtk.AddVelocity) throw.
+ * \note write() hides the one of the VtkOutputModule, call it on this type.
+ */
+template<class GridVariables, class SolutionVector>
+class AsyncVtkOutputModule : public VtkOutputModule<GridVariables, SolutionVector>
+{
+    using ParentType = VtkOutputModule<GridVariables, SolutionVector>;
+    using FVGridGeometry = typename GridVariables::FVGridGeometry;
+    using GridView = typename FVGridGeometry::GridView;
+    static constexpr int dim = GridView::dimension;
+    static constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
+
+public:
+    AsyncVtkOutputModule(const GridVariables& gridVariables,
+                         const SolutionVector& sol,
+                         const std::string& name,
+                         const std::string& paramGroup = "")
+    : ParentType(gridVariables, sol, name, paramGroup)
+    , paramGroup_(paramGroup)
+    {
+        if (getParamFromGroup<bool>(paramGroup, "Vtk.AsynchronousOutput", false))
+        {
+            const auto& comm = gridVariables.fvGridGeometry().gridView().comm();
+            const auto maxPending = getParamFromGroup<int>(paramGroup, "Vtk.MaxPendingOutputs", 2); // the simulation waits, if more outputs are pending
+            writer_ = std::make_unique<AsyncVtkWriter>(name, maxPending, comm.rank(), comm.size());
+        }
+    }
+
+    //! writes the fields for the time t, on the background thread if the output is asynchronous
+    void write(double t, Dune::VTK::OutputType type = Dune::VTK::ascii)
+    {
+        if (writer_)
+            writer_->write(snapshot(), t);
+        else
+            ParentType::write(t, type);
+    }
+
+    //! waits until the pending output is written, and throws its errors (call it at the end of the simulation)
+    void finish()
+    {
+        if (writer_)
+            writer_->finish();
+    }
+
+    //! true if the output is written on a background thread
+    bool asynchronous() const
+    { return bool(writer_); }
+
+    //! a copy of the grid and of the fields that write() writes
+    VtkSnapshot snapshot() const
+    {
+        if (!this->volVarVectorDataInfo().empty())
+            DUNE_THROW(Dune::NotImplemented, "AsyncVtkOutputModule: vector valued volume variables cannot be written asynchronously");
+        if (getParamFromGroup<bool>(paramGroup_, "Vtk.AddVelocity", false))
+            DUNE_THROW(Dune::NotImplemented, "AsyncVtkOutputModule: the velocity cannot be written asynchronously");
+
+        const auto& gridGeometry = this->fvGridGeometry();
+        const auto& gridView = gridGeometry.gridView();
+        auto snapshot = makeVtkSnapshot(gridView);
+
+        // volume variables, per dof
+        const auto& volVarInfo = this->volVarScalarDataInfo();
+        if (!volVarInfo.empty())
+        {
+            std::vector<std::vector<double>> volVarData(volVarInfo.size(), std::vector<double>(gridGeometry.numDofs()));
+            for (const auto& element : elements(gridView))
+            {
+                auto fvGeometry = localView(gridGeometry);
+                fvGeometry.bindElement(element);
+                auto elemVolVars = localView(this->gridVariables().curGridVolVars());
+                elemVolVars.bindElement(element, fvGeometry, this->sol());
+                for (const auto& scv : scvs(fvGeometry))
+                    for (std::size_t i = 0; i < volVarInfo.size(); ++i)
+                        volVarData[i][scv.dofIndex()] = volVarInfo[i].get(elemVolVars[scv]);
+            }
+            for (std::size_t i = 0; i < volVarInfo.size(); ++i)
+            {
+                if (isBox)
+                    snapshot.addPointData(volVarData[i], volVarInfo[i].name);
+                else
+                    snapshot.addCellData(volVarData[i], volVarInfo[i].name);
+            }
+        }
+
+        // the fields added with addField, evaluated at the element centers, or at the vertices
+        for (const auto& field : this->fields())
+        {
+            if (field.ncomps() != 1)
+                DUNE_THROW(Dune::NotImplemented, "AsyncVtkOutputModule: field " << field.name() << " has more than one component");
+            if (field.codim() == 0)
+            {
+                std::vector<double> data(gridGeometry.elementMapper().size());
+                for (const auto& element : elements(gridView))
+                {
+                    const auto center = referenceElement(element.geometry()).position(0, 0);
+                    data[gridGeometry.elementMapper().index(element)] = field.evaluate(0, element, center);
+                }
+                snapshot.addCellData(data, field.name());
+            }
+            else
+            {
+                std::vector<double> data(gridGeometry.vertexMapper().size());
+                for (const auto& element : elements(gridView))
+                {
+                    const auto refElement = referenceElement(element.geometry());
+                    for (int i = 0; i < refElement.size(dim); ++i)
+                        data[gridGeometry.vertexMapper().subIndex(element, i, dim)] = field.evaluate(0, element, refElement.position(i, dim));
+                }
+                snapshot.addPointData(data, field.name());
+            }
+        }
+
+        // as the VtkOutputModule
+        if (gridView.comm().size() > 1 && getParamFromGroup<bool>(paramGroup_, "Vtk.AddProcessRank", true))
+            snapshot.addCellData(std::vector<double>(gridGeometry.elementMapper().size(), gridView.comm().rank()), "process rank");
+
+        return snapshot;
+    }
+
+private:
+    std::string paramGroup_;
+    std::unique_ptr<AsyncVtkWriter> writer_;
+};
+
+} // end namespace Dumux
+
+#endif
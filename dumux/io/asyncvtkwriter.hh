@@ -0,0 +1,410 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief Writes VTU files (binary appended, zlib compressed) on a background thread
+ */
+#ifndef DUMUX_ASYNC_VTK_WRITER_HH
+#define DUMUX_ASYNC_VTK_WRITER_HH
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/grid/io/file/vtk/common.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief A copy of an unstructured grid and its fields, independent of the grid and the simulation data
+ *
+ * All data is stored in single precision, like the default output of the VtkOutputModule.
+ */
+struct VtkSnapshot
+{
+    std::vector<float> points; //!< 3 coordinates per vertex
+    std::vector<std::int32_t> connectivity; //!< vertex indices of the cells in VTK order
+    std::vector<std::int32_t> offsets; //!< end of each cell in connectivity
+    std::vector<std::uint8_t> types; //!< VTK cell types
+    std::vector<std::pair<std::string, std::vector<float>>> cellData;
+    std::vector<std::pair<std::string, std::vector<float>>> pointData;
+
+    //! adds a scalar field per cell (e.g. a std::vector or a Dune::BlockVector with blocks of size 1)
+    template<class Container>
+    void addCellData(const Container& v, const std::string& name)
+    {
+        cellData.emplace_back(name, std::vector<float>(v.size()));
+        for (std::size_t i = 0; i < v.size(); ++i)
+            cellData.back().second[i] = value_(v[i], 0);
+    }
+
+    //! adds a scalar field per vertex
+    template<class Container>
+    void addPointData(const Container& v, const std::string& name)
+    {
+        pointData.emplace_back(name, std::vector<float>(v.size()));
+        for (std::size_t i = 0; i < v.size(); ++i)
+            pointData.back().second[i] = value_(v[i], 0);
+    }
+
+private:
+    // blocks (e.g. Dune::FieldVector<double, 1>) are preferred to scalars
+    template<class T>
+    static auto value_(const T& v, int) -> decltype(float(v[0])) { return v[0]; }
+
+    template<class T>
+    static auto value_(const T& v, long) -> decltype(float(v)) { return v; }
+};
+
+/*!
+ * \ingroup InputOutput
+ * \brief Copies the vertices and elements of a grid view into a VtkSnapshot
+ *
+ * Vertices are numbered by the vertex mapper, cells by the element mapper (of the grid geometry),
+ * i.e. fields of the grid geometry can be added in the same order.
+ */
+template<class GridView>
+VtkSnapshot makeVtkSnapshot(const GridView& gridView)
+{
+    static constexpr int dim = GridView::dimension;
+    static constexpr int dimWorld = GridView::dimensionworld;
+    Dune::MultipleCodimMultipleGeomTypeMapper<GridView> vertexMapper(gridView, Dune::mcmgVertexLayout());
+    Dune::MultipleCodimMultipleGeomTypeMapper<GridView> elementMapper(gridView, Dune::mcmgElementLayout());
+
+    VtkSnapshot s;
+    s.points.assign(3*vertexMapper.size(), 0.f);
+    for (const auto& vertex : vertices(gridView)) {
+        const auto idx = vertexMapper.index(vertex);
+        const auto pos = vertex.geometry().corner(0);
+        for (int k = 0; k < dimWorld; ++k)
+            s.points[3*idx + k] = pos[k];
+    }
+
+    const std::size_t numCells = elementMapper.size();
+    std::vector<std::vector<std::int32_t>> cells(numCells);
+    s.types.resize(numCells);
+    for (const auto& element : elements(gridView)) {
+        const auto eIdx = elementMapper.index(element);
+        const auto type = element.type();
+        const int numCorners = element.subEntities(dim);
+        cells[eIdx].resize(numCorners);
+        for (int i = 0; i < numCorners; ++i)
+            cells[eIdx][i] = vertexMapper.subIndex(element, Dune::VTK::renumber(type, i), dim);
+        s.types[eIdx] = Dune::VTK::geometryType(type);
+    }
+    s.offsets.resize(numCells);
+    for (std::size_t i = 0; i < numCells; ++i) {
+        s.connectivity.insert(s.connectivity.end(), cells[i].begin(), cells[i].end());
+        s.offsets[i] = s.connectivity.size();
+    }
+    return s;
+}
+
+/*!
+ * \ingroup InputOutput
+ * \brief Writes a sequence of VTU files (and a PVD collection) on a background thread
+ *
+ * write() only moves the snapshot into a queue, and returns while the file is written. If the queue holds
+ * maxPending snapshots (i.e. the disk is slower than the simulation), write() waits, which bounds the memory.
+ * The data is written in binary appended format, zlib compressed if Dumux is built with zlib (HAVE_ZLIB).
+ *
+ * Files are named like the ones of Dune::VTKSequenceWriter, i.e. name-00000.vtu, or for more than one process
+ * s0004-p0000-name-00000.vtu and s0004-name-00000.pvtu. Every rank writes its own piece, rank 0 writes
+ * the PVTU and the PVD file.
+ */
+class AsyncVtkWriter
+{
+    struct Job
+    {
+        VtkSnapshot snapshot;
+        double time;
+    };
+
+public:
+    /*!
+     * \param name the base name of the files
+     * \param maxPending maximal number of snapshots that wait to be written
+     * \param rank the rank of this process
+     * \param size the number of processes
+     */
+    AsyncVtkWriter(const std::string& name, std::size_t maxPending = 2, int rank = 0, int size = 1)
+    : name_(name), maxPending_(std::max<std::size_t>(maxPending, 1)), rank_(rank), size_(size)
+    {
+        worker_ = std::thread([this]() { run_(); });
+    }
+
+    AsyncVtkWriter(const AsyncVtkWriter&) = delete;
+    AsyncVtkWriter& operator=(const AsyncVtkWriter&) = delete;
+
+    //! writes the remaining snapshots
+    ~AsyncVtkWriter()
+    {
+        try {
+            finish();
+        } catch (std::exception& e) {
+            std::cerr << "AsyncVtkWriter: " << e.what() << std::endl;
+        } catch (Dune::Exception& e) {
+            std::cerr << "AsyncVtkWriter: " << e << std::endl;
+        }
+    }
+
+    //! queues the snapshot for the simulation time t, waits if maxPending snapshots are queued
+    void write(VtkSnapshot&& snapshot, double t)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this]() { return queue_.size() < maxPending_ || error_; });
+        rethrow_();
+        queue_.push_back(Job{ std::move(snapshot), t });
+        notEmpty_.notify_one();
+    }
+
+    //! waits until all snapshots are written, and stops the background thread
+    void finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        notEmpty_.notify_one();
+        if (worker_.joinable())
+            worker_.join();
+        std::lock_guard<std::mutex> lock(mutex_);
+        rethrow_();
+    }
+
+    //! number of files written so far
+    int count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    void rethrow_()
+    {
+        if (error_) {
+            auto e = error_;
+            error_ = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    void run_()
+    {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                notEmpty_.wait(lock, [this]() { return !queue_.empty() || done_; });
+                if (queue_.empty())
+                    return;
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            try {
+                writeFiles_(job);
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++count_;
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::current_exception();
+                queue_.clear();
+            }
+            notFull_.notify_one();
+        }
+    }
+
+    void writeFiles_(const Job& job)
+    {
+        char idx[16];
+        std::snprintf(idx, sizeof(idx), "%05d", static_cast<int>(times_.size()));
+        const std::string piece = pieceName_(rank_) + "-" + idx + ".vtu";
+        writeVtu_(job.snapshot, piece);
+
+        times_.emplace_back(job.time, piece);
+        if (size_ > 1) {
+            char s[16];
+            std::snprintf(s, sizeof(s), "s%04d", size_);
+            times_.back().second = std::string(s) + "-" + name_ + "-" + idx + ".pvtu";
+            if (rank_ == 0)
+                writePvtu_(job.snapshot, times_.back().second, idx);
+        }
+        if (rank_ == 0)
+            writePvd_();
+    }
+
+    std::string pieceName_(int rank) const
+    {
+        if (size_ == 1)
+            return name_;
+        char s[32];
+        std::snprintf(s, sizeof(s), "s%04d-p%04d-", size_, rank);
+        return std::string(s) + name_;
+    }
+
+    //! the data array as it is stored in the appended section (size header and, optionally, compressed blocks)
+    template<class T>
+    static std::string encode_(const std::vector<T>& v)
+    {
+        const char* data = reinterpret_cast<const char*>(v.data());
+        const std::uint64_t numBytes = v.size()*sizeof(T);
+        std::string out;
+#if HAVE_ZLIB
+        const std::uint64_t blockSize = 32768;
+        const std::uint64_t numBlocks = (numBytes + blockSize - 1)/blockSize;
+        std::vector<std::uint64_t> header = { numBlocks, blockSize, numBytes % blockSize };
+        std::string blocks;
+        std::vector<Bytef> buffer(compressBound(blockSize));
+        for (std::uint64_t b = 0; b < numBlocks; ++b) {
+            const std::uint64_t size = std::min(blockSize, numBytes - b*blockSize);
+            uLongf compressedSize = buffer.size();
+            if (compress2(buffer.data(), &compressedSize, reinterpret_cast<const Bytef*>(data + b*blockSize), size, Z_DEFAULT_COMPRESSION) != Z_OK)
+                DUNE_THROW(Dune::IOError, "AsyncVtkWriter: zlib compression failed");
+            header.push_back(compressedSize);
+            blocks.append(reinterpret_cast<const char*>(buffer.data()), compressedSize);
+        }
+        out.append(reinterpret_cast<const char*>(header.data()), header.size()*sizeof(std::uint64_t));
+        out.append(blocks);
+#else
+        out.append(reinterpret_cast<const char*>(&numBytes), sizeof(numBytes));
+        out.append(data, numBytes);
+#endif
+        return out;
+    }
+
+    static std::string byteOrder_()
+    {
+        const std::uint16_t one = 1;
+        return *reinterpret_cast<const char*>(&one) ? "LittleEndian" : "BigEndian";
+    }
+
+    static std::string fileHeader_(const std::string& type)
+    {
+        std::string h = "<?xml version=\"1.0\"?>\n<VTKFile type=\"" + type + "\" version=\"1.0\" byte_order=\""
+                        + byteOrder_() + "\" header_type=\"UInt64\"";
+#if HAVE_ZLIB
+        h += " compressor=\"vtkZLibDataCompressor\"";
+#endif
+        return h + ">\n";
+    }
+
+    void writeVtu_(const VtkSnapshot& s, const std::string& fileName) const
+    {
+        std::string appended;
+        std::ostringstream xml;
+        auto dataArray = [&](const std::string& type, const std::string& name, int components, std::string&& data) {
+            xml << "<DataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\"" << components
+                << "\" format=\"appended\" offset=\"" << appended.size() << "\"/>\n";
+            appended += data;
+        };
+
+        xml << fileHeader_("UnstructuredGrid") << "<UnstructuredGrid>\n"
+            << "<Piece NumberOfPoints=\"" << s.points.size()/3 << "\" NumberOfCells=\"" << s.types.size() << "\">\n";
+        xml << "<PointData>\n";
+        for (const auto& f : s.pointData)
+            dataArray("Float32", f.first, 1, encode_(f.second));
+        xml << "</PointData>\n<CellData>\n";
+        for (const auto& f : s.cellData)
+            dataArray("Float32", f.first, 1, encode_(f.second));
+        xml << "</CellData>\n<Points>\n";
+        dataArray("Float32", "Coordinates", 3, encode_(s.points));
+        xml << "</Points>\n<Cells>\n";
+        dataArray("Int32", "connectivity", 1, encode_(s.connectivity));
+        dataArray("Int32", "offsets", 1, encode_(s.offsets));
+        dataArray("UInt8", "types", 1, encode_(s.types));
+        xml << "</Cells>\n</Piece>\n</UnstructuredGrid>\n<AppendedData encoding=\"raw\">\n_";
+
+        std::ofstream file(fileName, std::ios::binary);
+        file << xml.str();
+        file.write(appended.data(), appended.size());
+        file << "\n</AppendedData>\n</VTKFile>\n";
+        if (!file)
+            DUNE_THROW(Dune::IOError, "AsyncVtkWriter: could not write " << fileName);
+    }
+
+    void writePvtu_(const VtkSnapshot& s, const std::string& fileName, const std::string& idx) const
+    {
+        std::ofstream file(fileName);
+        file << fileHeader_("PUnstructuredGrid") << "<PUnstructuredGrid GhostLevel=\"0\">\n<PPointData>\n";
+        for (const auto& f : s.pointData)
+            file << "<PDataArray type=\"Float32\" Name=\"" << f.first << "\" NumberOfComponents=\"1\"/>\n";
+        file << "</PPointData>\n<PCellData>\n";
+        for (const auto& f : s.cellData)
+            file << "<PDataArray type=\"Float32\" Name=\"" << f.first << "\" NumberOfComponents=\"1\"/>\n";
+        file << "</PCellData>\n<PPoints>\n<PDataArray type=\"Float32\" Name=\"Coordinates\" NumberOfComponents=\"3\"/>\n</PPoints>\n";
+        for (int r = 0; r < size_; ++r)
+            file << "<Piece Source=\"" << pieceName_(r) << "-" << idx << ".vtu\"/>\n";
+        file << "</PUnstructuredGrid>\n</VTKFile>\n";
+        if (!file)
+            DUNE_THROW(Dune::IOError, "AsyncVtkWriter: could not write " << fileName);
+    }
+
+    void writePvd_() const
+    {
+        std::ofstream file(name_ + ".pvd");
+        file << "<?xml version=\"1.0\"?>\n<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << byteOrder_()
+             << "\">\n<Collection>\n";
+        file.precision(16);
+        for (const auto& t : times_)
+            file << "<DataSet timestep=\"" << t.first << "\" group=\"\" part=\"0\" file=\"" << t.second << "\"/>\n";
+        file << "</Collection>\n</VTKFile>\n";
+        if (!file)
+            DUNE_THROW(Dune::IOError, "AsyncVtkWriter: could not write " << name_ << ".pvd");
+    }
+
+    std::string name_;
+    std::size_t maxPending_;
+    int rank_;
+    int size_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<Job> queue_;
+    bool done_ = false;
+    std::exception_ptr error_;
+    int count_ = 0;
+
+    std::vector<std::pair<double, std::string>> times_; // only accessed by the worker
+    std::thread worker_;
+};
+
+} // end namespace Dumux
+
+#endif
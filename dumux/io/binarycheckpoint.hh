@@ -0,0 +1,238 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief A binary checkpoint file of named arrays, to restart simulations
+ */
+#ifndef DUMUX_BINARY_CHECKPOINT_HH
+#define DUMUX_BINARY_CHECKPOINT_HH
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief File name of the checkpoint of an MPI rank, every rank writes and reads its own file
+ */
+inline std::string checkpointFileName(const std::string& name, int rank = 0)
+{
+    return name + "-" + std::to_string(rank) + ".chk";
+}
+
+/*!
+ * \ingroup InputOutput
+ * \brief Writes a checkpoint file, i.e. a sequence of named arrays of a trivially copyable type (in binary form)
+ *
+ * The data is written to a temporary file, which replaces the checkpoint file in close(), so a simulation
+ * that is interrupted while writing does not destroy the previous checkpoint.
+ * The file is only readable on machines with the same endianness and type sizes.
+ */
+class BinaryCheckpointWriter
+{
+public:
+    explicit BinaryCheckpointWriter(const std::string& fileName)
+    : fileName_(fileName), tmpFileName_(fileName + ".tmp"), file_(tmpFileName_, std::ios::binary)
+    {
+        if (!file_)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointWriter: could not open " << tmpFileName_);
+        file_.write("DUMUXCHK", 8);
+        const std::uint32_t version = 1;
+        file_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+
+    //! removes the temporary file, if close() was not called (e.g. because of an exception)
+    ~BinaryCheckpointWriter()
+    {
+        if (file_.is_open()) {
+            file_.close();
+            std::remove(tmpFileName_.c_str());
+        }
+    }
+
+    //! writes an array
+    template<class T>
+    void write(const std::string& name, const std::vector<T>& v)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryCheckpointWriter: type must be trivially copyable");
+        writeBlock_(name, sizeof(T), v.size(), v.data());
+    }
+
+    //! writes a single value
+    template<class T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+    void write(const std::string& name, T value)
+    {
+        write(name, std::vector<T>{ value });
+    }
+
+    //! writes a block vector (e.g. Dune::BlockVector<Dune::FieldVector<double, n>>) as a flat array
+    template<class BlockVector>
+    void writeBlockVector(const std::string& name, const BlockVector& v)
+    {
+        constexpr int blockSize = BlockVector::block_type::dimension;
+        std::vector<typename BlockVector::field_type> flat(v.size()*blockSize);
+        for (std::size_t i = 0; i < v.size(); ++i)
+            for (int j = 0; j < blockSize; ++j)
+                flat[i*blockSize + j] = v[i][j];
+        write(name, flat);
+    }
+
+    //! finishes the file, and replaces the checkpoint file
+    void close()
+    {
+        file_.close();
+        if (!file_)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointWriter: could not write " << tmpFileName_);
+        if (std::rename(tmpFileName_.c_str(), fileName_.c_str()) != 0)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointWriter: could not rename " << tmpFileName_ << " to " << fileName_);
+    }
+
+private:
+    void writeBlock_(const std::string& name, std::uint64_t elementSize, std::uint64_t size, const void* data)
+    {
+        const std::uint32_t nameSize = name.size();
+        file_.write(reinterpret_cast<const char*>(&nameSize), sizeof(nameSize));
+        file_.write(name.data(), nameSize);
+        file_.write(reinterpret_cast<const char*>(&elementSize), sizeof(elementSize));
+        file_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file_.write(static_cast<const char*>(data), elementSize*size);
+        if (!file_)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointWriter: could not write " << name << " to " << tmpFileName_);
+    }
+
+    std::string fileName_;
+    std::string tmpFileName_;
+    std::ofstream file_;
+};
+
+/*!
+ * \ingroup InputOutput
+ * \brief Reads a checkpoint file written by BinaryCheckpointWriter
+ *
+ * The whole file is read in the constructor, the arrays are accessed by their name.
+ */
+class BinaryCheckpointReader
+{
+public:
+    explicit BinaryCheckpointReader(const std::string& fileName)
+    : fileName_(fileName)
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointReader: could not open " << fileName);
+
+        char magic[8];
+        std::uint32_t version = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (!file || std::memcmp(magic, "DUMUXCHK", sizeof(magic)) != 0 || version != 1)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointReader: " << fileName << " is not a checkpoint file (version 1)");
+
+        std::uint32_t nameSize;
+        while (file.read(reinterpret_cast<char*>(&nameSize), sizeof(nameSize))) {
+            std::string name(nameSize, ' ');
+            Block block;
+            std::uint64_t size = 0;
+            file.read(&name[0], nameSize);
+            file.read(reinterpret_cast<char*>(&block.elementSize), sizeof(block.elementSize));
+            file.read(reinterpret_cast<char*>(&size), sizeof(size));
+            block.data.resize(block.elementSize*size);
+            file.read(block.data.data(), block.data.size());
+            if (!file)
+                DUNE_THROW(Dune::IOError, "BinaryCheckpointReader: " << fileName << " is truncated (reading " << name << ")");
+            blocks_[name] = std::move(block);
+        }
+    }
+
+    //! true, if the file contains an array with this name
+    bool has(const std::string& name) const
+    {
+        return blocks_.count(name) > 0;
+    }
+
+    //! reads an array
+    template<class T>
+    std::vector<T> readVector(const std::string& name) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryCheckpointReader: type must be trivially copyable");
+        const auto& block = block_(name);
+        if (block.elementSize != sizeof(T))
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointReader: " << name << " in " << fileName_ << " has elements of size "
+                       << block.elementSize << ", expected " << sizeof(T));
+        std::vector<T> v(block.data.size()/sizeof(T));
+        std::memcpy(v.data(), block.data.data(), block.data.size());
+        return v;
+    }
+
+    //! reads a single value
+    template<class T>
+    T read(const std::string& name) const
+    {
+        const auto v = readVector<T>(name);
+        if (v.size() != 1)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointReader: " << name << " in " << fileName_ << " is not a single value");
+        return v[0];
+    }
+
+    //! reads a block vector written by BinaryCheckpointWriter::writeBlockVector, v is resized
+    template<class BlockVector>
+    void readBlockVector(const std::string& name, BlockVector& v) const
+    {
+        constexpr int blockSize = BlockVector::block_type::dimension;
+        const auto flat = readVector<typename BlockVector::field_type>(name);
+        if (flat.size() % blockSize != 0)
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointReader: size of " << name << " in " << fileName_ << " does not match the block size");
+        v.resize(flat.size()/blockSize);
+        for (std::size_t i = 0; i < v.size(); ++i)
+            for (int j = 0; j < blockSize; ++j)
+                v[i][j] = flat[i*blockSize + j];
+    }
+
+private:
+    struct Block
+    {
+        std::uint64_t elementSize = 0;
+        std::vector<char> data;
+    };
+
+    const Block& block_(const std::string& name) const
+    {
+        const auto it = blocks_.find(name);
+        if (it == blocks_.end())
+            DUNE_THROW(Dune::IOError, "BinaryCheckpointReader: " << name << " not found in " << fileName_);
+        return it->second;
+    }
+
+    std::string fileName_;
+    std::map<std::string, Block> blocks_;
+};
+
+} // end namespace Dumux
+
+#endif
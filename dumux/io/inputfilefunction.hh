@@ -1,6 +1,13 @@
 #ifndef INPUT_FILE_FUNCTION_HH
 #define INPUT_FILE_FUNCTION_HH
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include <dumux/common/parameters.hh>
 #include <dumux/common/math.hh>
 #include <dumux/common/exceptions.hh>
@@ -11,6 +18,113 @@
 
 namespace Dumux {
 
+/**
+ * Linear look up tables (x, y), stored one after another in two flat arrays.
+ *
+ * Evaluation gives the same results as Dumux::interpolate<InterpolationPolicy::LinearTable>, but
+ * the interval is found in O(1) for (approximately) equidistant x, and otherwise by checking the
+ * interval of the last call and its successor (monotone queries, e.g. time series), before
+ * falling back to a binary search.
+ */
+class LinearTables {
+public:
+
+    //! adds a table (x, y), x must be sorted ascending
+    void push_back(const std::pair<std::vector<double>, std::vector<double>>& table) {
+        const auto& x = table.first;
+        const auto& y = table.second;
+        if ((x.size() != y.size()) || x.empty()) {
+            throw Dumux::ParameterException("LinearTables: table sampling points and values must have equal, non-zero length");
+        }
+        Entry e;
+        e.begin = x_.size();
+        e.size = x.size();
+        e.x0 = x.front();
+        if (x.size() > 1) {
+            double dx = (x.back() - x.front()) / (x.size() - 1);
+            e.uniform = dx > 0.;
+            for (size_t i = 1; i < x.size(); i++) {
+                e.uniform = e.uniform && (x[i] > x[i - 1]) && (std::fabs(x[i] - (x.front() + i * dx)) <= 0.01 * dx);
+            }
+            e.invDx = e.uniform ? 1. / dx : 0.;
+        }
+        x_.insert(x_.end(), x.begin(), x.end());
+        y_.insert(y_.end(), y.begin(), y.end());
+        entries_.push_back(e);
+    }
+
+    //! number of tables
+    size_t size() const {
+        return entries_.size();
+    }
+
+    //! linear interpolation of table @param t at @param ip, constant extrapolation
+    double operator()(size_t t, double ip) const {
+        const Entry& e = entries_[t];
+        const double* x = x_.data() + e.begin;
+        const double* y = y_.data() + e.begin;
+        const size_t n = e.size;
+
+        if (ip > x[n - 1]) {
+            return y[n - 1];
+        }
+        if (!(ip > x[0])) { // includes the lower bound itself, and nan
+            return y[0];
+        }
+
+        // the first k with x[k] >= ip (as std::lower_bound), i.e. x[k-1] < ip <= x[k]
+        size_t k;
+        if (e.uniform) {
+            k = std::min(std::max(size_t(std::ceil((ip - e.x0) * e.invDx)), size_t(1)), n - 1);
+            while (x[k - 1] >= ip) { // correct rounding, stops at k = 1 because x[0] < ip
+                k--;
+            }
+            while (x[k] < ip) { // stops at n - 1 because ip <= x[n-1]
+                k++;
+            }
+        } else {
+            k = e.cursor.k.load(std::memory_order_relaxed);
+            if (!((k < n) && (x[k - 1] < ip) && (ip <= x[k]))) {
+                if ((k + 1 < n) && (x[k] < ip) && (ip <= x[k + 1])) {
+                    k++;
+                } else {
+                    k = std::lower_bound(x + 1, x + n, ip) - x;
+                }
+                e.cursor.k.store(k, std::memory_order_relaxed);
+            }
+        }
+
+        const double ipLinear = (ip - x[k - 1]) / (x[k] - x[k - 1]);
+        return Dumux::interpolate<Dumux::InterpolationPolicy::Linear>(ipLinear, std::array<double, 2>{{y[k - 1], y[k]}});
+    }
+
+private:
+
+    //! interval of the last evaluation, only a hint (therefore relaxed atomic), copies the value
+    struct Cursor {
+        Cursor() { }
+        Cursor(const Cursor& c) : k(c.k.load(std::memory_order_relaxed)) { }
+        Cursor& operator=(const Cursor& c) {
+            k.store(c.k.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+        mutable std::atomic<size_t> k { 1 };
+    };
+
+    struct Entry {
+        size_t begin = 0; // first index in x_ and y_
+        size_t size = 0; // number of sampling points
+        bool uniform = false; // equidistant sampling points
+        double x0 = 0.;
+        double invDx = 0.;
+        Cursor cursor;
+    };
+
+    std::vector<double> x_; // sampling points of all tables
+    std::vector<double> y_; // values of all tables
+    std::vector<Entry> entries_;
+};
+
 /**
  * Auxiliary class to pass a value or function in one argument via the input file, or via the grid file.
  * The type is chosen automatically.
@@ -209,7 +323,7 @@ public:
             return fs*yy_[0];
         }
         case table: {
-            return fs*Dumux::interpolate<Dumux::InterpolationPolicy::LinearTable>(x, table_[0]);
+            return fs*table_(0, x);
         }
         case data: {
             return fs*data_.at(eIdx);
@@ -243,7 +357,7 @@ public:
             }
             //            assert( t<table_.size() && "InputFileFunction::f: table type > available tables" );
 
-            return fs*Dumux::interpolate<Dumux::InterpolationPolicy::LinearTable>(x, table_.at(t));
+            return fs*table_(t, x);
         }
         default:
             throw Dumux::ParameterException("InputFileFunction: unknown function type");
@@ -272,6 +386,18 @@ public:
         return f(x, 0);
     }
 
+    /**
+     * Evaluates the function per element index, y[eIdx] = f(x[eIdx], eIdx), e.g. to pre-sample
+     * element arrays once per time step instead of calling f in every iteration
+     */
+    std::vector<double> sample(const std::vector<double>& x) const {
+        std::vector<double> y(x.size());
+        for (size_t eIdx = 0; eIdx < x.size(); eIdx++) {
+            y[eIdx] = f(x[eIdx], eIdx);
+        }
+        return y;
+    }
+
     /**
      * Type index of the InputFileFunction
      */
@@ -352,7 +478,7 @@ private:
     InputFileFunction* iff_ = nullptr;
     std::vector<double> xx_;
     std::vector<double> yy_;
-    std::vector<std::pair<std::vector<double>, std::vector<double>>> table_;
+    LinearTables table_;
     std::vector<double> data_;
 
 };
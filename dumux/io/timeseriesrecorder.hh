@@ -0,0 +1,268 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief Records scalar diagnostics (e.g. transpiration, boundary fluxes) once per time step
+ */
+#ifndef DUMUX_TIME_SERIES_RECORDER_HH
+#define DUMUX_TIME_SERIES_RECORDER_HH
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/parameters.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief Records a time series of rows with named and typed columns, the rows are buffered in memory
+ *        and written to the file every bufferSize rows, or flushInterval seconds (and in flush(), or the destructor)
+ *
+ * The interval is wall clock time, and checked when a row is recorded, i.e. a running simulation writes its rows
+ * at least every flushInterval seconds (plus the time of one time step). Drivers writing checkpoints should call
+ * flush() with each checkpoint, such that the file is complete up to the checkpoint.
+ *
+ * Two file formats are supported:
+ *  - text: comma separated values without header, one row per line (readable by numpy.loadtxt(..., delimiter = ','))
+ *  - binary: columnar, the header is "DUMUXTSR", uint32 version (1), uint32 number of columns,
+ *    and per column uint32 length of the name, the name, and uint8 type (0: float64, 1: int64).
+ *    Each flush appends a chunk: uint64 number of rows n, then the n values of each column.
+ *    The file is only readable on machines with the same endianness (see bin/timeseries2csv.py).
+ *
+ * The columns are added before the first row is recorded.
+ */
+class TimeSeriesRecorder
+{
+public:
+    enum class Format { text, binary };
+    enum class ColumnType : std::uint8_t { float64 = 0, int64 = 1 };
+
+    /*!
+     * \param fileName the file is created (or truncated) when the first rows are written
+     * \param format text or binary
+     * \param bufferSize number of rows kept in memory before they are written
+     * \param flushInterval [s] wall clock time after which recorded rows are written, no limit if <= 0
+     */
+    explicit TimeSeriesRecorder(const std::string& fileName, Format format = Format::text, std::size_t bufferSize = 1000,
+                                double flushInterval = 10.)
+    : fileName_(fileName), format_(format), bufferSize_(bufferSize > 0 ? bufferSize : 1)
+    , flushInterval_(flushInterval), lastWrite_(Clock::now())
+    { }
+
+    //! writes the remaining rows
+    ~TimeSeriesRecorder()
+    {
+        if (!write_())
+            std::cerr << "TimeSeriesRecorder: could not write " << fileName_ << "\n";
+    }
+
+    TimeSeriesRecorder(const TimeSeriesRecorder&) = delete;
+    TimeSeriesRecorder& operator=(const TimeSeriesRecorder&) = delete;
+
+    //! adds a column, returns its index
+    std::size_t addColumn(const std::string& name, ColumnType type = ColumnType::float64)
+    {
+        if (rows_ > 0 || opened_)
+            DUNE_THROW(Dune::InvalidStateException, "TimeSeriesRecorder: column " << name << " added after the first row (" << fileName_ << ")");
+        columns_.push_back(Column{ name, type, {}, {} });
+        auto& c = columns_.back();
+        if (type == ColumnType::float64)
+            c.float64.resize(bufferSize_);
+        else
+            c.int64.resize(bufferSize_);
+        return columns_.size() - 1;
+    }
+
+    //! adds several float64 columns
+    void addColumns(const std::vector<std::string>& names)
+    {
+        for (const auto& name : names)
+            addColumn(name);
+    }
+
+    //! appends a row, the values are given in the order of the columns
+    template<class... Values>
+    void record(const Values&... values)
+    {
+        if (sizeof...(Values) != columns_.size())
+            DUNE_THROW(Dune::InvalidStateException, "TimeSeriesRecorder: " << sizeof...(Values) << " values given, but "
+                       << fileName_ << " has " << columns_.size() << " columns");
+        std::size_t i = 0;
+        const int expand[] = { 0, (set_(i++, values), 0)... };
+        (void)expand;
+        if (++rows_ == bufferSize_ || (flushInterval_ > 0. && std::chrono::duration<double>(Clock::now() - lastWrite_).count() >= flushInterval_))
+            flush();
+    }
+
+    //! writes the buffered rows
+    void flush()
+    {
+        if (!write_())
+            DUNE_THROW(Dune::IOError, "TimeSeriesRecorder: could not write " << fileName_);
+    }
+
+    //! the file name
+    const std::string& fileName() const
+    { return fileName_; }
+
+    //! number of columns
+    std::size_t numColumns() const
+    { return columns_.size(); }
+
+    //! number of rows recorded so far (written or buffered)
+    std::size_t numRows() const
+    { return written_ + rows_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Column
+    {
+        std::string name;
+        ColumnType type;
+        std::vector<double> float64;
+        std::vector<std::int64_t> int64;
+    };
+
+    template<class T>
+    void set_(std::size_t i, const T& value)
+    {
+        auto& c = columns_[i];
+        if (c.type == ColumnType::float64)
+            c.float64[rows_] = static_cast<double>(value);
+        else
+            c.int64[rows_] = static_cast<std::int64_t>(value);
+    }
+
+    //! opens the file (if needed), writes the buffered rows, returns false on failure
+    bool write_()
+    {
+        lastWrite_ = Clock::now();
+        if (!opened_) {
+            if (rows_ == 0)
+                return true; // nothing recorded, do not create the file
+            open_();
+        }
+        if (rows_ > 0) {
+            if (format_ == Format::binary)
+                writeBinaryChunk_();
+            else
+                writeTextRows_();
+            file_.flush();
+            written_ += rows_;
+            rows_ = 0;
+        }
+        return bool(file_);
+    }
+
+    void open_()
+    {
+        opened_ = true;
+        file_.open(fileName_, format_ == Format::binary ? std::ios::out | std::ios::binary : std::ios::out);
+        if (format_ == Format::binary) {
+            const std::uint32_t version = 1;
+            const std::uint32_t numColumns = columns_.size();
+            file_.write("DUMUXTSR", 8);
+            writeValue_(version);
+            writeValue_(numColumns);
+            for (const auto& c : columns_) {
+                const std::uint32_t nameSize = c.name.size();
+                writeValue_(nameSize);
+                file_.write(c.name.data(), nameSize);
+                writeValue_(static_cast<std::uint8_t>(c.type));
+            }
+        }
+    }
+
+    void writeBinaryChunk_()
+    {
+        const std::uint64_t rows = rows_;
+        writeValue_(rows);
+        for (const auto& c : columns_) {
+            if (c.type == ColumnType::float64)
+                file_.write(reinterpret_cast<const char*>(c.float64.data()), rows*sizeof(double));
+            else
+                file_.write(reinterpret_cast<const char*>(c.int64.data()), rows*sizeof(std::int64_t));
+        }
+    }
+
+    void writeTextRows_()
+    {
+        std::ostringstream s; // the rows are formatted in memory, and written at once
+        for (std::size_t r = 0; r < rows_; ++r) {
+            for (std::size_t i = 0; i < columns_.size(); ++i) {
+                if (i > 0)
+                    s << ", ";
+                if (columns_[i].type == ColumnType::float64)
+                    s << columns_[i].float64[r];
+                else
+                    s << columns_[i].int64[r];
+            }
+            s << "\n";
+        }
+        const auto str = s.str();
+        file_.write(str.data(), str.size());
+    }
+
+    template<class T>
+    void writeValue_(const T& value)
+    { file_.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+    std::string fileName_;
+    Format format_;
+    std::size_t bufferSize_;
+    double flushInterval_;
+    Clock::time_point lastWrite_;
+    std::vector<Column> columns_;
+    std::size_t rows_ = 0; // buffered rows
+    std::size_t written_ = 0;
+    bool opened_ = false;
+    std::ofstream file_;
+};
+
+/*!
+ * \ingroup InputOutput
+ * \brief Creates a recorder for the file name + textExtension (or name + ".ts" in binary format)
+ *
+ * The format, buffer size, and flush interval are given by the parameters TimeSeries.Binary (default false),
+ * TimeSeries.BufferSize (default 1000 rows), and TimeSeries.FlushInterval (default 10 s wall clock time, no limit if <= 0).
+ */
+inline std::unique_ptr<TimeSeriesRecorder> makeTimeSeriesRecorder(const std::string& name, const std::string& textExtension)
+{
+    const bool binary = getParam<bool>("TimeSeries.Binary", false);
+    const auto bufferSize = getParam<std::size_t>("TimeSeries.BufferSize", 1000);
+    const auto flushInterval = getParam<double>("TimeSeries.FlushInterval", 10.);
+    return std::make_unique<TimeSeriesRecorder>(name + (binary ? ".ts" : textExtension),
+                                                binary ? TimeSeriesRecorder::Format::binary : TimeSeriesRecorder::Format::text,
+                                                bufferSize, flushInterval);
+}
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,91 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Linear
+ * \brief Counts iterations and wall time of an iterative linear solver backend
+ */
+#ifndef DUMUX_LINEAR_SOLVER_STATISTICS_HH
+#define DUMUX_LINEAR_SOLVER_STATISTICS_HH
+
+#include <iostream>
+#include <string>
+
+#include <dune/common/timer.hh>
+
+#include <dumux/linear/linearsolveracceptsmultitypematrix.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Linear
+ * \brief Wraps a linear solver backend with result() (e.g. BlockDiagILU0BiCGSTABSolver), and sums up
+ *        the number of solves, failed solves, iterations, and the wall time of all solves.
+ *
+ * Use it in place of the backend, e.g. for the multidomain Newton solver, and call report() at the end.
+ */
+template<class Solver>
+class LinearSolverStatistics : public Solver
+{
+public:
+    using Solver::Solver;
+
+    template<class Matrix, class Vector>
+    bool solve(const Matrix& A, Vector& x, const Vector& b)
+    {
+        Dune::Timer timer;
+        const bool converged = Solver::solve(A, x, b);
+        time_ += timer.elapsed();
+        numSolves_++;
+        iterations_ += this->result().iterations;
+        if (!converged) {
+            numFailed_++;
+        }
+        return converged;
+    }
+
+    int numSolves() const { return numSolves_; }
+    int numFailed() const { return numFailed_; }
+    long iterations() const { return iterations_; }
+    double time() const { return time_; } //!< [s]
+
+    //! prints a summary (one line)
+    void report(std::ostream& out = std::cout) const
+    {
+        out << "Linear solver statistics (" << this->name() << "): " << numSolves_ << " solves, "
+            << numFailed_ << " failed, " << iterations_ << " iterations ("
+            << (numSolves_ > 0 ? double(iterations_) / numSolves_ : 0.) << " per solve), "
+            << time_ << " s\n";
+    }
+
+private:
+    int numSolves_ = 0;
+    int numFailed_ = 0;
+    long iterations_ = 0;
+    double time_ = 0.;
+};
+
+//! the statistics accept multi type matrices, if the solver does
+template<class Solver>
+struct LinearSolverAcceptsMultiTypeMatrix<LinearSolverStatistics<Solver>>
+: public LinearSolverAcceptsMultiTypeMatrix<Solver> {};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,216 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Linear
+ * \brief Block preconditioner and solver for the coupled root-soil (1d-3d) system
+ */
+#ifndef DUMUX_ROOT_SOIL_SCHUR_SOLVER_HH
+#define DUMUX_ROOT_SOIL_SCHUR_SOLVER_HH
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/indices.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+#include <dune/istl/paamg/amg.hh>
+
+#include <dumux/linear/solver.hh>
+#include <dumux/linear/linearsolveracceptsmultitypematrix.hh>
+#include <dumux/linear/treeeliminationbackend.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Linear
+ * \brief Block preconditioner for the coupled system [S C; D R] of soil (index 0) and roots (index 1)
+ *
+ * S is the soil matrix, R the root (xylem) matrix, and C, D are the coupling blocks of the
+ * radial exchange (e.g. from EmbeddedCouplingManager1d3d). The preconditioner applies the block
+ * factorization with the Schur complement of the root block, i.e. for the residual (d_s, d_r)
+ *  - v_r = R^-1 d_r,
+ *  - v_s = S'^-1 (d_s - C v_r),
+ *  - v_r = R^-1 (d_r - D v_s),
+ * where R^-1 is the exact tree elimination (TreeEliminationBackend), and S'^-1 is one AMG cycle on
+ * the approximate Schur complement S' = S - diag(C diag(R)^-1 D), i.e. the radial exchange of each
+ * soil cell with the root segments it contains is added to the soil diagonal.
+ *
+ * Sequential, the diagonal blocks must have 1x1 blocks.
+ */
+template<class M, class X, class Y>
+class RootSoilSchurPreconditioner : public Dune::Preconditioner<X, Y>
+{
+    using SoilMatrix = std::decay_t<decltype(std::declval<M>()[Dune::Indices::_0][Dune::Indices::_0])>;
+    using SoilVector = std::decay_t<decltype(std::declval<X>()[Dune::Indices::_0])>;
+    using SoilOperator = Dune::MatrixAdapter<SoilMatrix, SoilVector, SoilVector>;
+    using Smoother = Dune::SeqSSOR<SoilMatrix, SoilVector, SoilVector>;
+    using SoilAMG = Dune::Amg::AMG<SoilOperator, SoilVector, Smoother>;
+
+public:
+    using matrix_type = M;
+    using domain_type = X;
+    using range_type = Y;
+    using field_type = typename X::field_type;
+
+    /*!
+     * \param m the coupled matrix
+     * \param rootSolver the tree elimination solver, already set to the root block m[1][1]
+     */
+    RootSoilSchurPreconditioner(const M& m, const TreeEliminationBackend& rootSolver)
+    : m_(m), rootSolver_(rootSolver)
+    {
+        using namespace Dune::Indices;
+        static_assert(SoilMatrix::block_type::rows == 1, "RootSoilSchurPreconditioner: only soil matrices with 1x1 blocks are supported");
+
+        // approximate Schur complement, the diagonal of C diag(R)^-1 D is subtracted from S
+        const auto& C = m[_0][_1];
+        const auto& D = m[_1][_0];
+        const auto& R = m[_1][_1];
+        schur_ = m[_0][_0];
+        for (auto row = C.begin(); row != C.end(); ++row) {
+            const auto i = row.index();
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                const auto j = col.index();
+                if (D.exists(j, i)) {
+                    schur_[i][i][0][0] -= (*col)[0][0] * D[j][i][0][0] / R[j][j][0][0];
+                }
+            }
+        }
+
+        using Criterion = Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<SoilMatrix, Dune::Amg::FirstDiagonal>>;
+        Criterion criterion(15, 2000);
+        criterion.setDefaultValuesIsotropic(3);
+        criterion.setDebugLevel(0);
+        typename Dune::Amg::SmootherTraits<Smoother>::Arguments smootherArgs;
+        smootherArgs.iterations = 1;
+        smootherArgs.relaxationFactor = 1.;
+        soilOperator_ = std::make_unique<SoilOperator>(schur_);
+        amg_ = std::make_unique<SoilAMG>(*soilOperator_, criterion, smootherArgs);
+    }
+
+    void pre(X& v, Y& d) final
+    {
+        using namespace Dune::Indices;
+        auto vs = v[_0]; // AMG::pre may change the values
+        auto ds = d[_0];
+        amg_->pre(vs, ds);
+    }
+
+    void apply(X& v, const Y& d) final
+    {
+        using namespace Dune::Indices;
+        rootSolver_.apply(v[_1], d[_1]);
+
+        auto ds = d[_0];
+        m_[_0][_1].mmv(v[_1], ds);
+        v[_0] = 0.;
+        amg_->apply(v[_0], ds);
+
+        auto dr = d[_1];
+        m_[_1][_0].mmv(v[_0], dr);
+        rootSolver_.apply(v[_1], dr);
+    }
+
+    void post(X& v) final
+    {
+        using namespace Dune::Indices;
+        amg_->post(v[_0]);
+    }
+
+    Dune::SolverCategory::Category category() const final
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+private:
+    const M& m_;
+    const TreeEliminationBackend& rootSolver_;
+    SoilMatrix schur_;
+    std::unique_ptr<SoilOperator> soilOperator_;
+    std::unique_ptr<SoilAMG> amg_;
+};
+
+/*!
+ * \ingroup Linear
+ * \brief BiCGSTAB solver for the coupled root-soil system, preconditioned by RootSoilSchurPreconditioner
+ *
+ * A drop-in replacement of BlockDiagILU0BiCGSTABSolver for the multidomain Newton solver, with the soil
+ * as sub domain 0 and the roots as sub domain 1. The analysis of the root matrix is kept between solves.
+ */
+class RootSoilSchurBiCGSTABSolver : public LinearSolver
+{
+public:
+    using LinearSolver::LinearSolver;
+
+    template<class Matrix, class Vector>
+    bool solve(const Matrix& M, Vector& x, const Vector& b)
+    {
+        using namespace Dune::Indices;
+        Dune::Timer timer;
+        if (!rootSolver_.setMatrix(M[_1][_1])) {
+            result_.clear();
+            return false;
+        }
+        RootSoilSchurPreconditioner<Matrix, Vector, Vector> preconditioner(M, rootSolver_);
+        setupTime_ = timer.elapsed();
+
+        Dune::MatrixAdapter<Matrix, Vector, Vector> op(M);
+        Dune::BiCGSTABSolver<Vector> solver(op, preconditioner, this->residReduction(),
+                                            this->maxIter(), this->verbosity());
+        auto bTmp(b);
+        solver.apply(x, bTmp, result_);
+        return result_.converged;
+    }
+
+    //! result of the last solve
+    const Dune::InverseOperatorResult& result() const
+    {
+        return result_;
+    }
+
+    //! wall time [s] of the last preconditioner set up (root factorization, Schur complement, and AMG hierarchy)
+    double setupTime() const
+    {
+        return setupTime_;
+    }
+
+    std::string name() const
+    {
+        return "root-soil Schur complement preconditioned BiCGSTAB solver";
+    }
+
+private:
+    TreeEliminationBackend rootSolver_;
+    Dune::InverseOperatorResult result_;
+    double setupTime_ = 0.;
+};
+
+//! the solver works on the multi type block matrix of the coupled system
+template<>
+struct LinearSolverAcceptsMultiTypeMatrix<RootSoilSchurBiCGSTABSolver> : public std::true_type {};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,386 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Linear
+ * \brief Direct linear solver for (nearly) tree structured systems, e.g. the xylem flow in a root system
+ */
+#ifndef DUMUX_TREE_ELIMINATION_BACKEND_HH
+#define DUMUX_TREE_ELIMINATION_BACKEND_HH
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/linear/solver.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Linear
+ * \brief Direct solver for scalar systems with (nearly) tree structured matrix graph
+ *
+ * The cell centered matrix of a root system on a network grid (Dune::FoamGrid) couples each segment
+ * with the segments sharing one of its nodes, i.e. its graph is the line graph of a tree. Eliminating
+ * the segments from the tips towards the root collar produces no fill in, and the LU decomposition
+ * costs O(n). The elimination order is found by a maximum cardinality search on the matrix graph,
+ * which yields such a perfect elimination order for all tree (and chordal) graphs, without knowledge
+ * of the grid. Extra connections (e.g. the periodic connectivity of a periodic root system) close
+ * cycles, these are eliminated exactly with a few fill in entries along each cycle.
+ *
+ * The ordering and the (filled) pattern are computed once, and only recomputed if the matrix pattern
+ * changes (e.g. after root growth). There is no pivoting, the diagonal must stay dominant
+ * enough, which is the case for the xylem flow matrices. A (nearly) zero pivot is reported as not
+ * converged, so that the Newton solver retries with a smaller time step.
+ *
+ * The solver is sequential and supports matrices with 1x1 blocks.
+ */
+class TreeEliminationBackend : public LinearSolver
+{
+public:
+
+    //! Constructor, \param paramGroup the parameter group for LinearSolver.Verbosity
+    TreeEliminationBackend(const std::string& paramGroup = "")
+    : LinearSolver(paramGroup)
+    { }
+
+    /*!
+     * \brief Constructor with the signature of the AMG backend
+     * \note the system must not be distributed, the dof mapper is not used
+     */
+    template<class GridView, class DofMapper>
+    TreeEliminationBackend(const GridView& gridView, const DofMapper& dofMapper, const std::string& paramGroup = "")
+    : LinearSolver(paramGroup)
+    {
+        if (gridView.comm().size() > 1) {
+            DUNE_THROW(Dune::NotImplemented, "TreeEliminationBackend is a sequential solver");
+        }
+    }
+
+    /*!
+     * \brief Solves the linear system Ax = b
+     * \return false, if a pivot vanishes
+     */
+    template<class Matrix, class Vector>
+    bool solve(const Matrix& A, Vector& x, const Vector& b)
+    {
+        if (!setMatrix(A)) {
+            return false;
+        }
+        apply(x, b);
+        return true;
+    }
+
+    /*!
+     * \brief Factorizes A, for subsequent calls of apply
+     * \return false, if a pivot vanishes
+     */
+    template<class Matrix>
+    bool setMatrix(const Matrix& A)
+    {
+        static_assert(Matrix::block_type::rows == 1 && Matrix::block_type::cols == 1,
+            "TreeEliminationBackend: only matrices with 1x1 blocks are supported");
+
+        if (!samePattern_(A)) {
+            analyze_(A);
+        }
+        if (!factorize_(A)) {
+            if (this->verbosity() > 0) {
+                std::cout << "TreeEliminationBackend: vanishing pivot, the system is not solved\n";
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /*!
+     * \brief Solves Ax = b with the factorization of the last setMatrix
+     */
+    template<class Vector>
+    void apply(Vector& x, const Vector& b) const
+    {
+        const std::size_t n = order_.size();
+        y_.resize(n);
+        for (std::size_t i = 0; i < n; i++) {
+            y_[i] = b[i][0];
+        }
+        for (std::size_t k = 0; k < n; k++) { // forward substitution (L, unit diagonal)
+            const int p = order_[k];
+            for (int e = elimStart_[k]; e < elimStart_[k + 1]; e++) {
+                y_[later_[e]] -= values_[lowerSlot_[e]] * y_[p];
+            }
+        }
+        x.resize(n);
+        for (std::size_t k = n; k-- > 0; ) { // backward substitution (U)
+            const int p = order_[k];
+            double s = y_[p];
+            for (int e = elimStart_[k]; e < elimStart_[k + 1]; e++) {
+                s -= values_[upperSlot_[e]] * x[later_[e]][0];
+            }
+            x[p][0] = s / values_[diagSlot_[p]];
+        }
+    }
+
+    //! the solver's name
+    std::string name() const {
+        return "tree elimination solver";
+    }
+
+    //! number of entries of the factorization (nonzeros of the matrix plus fill in)
+    std::size_t factorSize() const {
+        return cols_.size();
+    }
+
+private:
+
+    //! true if A has the pattern of the last analyze
+    template<class Matrix>
+    bool samePattern_(const Matrix& A) const
+    {
+        if (A.N() != rowStartA_.size() - 1 || A.nonzeroes() != colsA_.size()) {
+            return false;
+        }
+        std::size_t e = 0;
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            if (rowStartA_[row.index() + 1] - rowStartA_[row.index()] != row->size()) {
+                return false;
+            }
+            for (auto col = row->begin(); col != row->end(); ++col, ++e) {
+                if (colsA_[e] != int(col.index())) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    //! elimination order, filled pattern, and the index lists of the factorization
+    template<class Matrix>
+    void analyze_(const Matrix& A)
+    {
+        const int n = A.N();
+        if (A.M() != A.N()) {
+            DUNE_THROW(Dune::InvalidStateException, "TreeEliminationBackend: the matrix is not square");
+        }
+
+        // pattern of A, and the symmetric graph (without diagonal)
+        rowStartA_.assign(1, 0);
+        colsA_.clear();
+        colsA_.reserve(A.nonzeroes());
+        std::vector<std::vector<int>> adj(n);
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            const int i = row.index();
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                const int j = col.index();
+                colsA_.push_back(j);
+                if (i != j) {
+                    adj[i].push_back(j);
+                    adj[j].push_back(i);
+                }
+            }
+            rowStartA_.push_back(colsA_.size());
+        }
+        for (auto& a : adj) {
+            std::sort(a.begin(), a.end());
+            a.erase(std::unique(a.begin(), a.end()), a.end());
+        }
+
+        // maximum cardinality search, the reverse visiting order is the elimination order
+        std::vector<int> weight(n, 0);
+        std::vector<char> visited(n, 0);
+        std::vector<std::vector<int>> bucket(1);
+        bucket[0].reserve(n);
+        for (int v = n - 1; v >= 0; v--) {
+            bucket[0].push_back(v);
+        }
+        order_.resize(n);
+        int maxWeight = 0;
+        for (int k = n - 1; k >= 0; k--) {
+            int v;
+            while (true) { // buckets may hold outdated entries
+                while (bucket[maxWeight].empty()) {
+                    maxWeight--;
+                }
+                v = bucket[maxWeight].back();
+                bucket[maxWeight].pop_back();
+                if (!visited[v] && weight[v] == maxWeight) {
+                    break;
+                }
+            }
+            visited[v] = 1;
+            order_[k] = v;
+            for (int u : adj[v]) {
+                if (!visited[u]) {
+                    weight[u]++;
+                    if (weight[u] >= int(bucket.size())) {
+                        bucket.resize(weight[u] + 1);
+                    }
+                    bucket[weight[u]].push_back(u);
+                    maxWeight = std::max(maxWeight, weight[u]);
+                }
+            }
+        }
+        std::vector<int> position(n);
+        for (int k = 0; k < n; k++) {
+            position[order_[k]] = k;
+        }
+
+        // symbolic elimination, the not yet eliminated neighbors of a pivot become a clique (fill in)
+        std::vector<std::vector<int>> laterNeighbors(n);
+        for (int k = 0; k < n; k++) {
+            const int p = order_[k];
+            auto& ln = laterNeighbors[k];
+            for (int u : adj[p]) {
+                if (position[u] > k) {
+                    ln.push_back(u);
+                }
+            }
+            for (std::size_t a = 0; a < ln.size(); a++) {
+                for (std::size_t c = a + 1; c < ln.size(); c++) {
+                    auto& adjA = adj[ln[a]];
+                    auto it = std::lower_bound(adjA.begin(), adjA.end(), ln[c]);
+                    if (it == adjA.end() || *it != ln[c]) { // fill in
+                        adjA.insert(it, ln[c]);
+                        auto& adjC = adj[ln[c]];
+                        adjC.insert(std::lower_bound(adjC.begin(), adjC.end(), ln[a]), ln[a]);
+                    }
+                }
+            }
+        }
+
+        // filled pattern (rows with sorted columns, including the diagonal)
+        rowStart_.assign(1, 0);
+        cols_.clear();
+        diagSlot_.resize(n);
+        for (int i = 0; i < n; i++) {
+            auto a = adj[i];
+            a.insert(std::lower_bound(a.begin(), a.end(), i), i);
+            diagSlot_[i] = cols_.size() + (std::lower_bound(a.begin(), a.end(), i) - a.begin());
+            cols_.insert(cols_.end(), a.begin(), a.end());
+            rowStart_.push_back(cols_.size());
+        }
+        values_.resize(cols_.size());
+
+        auto slot = [&](int i, int j) {
+            return int(std::lower_bound(cols_.begin() + rowStart_[i], cols_.begin() + rowStart_[i + 1], j) - cols_.begin());
+        };
+
+        // position of each entry of A in the filled pattern
+        slotA_.resize(colsA_.size());
+        for (int i = 0; i < n; i++) {
+            for (int e = rowStartA_[i]; e < rowStartA_[i + 1]; e++) {
+                slotA_[e] = slot(i, colsA_[e]);
+            }
+        }
+
+        // per pivot: later neighbors with the slots of l_ip, u_pi, and the Schur complement updates
+        elimStart_.assign(1, 0);
+        later_.clear();
+        lowerSlot_.clear();
+        upperSlot_.clear();
+        updateStart_.assign(1, 0);
+        updateSlot_.clear();
+        for (int k = 0; k < n; k++) {
+            const int p = order_[k];
+            const auto& ln = laterNeighbors[k];
+            for (int i : ln) {
+                later_.push_back(i);
+                lowerSlot_.push_back(slot(i, p));
+                upperSlot_.push_back(slot(p, i));
+            }
+            elimStart_.push_back(later_.size());
+            for (int i : ln) {
+                for (int j : ln) {
+                    updateSlot_.push_back(slot(i, j));
+                }
+            }
+            updateStart_.push_back(updateSlot_.size());
+        }
+
+        if (this->verbosity() > 0) {
+            std::cout << "TreeEliminationBackend: " << n << " unknowns, " << colsA_.size() << " nonzeros, "
+                << cols_.size() - colsA_.size() << " fill in entries\n";
+        }
+    }
+
+    //! LU decomposition in the elimination order, l and u overwrite the values, false for vanishing pivots
+    template<class Matrix>
+    bool factorize_(const Matrix& A)
+    {
+        std::fill(values_.begin(), values_.end(), 0.);
+        std::size_t e = 0;
+        double maxAbs = 0.;
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col, ++e) {
+                values_[slotA_[e]] = (*col)[0][0];
+                maxAbs = std::max(maxAbs, std::fabs((*col)[0][0]));
+            }
+        }
+
+        const double tiny = 1.e-14 * maxAbs;
+        const int n = order_.size();
+        for (int k = 0; k < n; k++) {
+            const double d = values_[diagSlot_[order_[k]]];
+            if (!(std::fabs(d) > tiny)) { // includes nan
+                return false;
+            }
+            const int b = elimStart_[k];
+            const int m = elimStart_[k + 1] - b;
+            for (int a = 0; a < m; a++) {
+                values_[lowerSlot_[b + a]] /= d;
+            }
+            int u = updateStart_[k];
+            for (int a = 0; a < m; a++) {
+                const double l = values_[lowerSlot_[b + a]];
+                for (int c = 0; c < m; c++, u++) {
+                    values_[updateSlot_[u]] -= l * values_[upperSlot_[b + c]];
+                }
+            }
+        }
+        return true;
+    }
+
+    // pattern of the last analyzed matrix
+    std::vector<std::size_t> rowStartA_ = { 0 };
+    std::vector<int> colsA_;
+
+    std::vector<int> order_; // elimination order
+    std::vector<int> rowStart_; // filled pattern
+    std::vector<int> cols_;
+    std::vector<int> diagSlot_;
+    std::vector<int> slotA_; // slot of each entry of A
+    std::vector<double> values_; // values of the factorization
+
+    std::vector<int> elimStart_; // later neighbors of each pivot (in elimination order)
+    std::vector<int> later_;
+    std::vector<int> lowerSlot_;
+    std::vector<int> upperSlot_;
+    std::vector<int> updateStart_; // Schur complement update slots of each pivot
+    std::vector<int> updateSlot_;
+
+    mutable std::vector<double> y_;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,221 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Tabulated matric flux potential (MFP) of a soil, and its inverse
+ */
+#ifndef DUMUX_MFP_TABLE_HH
+#define DUMUX_MFP_TABLE_HH
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+namespace Dumux {
+
+/*!
+ * Tabulated matric flux potential of one soil (layer)
+ *
+ * MFP(pc) = 86400 * kc * int_pc^pcLow krw(sw(xi)) dxi
+ *
+ * pc is the capillary pressure [Pa] and pcLow the capillary pressure at the lower integration
+ * boundary (-15000 cm per default). The units are the ones used by the Schroeder et al. (2008)
+ * rhizosphere model in richardsproblem_schroeder.hh and rootsproblem_schroeder.hh.
+ *
+ * The table is built once from the van Genuchten parameters. Nodes are equidistant in
+ * u = log(pc + s), which resolves the steep part close to saturation, and the nodal values are
+ * integrated with Gauss-Legendre quadrature. The function is interpolated by cubic Hermite
+ * polynomials using the exact derivative dMFP/du, which are limited to keep the interpolant monotone.
+ *
+ * mfp(pc) is an O(1) look up, inverse(mfp) is a binary search plus a few Newton steps within one interval.
+ */
+template<class MaterialLaw>
+class MFPTable
+{
+    using MaterialLawParams = typename MaterialLaw::Params;
+
+public:
+
+    MFPTable() { } // empty
+
+    /**
+     * @param params        van Genuchten parameters of the soil
+     * @param kc            hydraulic conductivity [m/s]
+     * @param pcLow         capillary pressure at the lower integration boundary [Pa]
+     * @param n             number of table intervals
+     */
+    MFPTable(const MaterialLawParams& params, double kc, double pcLow, int n = 2000)
+    : pcLow_(pcLow), n_(n) {
+
+        shift_ = 1.e-2 / params.vgAlpha(); // [Pa], small compared to the air entry value
+        u0_ = std::log(shift_);
+        du_ = (std::log(pcLow_ + shift_) - u0_) / n_;
+        scale_ = 86400. * kc;
+
+        // nodal derivatives dMFP/du = -scale * krw(sw(pc)) * (pc + s)
+        dmfp_.resize(n_ + 1);
+        for (int i = 0; i <= n_; i++) {
+            dmfp_[i] = -integrand_(params, pc_(u0_ + i * du_)) * du_;
+        }
+        dpcLow_ = -scale_ * krw_(params, pcLow_); // dMFP/dpc at pcLow
+        dpcHigh_ = -scale_ * krw_(params, 0.); // dMFP/dpc at saturation
+
+        // nodal values, integrated from pcLow (MFP = 0) towards saturation
+        static constexpr double gx[5] = { -0.9061798459386640, -0.5384693101056831, 0., 0.5384693101056831, 0.9061798459386640 };
+        static constexpr double gw[5] = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+        mfp_.resize(n_ + 1);
+        mfp_[n_] = 0.;
+        for (int i = n_ - 1; i >= 0; i--) {
+            double um = u0_ + (i + 0.5) * du_;
+            double sum = 0.;
+            for (int j = 0; j < 5; j++) {
+                sum += gw[j] * integrand_(params, pc_(um + 0.5 * du_ * gx[j]));
+            }
+            mfp_[i] = mfp_[i + 1] + 0.5 * du_ * sum;
+        }
+
+        // Fritsch-Carlson limiter (derivatives are scaled to the unit interval)
+        for (int i = 0; i < n_; i++) {
+            double delta = mfp_[i + 1] - mfp_[i];
+            if (delta == 0.) {
+                dmfp_[i] = 0.;
+                dmfp_[i + 1] = 0.;
+            } else {
+                double a = dmfp_[i] / delta;
+                double b = dmfp_[i + 1] / delta;
+                double r = a * a + b * b;
+                if (r > 9.) {
+                    double t = 3. / std::sqrt(r);
+                    dmfp_[i] = t * a * delta;
+                    dmfp_[i + 1] = t * b * delta;
+                }
+            }
+        }
+    }
+
+    /**
+     * Matric flux potential at capillary pressure @param pc [Pa]
+     *
+     * linear extrapolation for pc < 0 (saturated) and pc > pcLow
+     */
+    double mfp(double pc) const {
+        if (pc <= 0.) {
+            return mfp_[0] + dpcHigh_ * pc;
+        }
+        if (pc >= pcLow_) {
+            return dpcLow_ * (pc - pcLow_);
+        }
+        double x = (std::log(pc + shift_) - u0_) / du_;
+        int i = std::min(std::max(int(x), 0), n_ - 1);
+        return hermite_(i, x - i);
+    }
+
+    /**
+     * Capillary pressure [Pa] at the matric flux potential @param m,
+     * i.e. the root of mfp(pc) - m within [0, pcLow]
+     *
+     * values of m outside of [0, mfp(0)] are clamped to the interval boundaries
+     */
+    double inverse(double m) const {
+        if (m >= mfp_[0]) {
+            return 0.;
+        }
+        if (m <= 0.) {
+            return pcLow_;
+        }
+        // mfp_ is strictly decreasing, find i with mfp_[i] >= m > mfp_[i+1]
+        auto it = std::upper_bound(mfp_.begin(), mfp_.end(), m, std::greater<double>());
+        int i = std::min(std::max(int(it - mfp_.begin()) - 1, 0), n_ - 1);
+        // safeguarded Newton iteration on the unit interval
+        double a = 0., b = 1.;
+        double t = (mfp_[i] - m) / (mfp_[i] - mfp_[i + 1]);
+        for (int k = 0; k < 50; k++) {
+            double f = hermite_(i, t) - m;
+            if (f > 0.) {
+                a = t;
+            } else {
+                b = t;
+            }
+            double df = hermiteDerivative_(i, t);
+            double tn = (df < 0.) ? t - f / df : 0.5 * (a + b);
+            if ((tn <= a) || (tn >= b)) {
+                tn = 0.5 * (a + b);
+            }
+            if (std::fabs(tn - t) < 1.e-14) {
+                t = tn;
+                break;
+            }
+            t = tn;
+        }
+        return pc_(u0_ + (i + t) * du_);
+    }
+
+    //! capillary pressure at the lower integration boundary [Pa]
+    double pcLow() const {
+        return pcLow_;
+    }
+
+private:
+
+    double pc_(double u) const {
+        return std::max(std::exp(u) - shift_, 0.);
+    }
+
+    double krw_(const MaterialLawParams& params, double pc) const {
+        return MaterialLaw::krw(params, MaterialLaw::sw(params, pc));
+    }
+
+    //! dMFP/du * (-1), with u = log(pc + s)
+    double integrand_(const MaterialLawParams& params, double pc) const {
+        return scale_ * krw_(params, pc) * (pc + shift_);
+    }
+
+    //! cubic Hermite interpolation in interval i, t in [0,1]
+    double hermite_(int i, double t) const {
+        double t2 = t * t;
+        double t3 = t2 * t;
+        return (2. * t3 - 3. * t2 + 1.) * mfp_[i] + (t3 - 2. * t2 + t) * dmfp_[i]
+            + (-2. * t3 + 3. * t2) * mfp_[i + 1] + (t3 - t2) * dmfp_[i + 1];
+    }
+
+    //! derivative of hermite_ with respect to t
+    double hermiteDerivative_(int i, double t) const {
+        double t2 = t * t;
+        return (6. * t2 - 6. * t) * (mfp_[i] - mfp_[i + 1]) + (3. * t2 - 4. * t + 1.) * dmfp_[i]
+            + (3. * t2 - 2. * t) * dmfp_[i + 1];
+    }
+
+    double pcLow_ = 0.; // [Pa]
+    int n_ = 0;
+    double shift_ = 1.; // [Pa]
+    double u0_ = 0.;
+    double du_ = 1.;
+    double scale_ = 0.;
+    double dpcLow_ = 0.;
+    double dpcHigh_ = 0.;
+
+    std::vector<double> mfp_; // nodal matric flux potentials
+    std::vector<double> dmfp_; // nodal derivatives, scaled to the unit interval
+
+};
+
+} // end namespace Dumux
+
+#endif
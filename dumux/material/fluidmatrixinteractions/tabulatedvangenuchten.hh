@@ -0,0 +1,395 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Tabulated (regularized) van Genuchten law, a drop-in replacement of RegularizedVanGenuchten
+ */
+#ifndef DUMUX_TABULATED_VAN_GENUCHTEN_HH
+#define DUMUX_TABULATED_VAN_GENUCHTEN_HH
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include <dumux/material/fluidmatrixinteractions/2p/regularizedvangenuchten.hh>
+
+namespace Dumux {
+
+/*!
+ * Monotone cubic (PCHIP) interpolant of a function sampled at equidistant nodes x0 + i*dx, i = 0..n.
+ * The polynomial coefficients are stored per interval, evaluation is one index computation and Horner's scheme.
+ */
+class MonotoneCubicTable
+{
+public:
+
+    MonotoneCubicTable() { } // empty
+
+    /**
+     * @param x0        first node
+     * @param dx        node distance
+     * @param y         nodal values (at least 2)
+     */
+    MonotoneCubicTable(double x0, double dx, const std::vector<double>& y)
+    : x0_(x0), dx_(dx), n_(int(y.size()) - 1) {
+
+        // Fritsch-Butland derivatives (scaled to the unit interval), monotone by construction
+        std::vector<double> d(n_ + 1);
+        d[0] = y[1] - y[0];
+        d[n_] = y[n_] - y[n_ - 1];
+        for (int i = 1; i < n_; i++) {
+            double a = y[i] - y[i - 1];
+            double b = y[i + 1] - y[i];
+            d[i] = (a * b > 0.) ? 2. * a * b / (a + b) : 0.;
+        }
+
+        c_.resize(n_);
+        for (int i = 0; i < n_; i++) {
+            double delta = y[i + 1] - y[i];
+            c_[i] = { y[i], d[i], 3. * delta - 2. * d[i] - d[i + 1], -2. * delta + d[i] + d[i + 1] };
+        }
+    }
+
+    //! interpolated value, x is clamped to the table range
+    double operator()(double x) const {
+        double s = std::min(std::max((x - x0_) / dx_, 0.), double(n_));
+        int i = std::min(int(s), n_ - 1);
+        double t = s - i;
+        const auto& c = c_[i];
+        return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+    }
+
+    //! derivative of the interpolant, zero outside of the table range
+    double derivative(double x) const {
+        double s = (x - x0_) / dx_;
+        if (s < 0. || s > n_) {
+            return 0.;
+        }
+        int i = std::min(int(s), n_ - 1);
+        double t = s - i;
+        const auto& c = c_[i];
+        return (c[1] + t * (2. * c[2] + 3. * t * c[3])) / dx_;
+    }
+
+    double xMin() const { return x0_; }
+    double xMax() const { return x0_ + n_ * dx_; }
+
+private:
+    double x0_ = 0.;
+    double dx_ = 1.;
+    int n_ = 0;
+    std::vector<std::array<double, 4>> c_; // polynomial coefficients in t = (x - x_i)/dx per interval
+};
+
+/*!
+ * Tables of one parameter set of the van Genuchten law, and the measured interpolation errors
+ *
+ * swe(pc) is tabulated over u = log(pc + s), i.e. log-suction (with a small shift s),
+ * krw(swe) and log(pc(swe) + s) are tabulated over w = log(swe / (1 - swe)), which resolves
+ * the steep parts at both ends of the saturation range. Tables range from the regularisation
+ * threshold pcLowSw to saturation, the law falls back to the analytic regularized law outside
+ * of the tables.
+ */
+class TabulatedVanGenuchtenTable
+{
+public:
+
+    /**
+     * @param params        regularized van Genuchten parameters (effective saturation)
+     * @param n             number of table intervals
+     */
+    template<class Params>
+    TabulatedVanGenuchtenTable(const Params& params, int n) {
+        using Law = RegularizedVanGenuchten<typename Params::Scalar>;
+
+        shift_ = 1.e-2 / params.vgAlpha(); // [Pa], small compared to the air entry value
+        sweMin_ = params.pcLowSw();
+        sweMax_ = 1. - 1.e-9;
+        pcMax_ = Law::pc(params, sweMin_);
+
+        // swe(u), u = log(pc + s), pc in [0, pcMax]
+        double u0 = std::log(shift_);
+        double du = (std::log(pcMax_ + shift_) - u0) / n;
+        std::vector<double> y(n + 1);
+        for (int i = 0; i <= n; i++) {
+            y[i] = Law::sw(params, pc_(u0 + i * du));
+        }
+        sw_ = MonotoneCubicTable(u0, du, y);
+
+        // krw(w) and u(w), w = log(swe / (1 - swe)), swe in [sweMin, sweMax]
+        double w0 = logit_(sweMin_);
+        double dw = (logit_(sweMax_) - w0) / n;
+        std::vector<double> k(n + 1);
+        for (int i = 0; i <= n; i++) {
+            double swe = logistic_(w0 + i * dw);
+            k[i] = Law::krw(params, swe);
+            y[i] = std::log(std::max(Law::pc(params, swe), 0.) + shift_);
+        }
+        krw_ = MonotoneCubicTable(w0, dw, k);
+        pc_u_ = MonotoneCubicTable(w0, dw, y);
+
+        // measure the errors at the quarter points of each interval
+        for (int i = 0; i < 4 * n; i++) {
+            double p = pc_(u0 + (i + 0.5) * 0.25 * du);
+            errorSw_ = std::max(errorSw_, std::fabs(sw(p) - Law::sw(params, p)));
+            double swe = logistic_(w0 + (i + 0.5) * 0.25 * dw);
+            errorKrw_ = std::max(errorKrw_, std::fabs(krw(swe) - Law::krw(params, swe)));
+            double pca = std::max(Law::pc(params, swe), 0.);
+            errorPc_ = std::max(errorPc_, std::fabs(pc(swe) - pca) / (pca + shift_));
+        }
+    }
+
+    //! true if the capillary pressure [Pa] is within the table
+    bool containsPc(double pc) const {
+        return (pc >= 0.) && (pc <= pcMax_);
+    }
+
+    //! true if the effective saturation is within the table
+    bool containsSwe(double swe) const {
+        return (swe >= sweMin_) && (swe <= sweMax_);
+    }
+
+    //! tabulated effective saturation at capillary pressure pc [Pa]
+    double sw(double pc) const {
+        return sw_(std::log(pc + shift_));
+    }
+
+    //! tabulated relative permeability at effective saturation swe
+    double krw(double swe) const {
+        return krw_(logit_(swe));
+    }
+
+    //! tabulated capillary pressure [Pa] at effective saturation swe
+    double pc(double swe) const {
+        return std::max(std::exp(pc_u_(logit_(swe))) - shift_, 0.);
+    }
+
+    //! tabulated effective saturations swe[i] = sw(pc[i]) for i in [0, n), pc is clamped to the table
+    void sw(const double* pc, double* swe, std::size_t n) const {
+        for (std::size_t i = 0; i < n; i++) {
+            swe[i] = sw(std::min(std::max(pc[i], 0.), pcMax_));
+        }
+    }
+
+    //! tabulated relative permeabilities kr[i] = krw(swe[i]) for i in [0, n), swe is clamped to the table
+    void krw(const double* swe, double* kr, std::size_t n) const {
+        for (std::size_t i = 0; i < n; i++) {
+            kr[i] = krw(std::min(std::max(swe[i], sweMin_), sweMax_));
+        }
+    }
+
+    //! tabulated capillary pressures pc[i] = pc(swe[i]) [Pa] for i in [0, n), swe is clamped to the table
+    void pc(const double* swe, double* pc, std::size_t n) const {
+        for (std::size_t i = 0; i < n; i++) {
+            pc[i] = this->pc(std::min(std::max(swe[i], sweMin_), sweMax_));
+        }
+    }
+
+    //! derivative of the tabulated sw(pc) [1/Pa]
+    double dswe_dpc(double pc) const {
+        return sw_.derivative(std::log(pc + shift_)) / (pc + shift_);
+    }
+
+    //! derivative of the tabulated krw(swe)
+    double dkrw_dswe(double swe) const {
+        return krw_.derivative(logit_(swe)) / (swe * (1. - swe));
+    }
+
+    //! derivative of the tabulated pc(swe) [Pa]
+    double dpc_dswe(double swe) const {
+        double w = logit_(swe);
+        double e = std::exp(pc_u_(w));
+        return (e > shift_) ? e * pc_u_.derivative(w) / (swe * (1. - swe)) : 0.;
+    }
+
+    //! maximal absolute error of sw(pc) measured at construction
+    double errorSw() const { return errorSw_; }
+    //! maximal absolute error of krw(swe) measured at construction
+    double errorKrw() const { return errorKrw_; }
+    //! maximal error of pc(swe) relative to pc + s, measured at construction
+    double errorPc() const { return errorPc_; }
+
+private:
+
+    double pc_(double u) const {
+        return std::max(std::exp(u) - shift_, 0.);
+    }
+
+    static double logit_(double swe) {
+        return std::log(swe / (1. - swe));
+    }
+
+    static double logistic_(double w) {
+        return 1. / (1. + std::exp(-w));
+    }
+
+    double shift_ = 1.; // [Pa]
+    double sweMin_ = 0.;
+    double sweMax_ = 1.;
+    double pcMax_ = 0.; // [Pa]
+
+    MonotoneCubicTable sw_;
+    MonotoneCubicTable krw_;
+    MonotoneCubicTable pc_u_;
+
+    double errorSw_ = 0.;
+    double errorKrw_ = 0.;
+    double errorPc_ = 0.;
+};
+
+/*!
+ * Parameters of TabulatedVanGenuchten, i.e. the regularized van Genuchten parameters and the (shared) tables.
+ *
+ * The tables are not updated by the setters, call buildTable() after all parameters are set.
+ * Without tables the law evaluates the analytic regularized van Genuchten law.
+ */
+template<class ScalarT>
+class TabulatedVanGenuchtenParams : public RegularizedVanGenuchtenParams<ScalarT>
+{
+public:
+    using Scalar = ScalarT;
+
+    //! (re)builds the tables with @param n intervals
+    void buildTable(int n = 1000) {
+        table_ = std::make_shared<const TabulatedVanGenuchtenTable>(*this, n);
+    }
+
+    //! removes the tables, the law evaluates the analytic law
+    void clearTable() {
+        table_.reset();
+    }
+
+    //! the tables (nullptr if not built)
+    const TabulatedVanGenuchtenTable* table() const {
+        return table_.get();
+    }
+
+private:
+    std::shared_ptr<const TabulatedVanGenuchtenTable> table_;
+};
+
+/*!
+ * Tabulated regularized van Genuchten law (effective saturations), use with EffToAbsLaw
+ *
+ * sw, pc, and krw are interpolated from monotone cubic tables (see TabulatedVanGenuchtenTable)
+ * if the parameters have tables. Their derivatives are the derivatives of the interpolants,
+ * i.e. consistent with the tabulated values. Values outside of the tables and the non-wetting
+ * functions are passed to RegularizedVanGenuchten.
+ *
+ * The batched versions of sw, krw, and pc evaluate whole arrays (e.g. all cells of a soil layer,
+ * see RichardsParams::saturations). The table loop clamps the arguments instead of branching, and is
+ * meant to be vectorized by the compiler, the few arguments outside of the tables are replaced
+ * by the analytic law in a second loop.
+ */
+template<class ScalarT, class ParamsT = TabulatedVanGenuchtenParams<ScalarT>>
+class TabulatedVanGenuchten
+{
+    using Analytic = RegularizedVanGenuchten<ScalarT, ParamsT>;
+
+public:
+    using Params = ParamsT;
+    using Scalar = typename Params::Scalar;
+
+    static Scalar pc(const Params &params, Scalar swe) {
+        const auto* t = params.table();
+        return (t && t->containsSwe(swe)) ? t->pc(swe) : Analytic::pc(params, swe);
+    }
+
+    static Scalar sw(const Params &params, Scalar pc) {
+        const auto* t = params.table();
+        return (t && t->containsPc(pc)) ? t->sw(pc) : Analytic::sw(params, pc);
+    }
+
+    static Scalar krw(const Params &params, Scalar swe) {
+        const auto* t = params.table();
+        return (t && t->containsSwe(swe)) ? t->krw(swe) : Analytic::krw(params, swe);
+    }
+
+    static Scalar endPointPc(const Params &params) {
+        return Analytic::endPointPc(params);
+    }
+
+    static Scalar dpc_dswe(const Params &params, Scalar swe) {
+        const auto* t = params.table();
+        return (t && t->containsSwe(swe)) ? t->dpc_dswe(swe) : Analytic::dpc_dswe(params, swe);
+    }
+
+    static Scalar dswe_dpc(const Params &params, Scalar pc) {
+        const auto* t = params.table();
+        return (t && t->containsPc(pc)) ? t->dswe_dpc(pc) : Analytic::dswe_dpc(params, pc);
+    }
+
+    static Scalar dkrw_dswe(const Params &params, Scalar swe) {
+        const auto* t = params.table();
+        return (t && t->containsSwe(swe)) ? t->dkrw_dswe(swe) : Analytic::dkrw_dswe(params, swe);
+    }
+
+    static Scalar krn(const Params &params, Scalar swe) {
+        return Analytic::krn(params, swe);
+    }
+
+    static Scalar dkrn_dswe(const Params &params, Scalar swe) {
+        return Analytic::dkrn_dswe(params, swe);
+    }
+
+    //! effective saturations swe[i] = sw(pc[i]) for i in [0, n), the arrays must not overlap
+    static void sw(const Params &params, const Scalar* pc, Scalar* swe, std::size_t n) {
+        const auto* t = params.table();
+        if (t) {
+            t->sw(pc, swe, n);
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            if (!t || !t->containsPc(pc[i])) {
+                swe[i] = Analytic::sw(params, pc[i]);
+            }
+        }
+    }
+
+    //! relative permeabilities kr[i] = krw(swe[i]) for i in [0, n), the arrays must not overlap
+    static void krw(const Params &params, const Scalar* swe, Scalar* kr, std::size_t n) {
+        const auto* t = params.table();
+        if (t) {
+            t->krw(swe, kr, n);
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            if (!t || !t->containsSwe(swe[i])) {
+                kr[i] = Analytic::krw(params, swe[i]);
+            }
+        }
+    }
+
+    //! capillary pressures pc[i] = pc(swe[i]) for i in [0, n), the arrays must not overlap
+    static void pc(const Params &params, const Scalar* swe, Scalar* pc, std::size_t n) {
+        const auto* t = params.table();
+        if (t) {
+            t->pc(swe, pc, n);
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            if (!t || !t->containsSwe(swe[i])) {
+                pc[i] = Analytic::pc(params, swe[i]);
+            }
+        }
+    }
+};
+
+} // end namespace Dumux
+
+#endif
@@ -27,9 +27,12 @@
 #define DUMUX_MULTIDOMAIN_EMBEDDED_COUPLINGMANAGER_1D3D_HH
 
 #include <vector>
+#include <array>
+#include <algorithm>
 
 #include <dune/common/timer.hh>
 #include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/affinegeometry.hh>
 
 #include <dumux/common/properties.hh>
 #include <dumux/multidomain/embedded/pointsourcedata.hh>
@@ -37,6 +40,7 @@
 #include <dumux/multidomain/embedded/couplingmanagerbase.hh>
 #include <dumux/multidomain/embedded/circlepoints.hh>
 #include <dumux/multidomain/embedded/extendedsourcestencil.hh>
+#include <dumux/multidomain/embedded/pointsourceupdate.hh>
 
 namespace Dumux {
 
@@ -93,6 +97,7 @@ class EmbeddedCouplingManager1d3d<MDTraits, EmbeddedCouplingMode::line>
 
     using Scalar = typename MDTraits::Scalar;
     using SolutionVector = typename MDTraits::SolutionVector;
+    using PointSourceData = typename ParentType::PointSourceTraits::PointSourceData;
 
     static constexpr auto bulkIdx = typename MDTraits::template SubDomain<0>::Index();
     static constexpr auto lowDimIdx = typename MDTraits::template SubDomain<1>::Index();
@@ -104,6 +109,16 @@ class EmbeddedCouplingManager1d3d<MDTraits, EmbeddedCouplingMode::line>
     template<std::size_t id> using GridView = typename FVGridGeometry<id>::GridView;
     template<std::size_t id> using Element = typename GridView<id>::template Codim<0>::Entity;
 
+    template<std::size_t id>
+    static constexpr bool isBox()
+    { return FVGridGeometry<id>::discMethod == DiscretizationMethod::box; }
+
+    enum {
+        bulkDim = GridView<bulkIdx>::dimension,
+        lowDimDim = GridView<lowDimIdx>::dimension,
+        dimWorld = GridView<bulkIdx>::dimensionworld
+    };
+
 public:
     static constexpr EmbeddedCouplingMode couplingMode = EmbeddedCouplingMode::line;
 
@@ -117,11 +132,157 @@ public:
         computeLowDimVolumeFractions();
     }
 
+    /* \brief Compute integration point point sources and associated data
+     *
+     * This method uses grid glue to intersect the given grids. Over each intersection
+     * we later need to integrate a source term. This method places point sources
+     * at each quadrature point and provides the point source with the necessary
+     * information to compute integrals (quadrature weight and integration element)
+     * \param order The order of the quadrature rule for integration of sources over an intersection
+     * \param verbose If the point source computation is verbose
+     */
+    void computePointSourceData(std::size_t order = 1, bool verbose = false)
+    {
+        // initilize the maps
+        // do some logging and profiling
+        Dune::Timer watch;
+        std::cout << "Initializing the point sources..." << std::endl;
+
+        // clear all internal members like pointsource vectors and stencils
+        // initializes the point source id counter
+        this->clear();
+        pointSourcesRenumbered_ = true;
+        couplingStencilsGrew_ = true;
+        numRemovedIds_ = 0;
+
+        // precompute the vertex indices for efficiency
+        this->preComputeVertexIndices(bulkIdx);
+        this->preComputeVertexIndices(lowDimIdx);
+
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        const auto& lowDimFvGridGeometry = this->problem(lowDimIdx).fvGridGeometry();
+
+        // intersect the bounding box trees
+        this->glueGrids();
+
+        this->pointSourceData().reserve(this->glue().size());
+        this->averageDistanceToBulkCell().reserve(this->glue().size());
+        std::vector<std::size_t> bulkElementIndices;
+        for (const auto& is : intersections(this->glue()))
+        {
+            // all inside elements are identical...
+            const auto& inside = is.inside(0);
+            const std::size_t lowDimElementIdx = lowDimFvGridGeometry.elementMapper().index(inside);
+
+            bulkElementIndices.clear();
+            for (std::size_t outsideIdx = 0; outsideIdx < is.neighbor(0); ++outsideIdx)
+                bulkElementIndices.push_back(bulkFvGridGeometry.elementMapper().index(is.outside(outsideIdx)));
+
+            addPointSources_(is.geometry(), lowDimElementIdx, bulkElementIndices, order);
+        }
+
+        // make stencils unique
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::index_constant<2>{}), [&](const auto domainIdx)
+        {
+            for (auto&& stencil : this->couplingStencils(domainIdx))
+            {
+                std::sort(stencil.second.begin(), stencil.second.end());
+                stencil.second.erase(std::unique(stencil.second.begin(), stencil.second.end()), stencil.second.end());
+            }
+        });
+
+        std::cout << "took " << watch.elapsed() << " seconds." << std::endl;
+    }
+
+    /*!
+     * \brief Updates the point sources after the low-dimensional grid has grown
+     *
+     * Only the point sources, stencils and volume fractions of the given low-dimensional
+     * elements (e.g. with moved corners) and of all new elements are recomputed,
+     * the new elements are intersected with the bulk grid one by one instead of gluing the grids.
+     * This requires that the indices of the old low-dimensional elements did not change
+     * (new elements are appended as in Dune::FoamGrid growth, GridGrowth::update checks this and reports
+     * all elements as changed otherwise). With fewer elements than before, or if more point sources
+     * were removed than remain, everything is recomputed.
+     * \note The ids of the remaining point sources do not change, the new ones are appended. Unless
+     *       pointSourcesRenumbered(), the point source maps of the sub problems can be updated by id
+     *       (EmbeddedPointSourceProblem::updatePointSourceMap), and the Jacobian pattern has to grow
+     *       only if couplingStencilsGrew().
+     * \note Bulk coupling stencil entries of moved elements are not removed, i.e. the stencils are a superset
+     */
+    void update(const std::vector<std::size_t>& lowDimElementIndices, const SolutionVector& curSol)
+    {
+        this->updateSolution(curSol);
+        const auto order = getParam<int>("MixedDimension.IntegrationOrder", 1);
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        const auto& lowDimFvGridGeometry = this->problem(lowDimIdx).fvGridGeometry();
+        const std::size_t numLowDimElements = this->gridView(lowDimIdx).size(0);
+        if (numLowDimElements < lowDimVolumeInBulkElement_.numLowDimElements()
+            || this->gridView(bulkIdx).size(0) != lowDimVolumeInBulkElement_.numBulkElements()
+            || 2*numRemovedIds_ > this->pointSourceData().size())
+        {
+            computePointSourceData(order);
+            computeLowDimVolumeFractions();
+            return;
+        }
+
+        Dune::Timer watch;
+        const std::size_t numOldLowDimElements = lowDimVolumeInBulkElement_.numLowDimElements();
+        std::vector<bool> isUpdated;
+        const auto updatedElements = EmbeddedCoupling::updatedElements(lowDimElementIndices, numOldLowDimElements,
+                                                                       numLowDimElements, isUpdated);
+        pointSourcesRenumbered_ = false;
+        couplingStencilsGrew_ = numLowDimElements > numOldLowDimElements; // the Jacobian pattern grows with the grid
+
+        // remove the old point sources and the low dim stencils of the updated elements (the other ids are kept)
+        this->preComputeVertexIndices(lowDimIdx);
+        if (!updatedElements.empty() && updatedElements.front() < numOldLowDimElements)
+            numRemovedIds_ += EmbeddedCoupling::removePointSources(this->pointSources(bulkIdx), this->pointSources(lowDimIdx),
+                                                                   this->pointSourceData(), isUpdated).size();
+        const auto oldLowDimStencils = EmbeddedCoupling::eraseStencils(this->couplingStencils(lowDimIdx), updatedElements);
+
+        // add the new point sources
+        const std::size_t firstNewId = this->idCounter_;
+        for (const auto lowDimElementIdx : updatedElements)
+        {
+            const auto lowDimGeometry = lowDimFvGridGeometry.element(lowDimElementIdx).geometry();
+            for (const auto& piece : EmbeddedCoupling::segmentIntersections(bulkFvGridGeometry, lowDimGeometry.corner(0), lowDimGeometry.corner(1)))
+            {
+                const Dune::AffineGeometry<Scalar, lowDimDim, dimWorld> geometry(lowDimGeometry.type(), piece.corners);
+                addPointSources_(geometry, lowDimElementIdx, piece.bulkElementIndices, order);
+            }
+
+            const auto radius = this->problem(lowDimIdx).spatialParams().radius(lowDimElementIdx);
+            EmbeddedCoupling::updateLowDimVolume(lowDimVolumeInBulkElement_, bulkFvGridGeometry, lowDimElementIdx, lowDimGeometry, radius);
+        }
+
+        // make the changed stencils unique
+        std::vector<std::size_t> bulkElements;
+        for (std::size_t id = firstNewId; id < this->pointSourceData().size(); ++id)
+            bulkElements.push_back(this->pointSourceData()[id].bulkElementIdx());
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(lowDimIdx), updatedElements);
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(bulkIdx), bulkElements);
+        if (!couplingStencilsGrew_)
+            couplingStencilsGrew_ = EmbeddedCoupling::stencilsGrew(this->couplingStencils(lowDimIdx), oldLowDimStencils, updatedElements);
+
+        std::cout << "Updated the point sources of " << updatedElements.size() << " elements, took "
+                  << watch.elapsed() << " seconds." << std::endl;
+    }
+
+    //! if the last update recomputed all point sources with new ids, i.e. the point source maps of the sub problems have to be recomputed
+    bool pointSourcesRenumbered() const
+    { return pointSourcesRenumbered_; }
+
+    //! if the last update added low dim elements or coupling stencil entries, i.e. the Jacobian pattern has to grow
+    bool couplingStencilsGrew() const
+    { return couplingStencilsGrew_; }
+
     //! Compute the low dim volume fraction in the bulk domain cells
     void computeLowDimVolumeFractions()
     {
-        // resize the storage vector
-        lowDimVolumeInBulkElement_.resize(this->gridView(bulkIdx).size(0));
+        // reset the storage
+        lowDimVolumeInBulkElement_.reset(this->gridView(bulkIdx).size(0), this->gridView(lowDimIdx).size(0));
 
         // compute the low dim volume fractions
         for (const auto& is : intersections(this->glue()))
@@ -137,7 +298,7 @@ public:
             {
                 const auto& outside = is.outside(outsideIdx);
                 const std::size_t bulkElementIdx = this->problem(bulkIdx).fvGridGeometry().elementMapper().index(outside);
-                lowDimVolumeInBulkElement_[bulkElementIdx] += intersectionGeometry.volume()*M_PI*radius*radius;
+                lowDimVolumeInBulkElement_.add(lowDimElementIdx, bulkElementIdx, intersectionGeometry.volume()*M_PI*radius*radius);
             }
         }
     }
@@ -173,8 +334,105 @@ public:
     // \}
 
 private:
-    //! vector for the volume fraction of the lowdim domain in the bulk domain cells
-    std::vector<Scalar> lowDimVolumeInBulkElement_;
+    //! places the point sources on the quadrature points of an intersection of a low dim element with the bulk elements
+    template<class IntersectionGeometry>
+    void addPointSources_(const IntersectionGeometry& intersectionGeometry, std::size_t lowDimElementIdx,
+                          const std::vector<std::size_t>& bulkElementIndices, std::size_t order)
+    {
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        const auto& lowDimFvGridGeometry = this->problem(lowDimIdx).fvGridGeometry();
+
+        // get the Gaussian quadrature rule for the local intersection
+        const auto& quad = Dune::QuadratureRules<Scalar, lowDimDim>::rule(intersectionGeometry.type(), order);
+
+        // iterate over all quadrature points
+        for (auto&& qp : quad)
+        {
+            // compute the coupling stencils
+            for (const auto bulkElementIdx : bulkElementIndices)
+            {
+                // each quadrature point will be a point source for the sub problem
+                const auto globalPos = intersectionGeometry.global(qp.position());
+                const auto id = this->idCounter_++;
+                const auto qpweight = qp.weight();
+                const auto ie = intersectionGeometry.integrationElement(qp.position());
+                this->pointSources(bulkIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({bulkElementIdx}));
+                this->pointSources(bulkIdx).back().setEmbeddings(bulkElementIndices.size());
+                this->pointSources(lowDimIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({lowDimElementIdx}));
+                this->pointSources(lowDimIdx).back().setEmbeddings(bulkElementIndices.size());
+
+                // pre compute additional data used for the evaluation of
+                // the actual solution dependent source term
+                PointSourceData psData;
+
+                if (isBox<lowDimIdx>())
+                {
+                    using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
+                    const auto lowDimGeometry = lowDimFvGridGeometry.element(lowDimElementIdx).geometry();
+                    ShapeValues shapeValues;
+                    this->getShapeValues(lowDimIdx, lowDimFvGridGeometry, lowDimGeometry, globalPos, shapeValues);
+                    psData.addLowDimInterpolation(shapeValues, this->vertexIndices(lowDimIdx, lowDimElementIdx), lowDimElementIdx);
+                }
+                else
+                {
+                    psData.addLowDimInterpolation(lowDimElementIdx);
+                }
+
+                const auto bulkGeometry = bulkFvGridGeometry.element(bulkElementIdx).geometry();
+                if (isBox<bulkIdx>())
+                {
+                    using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
+                    ShapeValues shapeValues;
+                    this->getShapeValues(bulkIdx, bulkFvGridGeometry, bulkGeometry, globalPos, shapeValues);
+                    psData.addBulkInterpolation(shapeValues, this->vertexIndices(bulkIdx, bulkElementIdx), bulkElementIdx);
+                }
+                else
+                {
+                    psData.addBulkInterpolation(bulkElementIdx);
+                }
+
+                // publish point source data in the global vector
+                this->pointSourceData().emplace_back(std::move(psData));
+
+                // compute average distance to bulk cell
+                this->averageDistanceToBulkCell().push_back(this->computeDistance(bulkGeometry, globalPos));
+
+                // export the lowdim coupling stencil
+                // we insert all vertices / elements and make it unique later
+                if (isBox<bulkIdx>())
+                {
+                    const auto& vertices = this->vertexIndices(bulkIdx, bulkElementIdx);
+                    this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
+                                                                               vertices.begin(), vertices.end());
+                }
+                else
+                {
+                    this->couplingStencils(lowDimIdx)[lowDimElementIdx].push_back(bulkElementIdx);
+                }
+
+                // export the bulk coupling stencil
+                // we insert all vertices / elements and make it unique later
+                if (isBox<lowDimIdx>())
+                {
+                    const auto& vertices = this->vertexIndices(lowDimIdx, lowDimElementIdx);
+                    EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], vertices.begin(), vertices.end(), couplingStencilsGrew_);
+                }
+                else
+                {
+                    EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], lowDimElementIdx, couplingStencilsGrew_);
+                }
+            }
+        }
+    }
+
+    //! the volume of the lowdim domain in the bulk domain cells
+    EmbeddedCoupling::LowDimVolumes<Scalar> lowDimVolumeInBulkElement_;
+
+    //! see pointSourcesRenumbered() and couplingStencilsGrew()
+    bool pointSourcesRenumbered_ = true;
+    bool couplingStencilsGrew_ = true;
+    //! the number of point source ids removed since the point sources were computed
+    std::size_t numRemovedIds_ = 0;
 };
 
 /*!
@@ -270,9 +528,6 @@ public:
      */
     void computePointSourceData(std::size_t order = 1, bool verbose = false)
     {
-        // Initialize the bulk bounding box tree
-        const auto& bulkTree = this->problem(bulkIdx).fvGridGeometry().boundingBoxTree();
-
         // initilize the maps
         // do some logging and profiling
         Dune::Timer watch;
@@ -281,6 +536,9 @@ public:
         // clear all internal members like pointsource vectors and stencils
         // initializes the point source id counter
         this->clear();
+        pointSourcesRenumbered_ = true;
+        couplingStencilsGrew_ = true;
+        numRemovedIds_ = 0;
         extendedSourceStencil_.stencil().clear();
 
         // precompute the vertex indices for efficiency
@@ -288,193 +546,12 @@ public:
         this->preComputeVertexIndices(lowDimIdx);
 
         // iterate over all lowdim elements
-        const auto& lowDimProblem = this->problem(lowDimIdx);
         for (const auto& lowDimElement : elements(this->gridView(lowDimIdx)))
-        {
-            // get the Gaussian quadrature rule for the low dim element
-            const auto lowDimGeometry = lowDimElement.geometry();
-            const auto& quad = Dune::QuadratureRules<Scalar, lowDimDim>::rule(lowDimGeometry.type(), order);
-
-            const auto lowDimElementIdx = lowDimProblem.fvGridGeometry().elementMapper().index(lowDimElement);
-
-            // apply the Gaussian quadrature rule and define point sources at each quadrature point
-            // note that the approximation is not optimal if
-            // (a) the one-dimensional elements are too large,
-            // (b) whenever a one-dimensional element is split between two or more elements,
-            // (c) when gradients of important quantities in the three-dimensional domain are large.
-
-            // iterate over all quadrature points
-            for (auto&& qp : quad)
-            {
-                // global position of the quadrature point
-                const auto globalPos = lowDimGeometry.global(qp.position());
-
-                const auto bulkElementIndices = intersectingEntities(globalPos, bulkTree);
-
-                // do not add a point source if the qp is outside of the 3d grid
-                // this is equivalent to having a source of zero for that qp
-                if (bulkElementIndices.empty())
-                    continue;
-
-                //////////////////////////////////////////////////////////
-                // get circle average connectivity and interpolation data
-                //////////////////////////////////////////////////////////
-
-                static const auto numIp = getParam<int>("MixedDimension.NumCircleSegments");
-                const auto radius = lowDimProblem.spatialParams().radius(lowDimElementIdx);
-                const auto normal = lowDimGeometry.corner(1)-lowDimGeometry.corner(0);
-                const auto weight = 2*M_PI*radius/numIp;
-
-                const auto circlePoints = EmbeddedCoupling::circlePoints(globalPos, normal, radius, numIp);
-                std::vector<Scalar> circleIpWeight(circlePoints.size());
-                std::vector<std::size_t> circleStencil(circlePoints.size());
-                // for box
-                std::unordered_map<std::size_t, std::vector<std::size_t> > circleCornerIndices;
-                using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
-                std::unordered_map<std::size_t, ShapeValues> circleShapeValues;
-
-                for (int k = 0; k < circlePoints.size(); ++k)
-                {
-                    const auto circleBulkElementIndices = intersectingEntities(circlePoints[k], bulkTree);
-                    if (circleBulkElementIndices.empty())
-                        continue;
-
-                    const auto bulkElementIdx = circleBulkElementIndices[0];
-                    circleStencil[k] = bulkElementIdx;
-                    circleIpWeight[k] = weight;
-
-                    if (isBox<bulkIdx>())
-                    {
-                        if (!static_cast<bool>(circleCornerIndices.count(bulkElementIdx)))
-                        {
-                            const auto bulkElement = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx);
-                            circleCornerIndices[bulkElementIdx] = this->vertexIndices(bulkIdx, bulkElementIdx);
-
-                            // evaluate shape functions at the integration point
-                            const auto bulkGeometry = bulkElement.geometry();
-                            this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, circlePoints[k], circleShapeValues[bulkElementIdx]);
-                        }
-                    }
-                }
-
-                // export low dim circle stencil
-                if (isBox<bulkIdx>())
-                {
-                    // we insert all vertices and make it unique later
-                    for (const auto& vertices : circleCornerIndices)
-                    {
-                        this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
-                                                                                   vertices.second.begin(), vertices.second.end());
-
-                    }
-                }
-                else
-                {
-                    this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
-                                                                               circleStencil.begin(), circleStencil.end());
-                }
-
-                // loop over the bulk elements at the integration points (usually one except when it is on a face or edge or vertex)
-                for (auto bulkElementIdx : bulkElementIndices)
-                {
-                    const auto id = this->idCounter_++;
-                    const auto ie = lowDimGeometry.integrationElement(qp.position());
-                    const auto qpweight = qp.weight();
-
-                    this->pointSources(bulkIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({bulkElementIdx}));
-                    this->pointSources(bulkIdx).back().setEmbeddings(bulkElementIndices.size());
-                    this->pointSources(lowDimIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({lowDimElementIdx}));
-                    this->pointSources(lowDimIdx).back().setEmbeddings(bulkElementIndices.size());
-
-                    // pre compute additional data used for the evaluation of
-                    // the actual solution dependent source term
-                    PointSourceData psData;
-
-                    if (isBox<lowDimIdx>())
-                    {
-                        ShapeValues shapeValues;
-                        this->getShapeValues(lowDimIdx, this->problem(lowDimIdx).fvGridGeometry(), lowDimGeometry, globalPos, shapeValues);
-                        psData.addLowDimInterpolation(shapeValues, this->vertexIndices(lowDimIdx, lowDimElementIdx), lowDimElementIdx);
-                    }
-                    else
-                    {
-                        psData.addLowDimInterpolation(lowDimElementIdx);
-                    }
-
-                    // add data needed to compute integral over the circle
-                    if (isBox<bulkIdx>())
-                    {
-                        psData.addCircleInterpolation(circleCornerIndices, circleShapeValues, circleIpWeight, circleStencil);
-
-                        const auto bulkGeometry = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx).geometry();
-                        ShapeValues shapeValues;
-                        this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, globalPos, shapeValues);
-                        psData.addBulkInterpolation(shapeValues, this->vertexIndices(bulkIdx, bulkElementIdx), bulkElementIdx);
-                    }
-                    else
-                    {
-                        psData.addCircleInterpolation(circleIpWeight, circleStencil);
-                        psData.addBulkInterpolation(bulkElementIdx);
-                    }
-
-                    // publish point source data in the global vector
-                    this->pointSourceData().emplace_back(std::move(psData));
-
-                    // export the bulk coupling stencil
-                    if (isBox<lowDimIdx>())
-                    {
-                        this->couplingStencils(bulkIdx)[bulkElementIdx].insert(this->couplingStencils(bulkIdx)[bulkElementIdx].end(),
-                                                                               this->vertexIndices(lowDimIdx, lowDimElementIdx).begin(),
-                                                                               this->vertexIndices(lowDimIdx, lowDimElementIdx).end());
-
-                    }
-                    else
-                    {
-                        this->couplingStencils(bulkIdx)[bulkElementIdx].push_back(lowDimElementIdx);
-                    }
-
-                    // export bulk circle stencil
-                    if (isBox<bulkIdx>())
-                    {
-                        // we insert all vertices and make it unique later
-                        for (const auto& vertices : circleCornerIndices)
-                        {
-                            extendedSourceStencil_.stencil()[bulkElementIdx].insert(extendedSourceStencil_.stencil()[bulkElementIdx].end(),
-                                                                       vertices.second.begin(), vertices.second.end());
-
-                        }
-                    }
-                    else
-                    {
-                        extendedSourceStencil_.stencil()[bulkElementIdx].insert(extendedSourceStencil_.stencil()[bulkElementIdx].end(),
-                                                                   circleStencil.begin(), circleStencil.end());
-                    }
-                }
-            }
-        }
+            addPointSources_(lowDimElement, order);
 
         // make the circle stencil unique (for source derivatives)
         for (auto&& stencil : extendedSourceStencil_.stencil())
-        {
-            std::sort(stencil.second.begin(), stencil.second.end());
-            stencil.second.erase(std::unique(stencil.second.begin(), stencil.second.end()), stencil.second.end());
-
-            // remove the vertices element (box)
-            if (isBox<bulkIdx>())
-            {
-                const auto& indices = this->vertexIndices(bulkIdx, stencil.first);
-                stencil.second.erase(std::remove_if(stencil.second.begin(), stencil.second.end(),
-                                                   [&](auto i){ return std::find(indices.begin(), indices.end(), i) != indices.end(); }),
-                                     stencil.second.end());
-            }
-            // remove the own element (cell-centered)
-            else
-            {
-                stencil.second.erase(std::remove_if(stencil.second.begin(), stencil.second.end(),
-                                                   [&](auto i){ return i == stencil.first; }),
-                                     stencil.second.end());
-            }
-        }
+            makeExtendedStencilUnique_(stencil.first, stencil.second);
 
         // make stencils unique
         using namespace Dune::Hybrid;
@@ -490,11 +567,97 @@ public:
         std::cout << "took " << watch.elapsed() << " seconds." << std::endl;
     }
 
+    /*!
+     * \brief Updates the point sources after the low-dimensional grid has grown
+     *
+     * Only the point sources, stencils and volume fractions of the given low-dimensional
+     * elements (e.g. with moved corners) and of all new elements are recomputed.
+     * This requires that the indices of the old low-dimensional elements did not change
+     * (new elements are appended as in Dune::FoamGrid growth, GridGrowth::update checks this and reports
+     * all elements as changed otherwise). With fewer elements than before, or if more point sources
+     * were removed than remain, everything is recomputed.
+     * \note The ids of the remaining point sources do not change, the new ones are appended. Unless
+     *       pointSourcesRenumbered(), the point source maps of the sub problems can be updated by id
+     *       (EmbeddedPointSourceProblem::updatePointSourceMap), and the Jacobian pattern has to grow
+     *       only if couplingStencilsGrew().
+     * \note Bulk coupling stencil entries of moved elements are not removed, i.e. the stencils are a superset
+     */
+    void update(const std::vector<std::size_t>& lowDimElementIndices, const SolutionVector& curSol)
+    {
+        this->updateSolution(curSol);
+        const auto order = getParam<int>("MixedDimension.IntegrationOrder", 1);
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        const auto& lowDimFvGridGeometry = this->problem(lowDimIdx).fvGridGeometry();
+        const std::size_t numLowDimElements = this->gridView(lowDimIdx).size(0);
+        if (numLowDimElements < lowDimVolumeInBulkElement_.numLowDimElements()
+            || this->gridView(bulkIdx).size(0) != lowDimVolumeInBulkElement_.numBulkElements()
+            || 2*numRemovedIds_ > this->pointSourceData().size())
+        {
+            computePointSourceData(order);
+            computeLowDimVolumeFractions();
+            return;
+        }
+
+        Dune::Timer watch;
+        const std::size_t numOldLowDimElements = lowDimVolumeInBulkElement_.numLowDimElements();
+        std::vector<bool> isUpdated;
+        const auto updatedElements = EmbeddedCoupling::updatedElements(lowDimElementIndices, numOldLowDimElements,
+                                                                       numLowDimElements, isUpdated);
+        pointSourcesRenumbered_ = false;
+        couplingStencilsGrew_ = numLowDimElements > numOldLowDimElements; // the Jacobian pattern grows with the grid
+
+        // remove the old point sources and the low dim stencils of the updated elements (the other ids are kept)
+        this->preComputeVertexIndices(lowDimIdx);
+        if (!updatedElements.empty() && updatedElements.front() < numOldLowDimElements)
+            numRemovedIds_ += EmbeddedCoupling::removePointSources(this->pointSources(bulkIdx), this->pointSources(lowDimIdx),
+                                                                   this->pointSourceData(), isUpdated).size();
+        const auto oldLowDimStencils = EmbeddedCoupling::eraseStencils(this->couplingStencils(lowDimIdx), updatedElements);
+
+        // add the new point sources
+        const std::size_t firstNewId = this->idCounter_;
+        for (const auto lowDimElementIdx : updatedElements)
+        {
+            const auto lowDimElement = lowDimFvGridGeometry.element(lowDimElementIdx);
+            addPointSources_(lowDimElement, order);
+
+            const auto radius = this->problem(lowDimIdx).spatialParams().radius(lowDimElementIdx);
+            EmbeddedCoupling::updateLowDimVolume(lowDimVolumeInBulkElement_, bulkFvGridGeometry, lowDimElementIdx, lowDimElement.geometry(), radius);
+        }
+
+        // make the changed stencils unique
+        std::vector<std::size_t> bulkElements;
+        for (std::size_t id = firstNewId; id < this->pointSourceData().size(); ++id)
+            bulkElements.push_back(this->pointSourceData()[id].bulkElementIdx());
+        std::sort(bulkElements.begin(), bulkElements.end());
+        bulkElements.erase(std::unique(bulkElements.begin(), bulkElements.end()), bulkElements.end());
+        for (const auto bulkElementIdx : bulkElements)
+        {
+            auto it = extendedSourceStencil_.stencil().find(bulkElementIdx);
+            if (it != extendedSourceStencil_.stencil().end())
+                makeExtendedStencilUnique_(it->first, it->second);
+        }
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(lowDimIdx), updatedElements);
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(bulkIdx), bulkElements);
+        if (!couplingStencilsGrew_)
+            couplingStencilsGrew_ = EmbeddedCoupling::stencilsGrew(this->couplingStencils(lowDimIdx), oldLowDimStencils, updatedElements);
+
+        std::cout << "Updated the point sources of " << updatedElements.size() << " elements, took "
+                  << watch.elapsed() << " seconds." << std::endl;
+    }
+
+    //! if the last update recomputed all point sources with new ids, i.e. the point source maps of the sub problems have to be recomputed
+    bool pointSourcesRenumbered() const
+    { return pointSourcesRenumbered_; }
+
+    //! if the last update added low dim elements or coupling stencil entries, i.e. the Jacobian pattern has to grow
+    bool couplingStencilsGrew() const
+    { return couplingStencilsGrew_; }
+
     //! Compute the low dim volume fraction in the bulk domain cells
     void computeLowDimVolumeFractions()
     {
-        // resize the storage vector
-        lowDimVolumeInBulkElement_.resize(this->gridView(bulkIdx).size(0));
+        // reset the storage
+        lowDimVolumeInBulkElement_.reset(this->gridView(bulkIdx).size(0), this->gridView(lowDimIdx).size(0));
 
         // compute the low dim volume fractions
         for (const auto& is : intersections(this->glue()))
@@ -510,7 +673,7 @@ public:
             {
                 const auto& outside = is.outside(outsideIdx);
                 const std::size_t bulkElementIdx = this->problem(bulkIdx).fvGridGeometry().elementMapper().index(outside);
-                lowDimVolumeInBulkElement_[bulkElementIdx] += intersectionGeometry.volume()*M_PI*radius*radius;
+                lowDimVolumeInBulkElement_.add(lowDimElementIdx, bulkElementIdx, intersectionGeometry.volume()*M_PI*radius*radius);
             }
         }
     }
@@ -546,11 +709,227 @@ public:
     // \}
 
 private:
+    //! places the point sources on the quadrature points of a low dim element
+    void addPointSources_(const Element<lowDimIdx>& lowDimElement, std::size_t order)
+    {
+        const auto& bulkTree = this->problem(bulkIdx).fvGridGeometry().boundingBoxTree();
+        const auto& lowDimProblem = this->problem(lowDimIdx);
+
+        // get the Gaussian quadrature rule for the low dim element
+        const auto lowDimGeometry = lowDimElement.geometry();
+        const auto& quad = Dune::QuadratureRules<Scalar, lowDimDim>::rule(lowDimGeometry.type(), order);
+
+        const auto lowDimElementIdx = lowDimProblem.fvGridGeometry().elementMapper().index(lowDimElement);
+
+        // apply the Gaussian quadrature rule and define point sources at each quadrature point
+        // note that the approximation is not optimal if
+        // (a) the one-dimensional elements are too large,
+        // (b) whenever a one-dimensional element is split between two or more elements,
+        // (c) when gradients of important quantities in the three-dimensional domain are large.
+
+        // iterate over all quadrature points
+        for (auto&& qp : quad)
+        {
+            // global position of the quadrature point
+            const auto globalPos = lowDimGeometry.global(qp.position());
+
+            const auto bulkElementIndices = intersectingEntities(globalPos, bulkTree);
+
+            // do not add a point source if the qp is outside of the 3d grid
+            // this is equivalent to having a source of zero for that qp
+            if (bulkElementIndices.empty())
+                continue;
+
+            //////////////////////////////////////////////////////////
+            // get circle average connectivity and interpolation data
+            //////////////////////////////////////////////////////////
+
+            static const auto numIp = getParam<int>("MixedDimension.NumCircleSegments");
+            const auto radius = lowDimProblem.spatialParams().radius(lowDimElementIdx);
+            const auto normal = lowDimGeometry.corner(1)-lowDimGeometry.corner(0);
+            const auto weight = 2*M_PI*radius/numIp;
+
+            const auto circlePoints = EmbeddedCoupling::circlePoints(globalPos, normal, radius, numIp);
+            std::vector<Scalar> circleIpWeight(circlePoints.size());
+            std::vector<std::size_t> circleStencil(circlePoints.size());
+            // for box
+            std::unordered_map<std::size_t, std::vector<std::size_t> > circleCornerIndices;
+            using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
+            std::unordered_map<std::size_t, ShapeValues> circleShapeValues;
+
+            for (int k = 0; k < circlePoints.size(); ++k)
+            {
+                const auto circleBulkElementIndices = intersectingEntities(circlePoints[k], bulkTree);
+                if (circleBulkElementIndices.empty())
+                    continue;
+
+                const auto bulkElementIdx = circleBulkElementIndices[0];
+                circleStencil[k] = bulkElementIdx;
+                circleIpWeight[k] = weight;
+
+                if (isBox<bulkIdx>())
+                {
+                    if (!static_cast<bool>(circleCornerIndices.count(bulkElementIdx)))
+                    {
+                        const auto bulkElement = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx);
+                        circleCornerIndices[bulkElementIdx] = this->vertexIndices(bulkIdx, bulkElementIdx);
+
+                        // evaluate shape functions at the integration point
+                        const auto bulkGeometry = bulkElement.geometry();
+                        this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, circlePoints[k], circleShapeValues[bulkElementIdx]);
+                    }
+                }
+            }
+
+            // export low dim circle stencil
+            if (isBox<bulkIdx>())
+            {
+                // we insert all vertices and make it unique later
+                for (const auto& vertices : circleCornerIndices)
+                {
+                    this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
+                                                                               vertices.second.begin(), vertices.second.end());
+
+                }
+            }
+            else
+            {
+                this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
+                                                                           circleStencil.begin(), circleStencil.end());
+            }
+
+            // loop over the bulk elements at the integration points (usually one except when it is on a face or edge or vertex)
+            for (auto bulkElementIdx : bulkElementIndices)
+            {
+                const auto id = this->idCounter_++;
+                const auto ie = lowDimGeometry.integrationElement(qp.position());
+                const auto qpweight = qp.weight();
+
+                this->pointSources(bulkIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({bulkElementIdx}));
+                this->pointSources(bulkIdx).back().setEmbeddings(bulkElementIndices.size());
+                this->pointSources(lowDimIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({lowDimElementIdx}));
+                this->pointSources(lowDimIdx).back().setEmbeddings(bulkElementIndices.size());
+
+                // pre compute additional data used for the evaluation of
+                // the actual solution dependent source term
+                PointSourceData psData;
+
+                if (isBox<lowDimIdx>())
+                {
+                    ShapeValues shapeValues;
+                    this->getShapeValues(lowDimIdx, this->problem(lowDimIdx).fvGridGeometry(), lowDimGeometry, globalPos, shapeValues);
+                    psData.addLowDimInterpolation(shapeValues, this->vertexIndices(lowDimIdx, lowDimElementIdx), lowDimElementIdx);
+                }
+                else
+                {
+                    psData.addLowDimInterpolation(lowDimElementIdx);
+                }
+
+                // add data needed to compute integral over the circle
+                if (isBox<bulkIdx>())
+                {
+                    psData.addCircleInterpolation(circleCornerIndices, circleShapeValues, circleIpWeight, circleStencil);
+
+                    const auto bulkGeometry = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx).geometry();
+                    ShapeValues shapeValues;
+                    this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, globalPos, shapeValues);
+                    psData.addBulkInterpolation(shapeValues, this->vertexIndices(bulkIdx, bulkElementIdx), bulkElementIdx);
+                }
+                else
+                {
+                    psData.addCircleInterpolation(circleIpWeight, circleStencil);
+                    psData.addBulkInterpolation(bulkElementIdx);
+                }
+
+                // publish point source data in the global vector
+                this->pointSourceData().emplace_back(std::move(psData));
+
+                // export the bulk coupling stencil
+                if (isBox<lowDimIdx>())
+                {
+                    const auto& vertices = this->vertexIndices(lowDimIdx, lowDimElementIdx);
+                    EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], vertices.begin(), vertices.end(), couplingStencilsGrew_);
+
+                }
+                else
+                {
+                    EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], lowDimElementIdx, couplingStencilsGrew_);
+                }
+
+                // export bulk circle stencil
+                if (isBox<bulkIdx>())
+                {
+                    // we insert all vertices and make it unique later
+                    for (const auto& vertices : circleCornerIndices)
+                    {
+                        extendExtendedStencil_(bulkElementIdx, vertices.second);
+
+                    }
+                }
+                else
+                {
+                    extendExtendedStencil_(bulkElementIdx, circleStencil);
+                }
+            }
+        }
+    }
+
+    //! appends dofs to the extended stencil of a bulk element (made unique later), and sets couplingStencilsGrew_ if one of them is new
+    template<class Dofs>
+    void extendExtendedStencil_(std::size_t bulkElementIdx, const Dofs& dofs)
+    {
+        auto& stencil = extendedSourceStencil_.stencil()[bulkElementIdx];
+        for (auto it = dofs.begin(); it != dofs.end() && !couplingStencilsGrew_; ++it)
+            if (!isOwnDof_(bulkElementIdx, *it)) // removed by makeExtendedStencilUnique_
+                couplingStencilsGrew_ = std::find(stencil.begin(), stencil.end(), *it) == stencil.end();
+        stencil.insert(stencil.end(), dofs.begin(), dofs.end());
+    }
+
+    //! if the dof belongs to the bulk element itself (its vertices, or the element)
+    bool isOwnDof_(std::size_t bulkElementIdx, std::size_t dofIdx) const
+    {
+        if (isBox<bulkIdx>())
+        {
+            const auto& indices = this->vertexIndices(bulkIdx, bulkElementIdx);
+            return std::find(indices.begin(), indices.end(), dofIdx) != indices.end();
+        }
+        return dofIdx == bulkElementIdx;
+    }
+
+    //! makes the extended stencil of a bulk element unique and removes the dofs of the element itself
+    void makeExtendedStencilUnique_(std::size_t bulkElementIdx, std::vector<std::size_t>& stencil) const
+    {
+        std::sort(stencil.begin(), stencil.end());
+        stencil.erase(std::unique(stencil.begin(), stencil.end()), stencil.end());
+
+        // remove the vertices element (box)
+        if (isBox<bulkIdx>())
+        {
+            const auto& indices = this->vertexIndices(bulkIdx, bulkElementIdx);
+            stencil.erase(std::remove_if(stencil.begin(), stencil.end(),
+                                         [&](auto i){ return std::find(indices.begin(), indices.end(), i) != indices.end(); }),
+                          stencil.end());
+        }
+        // remove the own element (cell-centered)
+        else
+        {
+            stencil.erase(std::remove_if(stencil.begin(), stencil.end(),
+                                         [&](auto i){ return i == bulkElementIdx; }),
+                          stencil.end());
+        }
+    }
+
     //! the extended source stencil object
     EmbeddedCoupling::ExtendedSourceStencil<ThisType> extendedSourceStencil_;
 
-    //! vector for the volume fraction of the lowdim domain in the bulk domain cells
-    std::vector<Scalar> lowDimVolumeInBulkElement_;
+    //! the volume of the lowdim domain in the bulk domain cells
+    EmbeddedCoupling::LowDimVolumes<Scalar> lowDimVolumeInBulkElement_;
+
+    //! see pointSourcesRenumbered() and couplingStencilsGrew()
+    bool pointSourcesRenumbered_ = true;
+    bool couplingStencilsGrew_ = true;
+    //! the number of point source ids removed since the point sources were computed
+    std::size_t numRemovedIds_ = 0;
 };
 
 
@@ -616,9 +995,6 @@ public:
      */
     void computePointSourceData(std::size_t order = 1, bool verbose = false)
     {
-        // Initialize the bulk bounding box tree
-        const auto& bulkTree = this->problem(bulkIdx).fvGridGeometry().boundingBoxTree();
-
         // initilize the maps
         // do some logging and profiling
         Dune::Timer watch;
@@ -627,132 +1003,17 @@ public:
         // clear all internal members like pointsource vectors and stencils
         // initializes the point source id counter
         this->clear();
+        pointSourcesRenumbered_ = true;
+        couplingStencilsGrew_ = true;
+        numRemovedIds_ = 0;
 
         // precompute the vertex indices for efficiency
         this->preComputeVertexIndices(bulkIdx);
         this->preComputeVertexIndices(lowDimIdx);
 
         // iterate over all lowdim elements
-        const auto& lowDimProblem = this->problem(lowDimIdx);
         for (const auto& lowDimElement : elements(this->gridView(lowDimIdx)))
-        {
-            // get the Gaussian quadrature rule for the low dim element
-            const auto lowDimGeometry = lowDimElement.geometry();
-            const auto& quad = Dune::QuadratureRules<Scalar, lowDimDim>::rule(lowDimGeometry.type(), order);
-
-            const auto lowDimElementIdx = lowDimProblem.fvGridGeometry().elementMapper().index(lowDimElement);
-
-            // apply the Gaussian quadrature rule and define point sources at each quadrature point
-            // note that the approximation is not optimal if
-            // (a) the one-dimensional elements are too large,
-            // (b) whenever a one-dimensional element is split between two or more elements,
-            // (c) when gradients of important quantities in the three-dimensional domain are large.
-
-            // iterate over all quadrature points
-            for (auto&& qp : quad)
-            {
-                // global position of the quadrature point
-                const auto globalPos = lowDimGeometry.global(qp.position());
-
-                const auto bulkElementIndices = intersectingEntities(globalPos, bulkTree);
-
-                // do not add a point source if the qp is outside of the 3d grid
-                // this is equivalent to having a source of zero for that qp
-                if (bulkElementIndices.empty())
-                    continue;
-
-                ////////////////////////////////////////////////////////////////
-                // get points on the cylinder surface at the integration point
-                ////////////////////////////////////////////////////////////////
-
-                static const auto numIp = getParam<int>("MixedDimension.NumCircleSegments", 25);
-                const auto radius = lowDimProblem.spatialParams().radius(lowDimElementIdx);
-                const auto normal = lowDimGeometry.corner(1)-lowDimGeometry.corner(0);
-                const auto integrationElement = lowDimGeometry.integrationElement(qp.position())*2*M_PI*radius/Scalar(numIp);
-                const auto weight = qp.weight()/(2*M_PI*radius);
-
-                const auto circlePoints = EmbeddedCoupling::circlePoints(globalPos, normal, radius, numIp);
-                for (int k = 0; k < circlePoints.size(); ++k)
-                {
-                    const auto& circlePos = circlePoints[k];
-                    const auto circleBulkElementIndices = intersectingEntities(circlePos, bulkTree);
-                    if (circleBulkElementIndices.empty())
-                        continue;
-
-                    // loop over the bulk elements at the integration points (usually one except when it is on a face or edge or vertex)
-                    // and add a point source at every point on the circle
-                    for (const auto bulkElementIdx : circleBulkElementIndices)
-                    {
-                        const auto id = this->idCounter_++;
-                        this->pointSources(bulkIdx).emplace_back(circlePos, id, weight, integrationElement, std::vector<std::size_t>({bulkElementIdx}));
-                        this->pointSources(bulkIdx).back().setEmbeddings(circleBulkElementIndices.size());
-                        this->pointSources(lowDimIdx).emplace_back(globalPos, id, weight, integrationElement, std::vector<std::size_t>({lowDimElementIdx}));
-                        this->pointSources(lowDimIdx).back().setEmbeddings(circleBulkElementIndices.size());
-
-                        // pre compute additional data used for the evaluation of
-                        // the actual solution dependent source term
-                        PointSourceData psData;
-
-                        if (isBox<lowDimIdx>())
-                        {
-                            using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
-                            ShapeValues shapeValues;
-                            this->getShapeValues(lowDimIdx, this->problem(lowDimIdx).fvGridGeometry(), lowDimGeometry, globalPos, shapeValues);
-                            psData.addLowDimInterpolation(shapeValues, this->vertexIndices(lowDimIdx, lowDimElementIdx), lowDimElementIdx);
-                        }
-                        else
-                        {
-                            psData.addLowDimInterpolation(lowDimElementIdx);
-                        }
-
-                        // add data needed to compute integral over the circle
-                        if (isBox<bulkIdx>())
-                        {
-                            using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
-                            const auto bulkGeometry = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx).geometry();
-                            ShapeValues shapeValues;
-                            this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, circlePos, shapeValues);
-                            psData.addBulkInterpolation(shapeValues, this->vertexIndices(bulkIdx, bulkElementIdx), bulkElementIdx);
-                        }
-                        else
-                        {
-                            psData.addBulkInterpolation(bulkElementIdx);
-                        }
-
-                        // publish point source data in the global vector
-                        this->pointSourceData().emplace_back(std::move(psData));
-
-                        // export the lowdim coupling stencil
-                        // we insert all vertices / elements and make it unique later
-                        if (isBox<bulkIdx>())
-                        {
-                            const auto& vertices = this->vertexIndices(bulkIdx, bulkElementIdx);
-                            this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
-                                                                                       vertices.begin(), vertices.end());
-                        }
-                        else
-                        {
-                            this->couplingStencils(lowDimIdx)[lowDimElementIdx].push_back(bulkElementIdx);
-                        }
-
-                        // export the bulk coupling stencil
-                        // we insert all vertices / elements and make it unique later
-                        if (isBox<lowDimIdx>())
-                        {
-                            const auto& vertices = this->vertexIndices(lowDimIdx, lowDimElementIdx);
-                            this->couplingStencils(bulkIdx)[bulkElementIdx].insert(this->couplingStencils(bulkIdx)[bulkElementIdx].end(),
-                                                                                   vertices.begin(), vertices.end());
-
-                        }
-                        else
-                        {
-                            this->couplingStencils(bulkIdx)[bulkElementIdx].push_back(lowDimElementIdx);
-                        }
-
-                    }
-                }
-            }
-        }
+            addPointSources_(lowDimElement, order);
 
         // make stencils unique
         using namespace Dune::Hybrid;
@@ -765,14 +1026,94 @@ public:
             }
         });
 
-        std::cout << "took " << watch.elapsed() << " seconds." << std::endl;
+        std::cout << "took " << watch.elapsed() << " seconds." << std::endl;
+    }
+
+    /*!
+     * \brief Updates the point sources after the low-dimensional grid has grown
+     *
+     * Only the point sources, stencils and volume fractions of the given low-dimensional
+     * elements (e.g. with moved corners) and of all new elements are recomputed.
+     * This requires that the indices of the old low-dimensional elements did not change
+     * (new elements are appended as in Dune::FoamGrid growth, GridGrowth::update checks this and reports
+     * all elements as changed otherwise). With fewer elements than before, or if more point sources
+     * were removed than remain, everything is recomputed.
+     * \note The ids of the remaining point sources do not change, the new ones are appended. Unless
+     *       pointSourcesRenumbered(), the point source maps of the sub problems can be updated by id
+     *       (EmbeddedPointSourceProblem::updatePointSourceMap), and the Jacobian pattern has to grow
+     *       only if couplingStencilsGrew().
+     * \note Bulk coupling stencil entries of moved elements are not removed, i.e. the stencils are a superset
+     */
+    void update(const std::vector<std::size_t>& lowDimElementIndices, const SolutionVector& curSol)
+    {
+        this->updateSolution(curSol);
+        const auto order = getParam<int>("MixedDimension.IntegrationOrder", 1);
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        const auto& lowDimFvGridGeometry = this->problem(lowDimIdx).fvGridGeometry();
+        const std::size_t numLowDimElements = this->gridView(lowDimIdx).size(0);
+        if (numLowDimElements < lowDimVolumeInBulkElement_.numLowDimElements()
+            || this->gridView(bulkIdx).size(0) != lowDimVolumeInBulkElement_.numBulkElements()
+            || 2*numRemovedIds_ > this->pointSourceData().size())
+        {
+            computePointSourceData(order);
+            computeLowDimVolumeFractions();
+            return;
+        }
+
+        Dune::Timer watch;
+        const std::size_t numOldLowDimElements = lowDimVolumeInBulkElement_.numLowDimElements();
+        std::vector<bool> isUpdated;
+        const auto updatedElements = EmbeddedCoupling::updatedElements(lowDimElementIndices, numOldLowDimElements,
+                                                                       numLowDimElements, isUpdated);
+        pointSourcesRenumbered_ = false;
+        couplingStencilsGrew_ = numLowDimElements > numOldLowDimElements; // the Jacobian pattern grows with the grid
+
+        // remove the old point sources and the low dim stencils of the updated elements (the other ids are kept)
+        this->preComputeVertexIndices(lowDimIdx);
+        if (!updatedElements.empty() && updatedElements.front() < numOldLowDimElements)
+            numRemovedIds_ += EmbeddedCoupling::removePointSources(this->pointSources(bulkIdx), this->pointSources(lowDimIdx),
+                                                                   this->pointSourceData(), isUpdated).size();
+        const auto oldLowDimStencils = EmbeddedCoupling::eraseStencils(this->couplingStencils(lowDimIdx), updatedElements);
+
+        // add the new point sources
+        const std::size_t firstNewId = this->idCounter_;
+        for (const auto lowDimElementIdx : updatedElements)
+        {
+            const auto lowDimElement = lowDimFvGridGeometry.element(lowDimElementIdx);
+            addPointSources_(lowDimElement, order);
+
+            const auto radius = this->problem(lowDimIdx).spatialParams().radius(lowDimElementIdx);
+            EmbeddedCoupling::updateLowDimVolume(lowDimVolumeInBulkElement_, bulkFvGridGeometry, lowDimElementIdx, lowDimElement.geometry(), radius);
+        }
+
+        // make the changed stencils unique
+        std::vector<std::size_t> bulkElements;
+        for (std::size_t id = firstNewId; id < this->pointSourceData().size(); ++id)
+            bulkElements.push_back(this->pointSourceData()[id].bulkElementIdx());
+        std::sort(bulkElements.begin(), bulkElements.end());
+        bulkElements.erase(std::unique(bulkElements.begin(), bulkElements.end()), bulkElements.end());
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(lowDimIdx), updatedElements);
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(bulkIdx), bulkElements);
+        if (!couplingStencilsGrew_)
+            couplingStencilsGrew_ = EmbeddedCoupling::stencilsGrew(this->couplingStencils(lowDimIdx), oldLowDimStencils, updatedElements);
+
+        std::cout << "Updated the point sources of " << updatedElements.size() << " elements, took "
+                  << watch.elapsed() << " seconds." << std::endl;
     }
 
+    //! if the last update recomputed all point sources with new ids, i.e. the point source maps of the sub problems have to be recomputed
+    bool pointSourcesRenumbered() const
+    { return pointSourcesRenumbered_; }
+
+    //! if the last update added low dim elements or coupling stencil entries, i.e. the Jacobian pattern has to grow
+    bool couplingStencilsGrew() const
+    { return couplingStencilsGrew_; }
+
     //! Compute the low dim volume fraction in the bulk domain cells
     void computeLowDimVolumeFractions()
     {
-        // resize the storage vector
-        lowDimVolumeInBulkElement_.resize(this->gridView(bulkIdx).size(0));
+        // reset the storage
+        lowDimVolumeInBulkElement_.reset(this->gridView(bulkIdx).size(0), this->gridView(lowDimIdx).size(0));
 
         // compute the low dim volume fractions
         for (const auto& is : intersections(this->glue()))
@@ -788,7 +1129,7 @@ public:
             {
                 const auto& outside = is.outside(outsideIdx);
                 const std::size_t bulkElementIdx = this->problem(bulkIdx).fvGridGeometry().elementMapper().index(outside);
-                lowDimVolumeInBulkElement_[bulkElementIdx] += intersectionGeometry.volume()*M_PI*radius*radius;
+                lowDimVolumeInBulkElement_.add(lowDimElementIdx, bulkElementIdx, intersectionGeometry.volume()*M_PI*radius*radius);
             }
         }
     }
@@ -824,9 +1165,138 @@ public:
     // \}
 
 private:
+    //! places the point sources on the quadrature points of a low dim element
+    void addPointSources_(const Element<lowDimIdx>& lowDimElement, std::size_t order)
+    {
+        const auto& bulkTree = this->problem(bulkIdx).fvGridGeometry().boundingBoxTree();
+        const auto& lowDimProblem = this->problem(lowDimIdx);
+
+        // get the Gaussian quadrature rule for the low dim element
+        const auto lowDimGeometry = lowDimElement.geometry();
+        const auto& quad = Dune::QuadratureRules<Scalar, lowDimDim>::rule(lowDimGeometry.type(), order);
+
+        const auto lowDimElementIdx = lowDimProblem.fvGridGeometry().elementMapper().index(lowDimElement);
+
+        // apply the Gaussian quadrature rule and define point sources at each quadrature point
+        // note that the approximation is not optimal if
+        // (a) the one-dimensional elements are too large,
+        // (b) whenever a one-dimensional element is split between two or more elements,
+        // (c) when gradients of important quantities in the three-dimensional domain are large.
+
+        // iterate over all quadrature points
+        for (auto&& qp : quad)
+        {
+            // global position of the quadrature point
+            const auto globalPos = lowDimGeometry.global(qp.position());
+
+            const auto bulkElementIndices = intersectingEntities(globalPos, bulkTree);
+
+            // do not add a point source if the qp is outside of the 3d grid
+            // this is equivalent to having a source of zero for that qp
+            if (bulkElementIndices.empty())
+                continue;
+
+            ////////////////////////////////////////////////////////////////
+            // get points on the cylinder surface at the integration point
+            ////////////////////////////////////////////////////////////////
+
+            static const auto numIp = getParam<int>("MixedDimension.NumCircleSegments", 25);
+            const auto radius = lowDimProblem.spatialParams().radius(lowDimElementIdx);
+            const auto normal = lowDimGeometry.corner(1)-lowDimGeometry.corner(0);
+            const auto integrationElement = lowDimGeometry.integrationElement(qp.position())*2*M_PI*radius/Scalar(numIp);
+            const auto weight = qp.weight()/(2*M_PI*radius);
+
+            const auto circlePoints = EmbeddedCoupling::circlePoints(globalPos, normal, radius, numIp);
+            for (int k = 0; k < circlePoints.size(); ++k)
+            {
+                const auto& circlePos = circlePoints[k];
+                const auto circleBulkElementIndices = intersectingEntities(circlePos, bulkTree);
+                if (circleBulkElementIndices.empty())
+                    continue;
+
+                // loop over the bulk elements at the integration points (usually one except when it is on a face or edge or vertex)
+                // and add a point source at every point on the circle
+                for (const auto bulkElementIdx : circleBulkElementIndices)
+                {
+                    const auto id = this->idCounter_++;
+                    this->pointSources(bulkIdx).emplace_back(circlePos, id, weight, integrationElement, std::vector<std::size_t>({bulkElementIdx}));
+                    this->pointSources(bulkIdx).back().setEmbeddings(circleBulkElementIndices.size());
+                    this->pointSources(lowDimIdx).emplace_back(globalPos, id, weight, integrationElement, std::vector<std::size_t>({lowDimElementIdx}));
+                    this->pointSources(lowDimIdx).back().setEmbeddings(circleBulkElementIndices.size());
+
+                    // pre compute additional data used for the evaluation of
+                    // the actual solution dependent source term
+                    PointSourceData psData;
+
+                    if (isBox<lowDimIdx>())
+                    {
+                        using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
+                        ShapeValues shapeValues;
+                        this->getShapeValues(lowDimIdx, this->problem(lowDimIdx).fvGridGeometry(), lowDimGeometry, globalPos, shapeValues);
+                        psData.addLowDimInterpolation(shapeValues, this->vertexIndices(lowDimIdx, lowDimElementIdx), lowDimElementIdx);
+                    }
+                    else
+                    {
+                        psData.addLowDimInterpolation(lowDimElementIdx);
+                    }
+
+                    // add data needed to compute integral over the circle
+                    if (isBox<bulkIdx>())
+                    {
+                        using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
+                        const auto bulkGeometry = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx).geometry();
+                        ShapeValues shapeValues;
+                        this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, circlePos, shapeValues);
+                        psData.addBulkInterpolation(shapeValues, this->vertexIndices(bulkIdx, bulkElementIdx), bulkElementIdx);
+                    }
+                    else
+                    {
+                        psData.addBulkInterpolation(bulkElementIdx);
+                    }
+
+                    // publish point source data in the global vector
+                    this->pointSourceData().emplace_back(std::move(psData));
+
+                    // export the lowdim coupling stencil
+                    // we insert all vertices / elements and make it unique later
+                    if (isBox<bulkIdx>())
+                    {
+                        const auto& vertices = this->vertexIndices(bulkIdx, bulkElementIdx);
+                        this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
+                                                                                   vertices.begin(), vertices.end());
+                    }
+                    else
+                    {
+                        this->couplingStencils(lowDimIdx)[lowDimElementIdx].push_back(bulkElementIdx);
+                    }
+
+                    // export the bulk coupling stencil
+                    // we insert all vertices / elements and make it unique later
+                    if (isBox<lowDimIdx>())
+                    {
+                        const auto& vertices = this->vertexIndices(lowDimIdx, lowDimElementIdx);
+                        EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], vertices.begin(), vertices.end(), couplingStencilsGrew_);
+
+                    }
+                    else
+                    {
+                        EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], lowDimElementIdx, couplingStencilsGrew_);
+                    }
+
+                }
+            }
+        }
+    }
 
-    //! vector for the volume fraction of the lowdim domain in the bulk domain cells
-    std::vector<Scalar> lowDimVolumeInBulkElement_;
+
+    //! the volume of the lowdim domain in the bulk domain cells
+    EmbeddedCoupling::LowDimVolumes<Scalar> lowDimVolumeInBulkElement_;
+
+    //! see pointSourcesRenumbered() and couplingStencilsGrew()
+    bool pointSourcesRenumbered_ = true;
+    bool couplingStencilsGrew_ = true;
+    //! the number of point source ids removed since the point sources were computed
+    std::size_t numRemovedIds_ = 0;
 };
 
 
@@ -929,6 +1399,9 @@ public:
         // clear all internal members like pointsource vectors and stencils
         // initializes the point source id counter
         this->clear();
+        pointSourcesRenumbered_ = true;
+        couplingStencilsGrew_ = true;
+        numRemovedIds_ = 0;
         bulkSourceIds_.clear();
         bulkSourceWeights_.clear();
         extendedSourceStencil_.stencil().clear();
@@ -949,112 +1422,23 @@ public:
         this->pointSourceData().reserve(this->glue().size());
         this->averageDistanceToBulkCell().reserve(this->glue().size());
         const Scalar kernelWidth = getParam<Scalar>("MixedDimension.KernelWidth");
+        std::vector<std::size_t> bulkElementIndices;
         for (const auto& is : intersections(this->glue()))
         {
             // all inside elements are identical...
             const auto& inside = is.inside(0);
-            // get the intersection geometry for integrating over it
-            const auto intersectionGeometry = is.geometry();
-
-            // get the Gaussian quadrature rule for the local intersection
-            const auto& quad = Dune::QuadratureRules<Scalar, lowDimDim>::rule(intersectionGeometry.type(), order);
             const std::size_t lowDimElementIdx = lowDimFvGridGeometry.elementMapper().index(inside);
 
-            // iterate over all quadrature points and place a source
-            // for 1d: make a new point source
-            // for 3d: make a new kernel volume source
-            for (auto&& qp : quad)
-            {
-                // compute the coupling stencils
-                for (std::size_t outsideIdx = 0; outsideIdx < is.neighbor(0); ++outsideIdx)
-                {
-                    const auto& outside = is.outside(outsideIdx);
-                    const std::size_t bulkElementIdx = bulkFvGridGeometry.elementMapper().index(outside);
-
-                    // each quadrature point will be a point source for the sub problem
-                    const auto globalPos = intersectionGeometry.global(qp.position());
-                    const auto id = this->idCounter_++;
-                    const auto qpweight = qp.weight();
-                    const auto ie = intersectionGeometry.integrationElement(qp.position());
-                    this->pointSources(lowDimIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({lowDimElementIdx}));
-                    this->pointSources(lowDimIdx).back().setEmbeddings(is.neighbor(0));
-                    computeBulkSource(globalPos, kernelWidth, id, lowDimElementIdx, bulkElementIdx, qpweight*ie/is.neighbor(0));
-
-                    // pre compute additional data used for the evaluation of
-                    // the actual solution dependent source term
-                    PointSourceData psData;
-
-                    if (isBox<lowDimIdx>())
-                    {
-                        using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
-                        const auto lowDimGeometry = this->problem(lowDimIdx).fvGridGeometry().element(lowDimElementIdx).geometry();
-                        ShapeValues shapeValues;
-                        this->getShapeValues(lowDimIdx, this->problem(lowDimIdx).fvGridGeometry(), lowDimGeometry, globalPos, shapeValues);
-                        psData.addLowDimInterpolation(shapeValues, this->vertexIndices(lowDimIdx, lowDimElementIdx), lowDimElementIdx);
-                    }
-                    else
-                    {
-                        psData.addLowDimInterpolation(lowDimElementIdx);
-                    }
-
-                    // add data needed to compute integral over the circle
-                    if (isBox<bulkIdx>())
-                    {
-                        using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
-                        const auto bulkGeometry = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx).geometry();
-                        ShapeValues shapeValues;
-                        this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, globalPos, shapeValues);
-                        psData.addBulkInterpolation(shapeValues, this->vertexIndices(bulkIdx, bulkElementIdx), bulkElementIdx);
-                    }
-                    else
-                    {
-                        psData.addBulkInterpolation(bulkElementIdx);
-                    }
-
-                    // publish point source data in the global vector
-                    this->pointSourceData().emplace_back(std::move(psData));
-
-                    // compute average distance to bulk cell
-                    this->averageDistanceToBulkCell().push_back(this->computeDistance(outside.geometry(), globalPos));
+            bulkElementIndices.clear();
+            for (std::size_t outsideIdx = 0; outsideIdx < is.neighbor(0); ++outsideIdx)
+                bulkElementIndices.push_back(bulkFvGridGeometry.elementMapper().index(is.outside(outsideIdx)));
 
-                    // export the lowdim coupling stencil
-                    // we insert all vertices / elements and make it unique later
-                    if (isBox<bulkIdx>())
-                    {
-                        const auto& vertices = this->vertexIndices(bulkIdx, bulkElementIdx);
-                        this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
-                                                                                   vertices.begin(), vertices.end());
-                    }
-                    else
-                    {
-                        this->couplingStencils(lowDimIdx)[lowDimElementIdx].push_back(bulkElementIdx);
-                    }
-                }
-            }
+            addPointSources_(is.geometry(), lowDimElementIdx, bulkElementIndices, order, kernelWidth);
         }
 
         // make extra stencils unique
         for (auto&& stencil : extendedSourceStencil_.stencil())
-        {
-            std::sort(stencil.second.begin(), stencil.second.end());
-            stencil.second.erase(std::unique(stencil.second.begin(), stencil.second.end()), stencil.second.end());
-
-            // remove the vertices element (box)
-            if (isBox<bulkIdx>())
-            {
-                const auto& indices = this->vertexIndices(bulkIdx, stencil.first);
-                stencil.second.erase(std::remove_if(stencil.second.begin(), stencil.second.end(),
-                                                   [&](auto i){ return std::find(indices.begin(), indices.end(), i) != indices.end(); }),
-                                     stencil.second.end());
-            }
-            // remove the own element (cell-centered)
-            else
-            {
-                stencil.second.erase(std::remove_if(stencil.second.begin(), stencil.second.end(),
-                                                   [&](auto i){ return i == stencil.first; }),
-                                     stencil.second.end());
-            }
-        }
+            makeExtendedStencilUnique_(stencil.first, stencil.second);
 
         // make stencils unique
         using namespace Dune::Hybrid;
@@ -1070,14 +1454,109 @@ public:
         if (!this->pointSources(bulkIdx).empty())
             DUNE_THROW(Dune::InvalidStateException, "Kernel method shouldn't have point sources in the bulk domain but only volume sources!");
 
+        updatedBulkElements_.clear();
         std::cout << "took " << watch.elapsed() << " seconds." << std::endl;
     }
 
+    /*!
+     * \brief Updates the point sources after the low-dimensional grid has grown
+     *
+     * Only the point sources, kernel weights, stencils and volume fractions of the given low-dimensional
+     * elements (e.g. with moved corners) and of all new elements are recomputed,
+     * the new elements are intersected with the bulk grid one by one instead of gluing the grids.
+     * This requires that the indices of the old low-dimensional elements did not change
+     * (new elements are appended as in Dune::FoamGrid growth, GridGrowth::update checks this and reports
+     * all elements as changed otherwise). With fewer elements than before, or if more point sources
+     * were removed than remain, everything is recomputed.
+     * \note The ids of the remaining point sources do not change, the new ones are appended. Unless
+     *       pointSourcesRenumbered(), the point source maps of the sub problems can be updated by id
+     *       (EmbeddedPointSourceProblem::updatePointSourceMap), and the Jacobian pattern has to grow
+     *       only if couplingStencilsGrew().
+     * \note Bulk coupling stencil entries of moved elements are not removed, i.e. the stencils are a superset
+     */
+    void update(const std::vector<std::size_t>& lowDimElementIndices, const SolutionVector& curSol)
+    {
+        this->updateSolution(curSol);
+        const auto order = getParam<int>("MixedDimension.IntegrationOrder", 1);
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        const auto& lowDimFvGridGeometry = this->problem(lowDimIdx).fvGridGeometry();
+        const std::size_t numLowDimElements = this->gridView(lowDimIdx).size(0);
+        if (numLowDimElements < lowDimVolumeInBulkElement_.numLowDimElements()
+            || this->gridView(bulkIdx).size(0) != lowDimVolumeInBulkElement_.numBulkElements()
+            || 2*numRemovedIds_ > this->pointSourceData().size())
+        {
+            computePointSourceData(order);
+            computeLowDimVolumeFractions();
+            return;
+        }
+
+        Dune::Timer watch;
+        const std::size_t numOldLowDimElements = lowDimVolumeInBulkElement_.numLowDimElements();
+        std::vector<bool> isUpdated;
+        const auto updatedElements = EmbeddedCoupling::updatedElements(lowDimElementIndices, numOldLowDimElements,
+                                                                       numLowDimElements, isUpdated);
+        pointSourcesRenumbered_ = false;
+        couplingStencilsGrew_ = numLowDimElements > numOldLowDimElements; // the Jacobian pattern grows with the grid
+
+        // remove the old point sources, their kernel weights, and the low dim stencils of the updated elements (the other ids are kept)
+        const Scalar kernelWidth = getParam<Scalar>("MixedDimension.KernelWidth");
+        this->preComputeVertexIndices(lowDimIdx);
+        if (!updatedElements.empty() && updatedElements.front() < numOldLowDimElements)
+        {
+            const auto removed = EmbeddedCoupling::removePointSources(this->pointSources(bulkIdx), this->pointSources(lowDimIdx),
+                                                                      this->pointSourceData(), isUpdated);
+            removeKernelWeights_(removed, kernelWidth);
+            numRemovedIds_ += removed.size();
+        }
+        const auto oldLowDimStencils = EmbeddedCoupling::eraseStencils(this->couplingStencils(lowDimIdx), updatedElements);
+
+        // add the new point sources
+        updatedBulkElements_.clear();
+        for (const auto lowDimElementIdx : updatedElements)
+        {
+            const auto lowDimGeometry = lowDimFvGridGeometry.element(lowDimElementIdx).geometry();
+            for (const auto& piece : EmbeddedCoupling::segmentIntersections(bulkFvGridGeometry, lowDimGeometry.corner(0), lowDimGeometry.corner(1)))
+            {
+                const Dune::AffineGeometry<Scalar, lowDimDim, dimWorld> geometry(lowDimGeometry.type(), piece.corners);
+                addPointSources_(geometry, lowDimElementIdx, piece.bulkElementIndices, order, kernelWidth);
+            }
+
+            const auto radius = this->problem(lowDimIdx).spatialParams().radius(lowDimElementIdx);
+            EmbeddedCoupling::updateLowDimVolume(lowDimVolumeInBulkElement_, bulkFvGridGeometry, lowDimElementIdx, lowDimGeometry, radius);
+        }
+
+        // make the changed stencils unique
+        std::sort(updatedBulkElements_.begin(), updatedBulkElements_.end());
+        updatedBulkElements_.erase(std::unique(updatedBulkElements_.begin(), updatedBulkElements_.end()), updatedBulkElements_.end());
+        for (const auto bulkElementIdx : updatedBulkElements_)
+        {
+            auto it = extendedSourceStencil_.stencil().find(bulkElementIdx);
+            if (it != extendedSourceStencil_.stencil().end())
+                makeExtendedStencilUnique_(it->first, it->second);
+        }
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(lowDimIdx), updatedElements);
+        EmbeddedCoupling::makeStencilsUnique(this->couplingStencils(bulkIdx), updatedBulkElements_);
+        if (!couplingStencilsGrew_)
+            couplingStencilsGrew_ = EmbeddedCoupling::stencilsGrew(this->couplingStencils(lowDimIdx), oldLowDimStencils, updatedElements);
+        updatedBulkElements_.clear();
+
+        std::cout << "Updated the point sources of " << updatedElements.size() << " elements, took "
+                  << watch.elapsed() << " seconds." << std::endl;
+    }
+
+    //! if the last update recomputed all point sources with new ids, i.e. the point source maps of the sub problems have to be recomputed
+    bool pointSourcesRenumbered() const
+    { return pointSourcesRenumbered_; }
+
+    //! if the last update added low dim elements or coupling stencil entries, i.e. the Jacobian pattern has to grow
+    bool couplingStencilsGrew() const
+    { return couplingStencilsGrew_; }
+
     //! Compute the low dim volume fraction in the bulk domain cells
     void computeLowDimVolumeFractions()
     {
-        // resize the storage vector
-        lowDimVolumeInBulkElement_.resize(this->gridView(bulkIdx).size(0));
+        // reset the storage
+        lowDimVolumeInBulkElement_.reset(this->gridView(bulkIdx).size(0), this->gridView(lowDimIdx).size(0));
 
         // compute the low dim volume fractions
         for (const auto& is : intersections(this->glue()))
@@ -1093,7 +1572,7 @@ public:
             {
                 const auto& outside = is.outside(outsideIdx);
                 const std::size_t bulkElementIdx = this->problem(bulkIdx).fvGridGeometry().elementMapper().index(outside);
-                lowDimVolumeInBulkElement_[bulkElementIdx] += intersectionGeometry.volume()*M_PI*radius*radius;
+                lowDimVolumeInBulkElement_.add(lowDimElementIdx, bulkElementIdx, intersectionGeometry.volume()*M_PI*radius*radius);
             }
         }
     }
@@ -1137,21 +1616,199 @@ public:
     // \}
 
 private:
-    //! TODO: How to optimize this?
+    //! places the point sources on the quadrature points of an intersection of a low dim element with the bulk elements
+    template<class IntersectionGeometry>
+    void addPointSources_(const IntersectionGeometry& intersectionGeometry, std::size_t lowDimElementIdx,
+                          const std::vector<std::size_t>& bulkElementIndices, std::size_t order, Scalar kernelWidth)
+    {
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+
+        // get the Gaussian quadrature rule for the local intersection
+        const auto& quad = Dune::QuadratureRules<Scalar, lowDimDim>::rule(intersectionGeometry.type(), order);
+
+        // iterate over all quadrature points and place a source
+        // for 1d: make a new point source
+        // for 3d: make a new kernel volume source
+        for (auto&& qp : quad)
+        {
+            // compute the coupling stencils
+            for (const auto bulkElementIdx : bulkElementIndices)
+            {
+                // each quadrature point will be a point source for the sub problem
+                const auto globalPos = intersectionGeometry.global(qp.position());
+                const auto id = this->idCounter_++;
+                const auto qpweight = qp.weight();
+                const auto ie = intersectionGeometry.integrationElement(qp.position());
+                this->pointSources(lowDimIdx).emplace_back(globalPos, id, qpweight, ie, std::vector<std::size_t>({lowDimElementIdx}));
+                this->pointSources(lowDimIdx).back().setEmbeddings(bulkElementIndices.size());
+                computeBulkSource(globalPos, kernelWidth, id, lowDimElementIdx, bulkElementIdx, qpweight*ie/bulkElementIndices.size());
+
+                // pre compute additional data used for the evaluation of
+                // the actual solution dependent source term
+                PointSourceData psData;
+
+                if (isBox<lowDimIdx>())
+                {
+                    using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
+                    const auto lowDimGeometry = this->problem(lowDimIdx).fvGridGeometry().element(lowDimElementIdx).geometry();
+                    ShapeValues shapeValues;
+                    this->getShapeValues(lowDimIdx, this->problem(lowDimIdx).fvGridGeometry(), lowDimGeometry, globalPos, shapeValues);
+                    psData.addLowDimInterpolation(shapeValues, this->vertexIndices(lowDimIdx, lowDimElementIdx), lowDimElementIdx);
+                }
+                else
+                {
+                    psData.addLowDimInterpolation(lowDimElementIdx);
+                }
+
+                // add data needed to compute integral over the circle
+                if (isBox<bulkIdx>())
+                {
+                    using ShapeValues = std::vector<Dune::FieldVector<Scalar, 1> >;
+                    const auto bulkGeometry = this->problem(bulkIdx).fvGridGeometry().element(bulkElementIdx).geometry();
+                    ShapeValues shapeValues;
+                    this->getShapeValues(bulkIdx, this->problem(bulkIdx).fvGridGeometry(), bulkGeometry, globalPos, shapeValues);
+                    psData.addBulkInterpolation(shapeValues, this->vertexIndices(bulkIdx, bulkElementIdx), bulkElementIdx);
+                }
+                else
+                {
+                    psData.addBulkInterpolation(bulkElementIdx);
+                }
+
+                // publish point source data in the global vector
+                this->pointSourceData().emplace_back(std::move(psData));
+
+                // compute average distance to bulk cell
+                this->averageDistanceToBulkCell().push_back(this->computeDistance(bulkFvGridGeometry.element(bulkElementIdx).geometry(), globalPos));
+
+                // export the lowdim coupling stencil
+                // we insert all vertices / elements and make it unique later
+                if (isBox<bulkIdx>())
+                {
+                    const auto& vertices = this->vertexIndices(bulkIdx, bulkElementIdx);
+                    this->couplingStencils(lowDimIdx)[lowDimElementIdx].insert(this->couplingStencils(lowDimIdx)[lowDimElementIdx].end(),
+                                                                               vertices.begin(), vertices.end());
+                }
+                else
+                {
+                    this->couplingStencils(lowDimIdx)[lowDimElementIdx].push_back(bulkElementIdx);
+                }
+            }
+        }
+    }
+
+    //! appends dofs to the extended stencil of a bulk element (made unique later), and sets couplingStencilsGrew_ if one of them is new
+    template<class Dofs>
+    void extendExtendedStencil_(std::size_t bulkElementIdx, const Dofs& dofs)
+    {
+        auto& stencil = extendedSourceStencil_.stencil()[bulkElementIdx];
+        for (auto it = dofs.begin(); it != dofs.end() && !couplingStencilsGrew_; ++it)
+            if (!isOwnDof_(bulkElementIdx, *it)) // removed by makeExtendedStencilUnique_
+                couplingStencilsGrew_ = std::find(stencil.begin(), stencil.end(), *it) == stencil.end();
+        stencil.insert(stencil.end(), dofs.begin(), dofs.end());
+    }
+
+    //! if the dof belongs to the bulk element itself (its vertices, or the element)
+    bool isOwnDof_(std::size_t bulkElementIdx, std::size_t dofIdx) const
+    {
+        if (isBox<bulkIdx>())
+        {
+            const auto& indices = this->vertexIndices(bulkIdx, bulkElementIdx);
+            return std::find(indices.begin(), indices.end(), dofIdx) != indices.end();
+        }
+        return dofIdx == bulkElementIdx;
+    }
+
+    //! makes the extended stencil of a bulk element unique and removes the dofs of the element itself
+    void makeExtendedStencilUnique_(std::size_t bulkElementIdx, std::vector<std::size_t>& stencil) const
+    {
+        std::sort(stencil.begin(), stencil.end());
+        stencil.erase(std::unique(stencil.begin(), stencil.end()), stencil.end());
+
+        // remove the vertices element (box)
+        if (isBox<bulkIdx>())
+        {
+            const auto& indices = this->vertexIndices(bulkIdx, bulkElementIdx);
+            stencil.erase(std::remove_if(stencil.begin(), stencil.end(),
+                                         [&](auto i){ return std::find(indices.begin(), indices.end(), i) != indices.end(); }),
+                          stencil.end());
+        }
+        // remove the own element (cell-centered)
+        else
+        {
+            stencil.erase(std::remove_if(stencil.begin(), stencil.end(),
+                                         [&](auto i){ return i == bulkElementIdx; }),
+                          stencil.end());
+        }
+    }
+
+    //! the bulk elements whose bounding boxes intersect the kernel support (candidates_, sorted)
+    void computeSupportCandidates_(const GlobalPosition& globalPos, const Scalar kernelWidth)
+    {
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        const auto& bBoxTree = bulkFvGridGeometry.boundingBoxTree();
+
+        std::array<Scalar, 2*dimWorld> supportBox;
+        for (int i = 0; i < dimWorld; ++i)
+        {
+            supportBox[i] = globalPos[i] - kernelWidth;
+            supportBox[i+dimWorld] = globalPos[i] + kernelWidth;
+        }
+        candidates_.clear();
+        EmbeddedCoupling::boxIntersectingEntities(bBoxTree, bBoxTree.numBoundingBoxes() - 1, supportBox, candidates_);
+        for (auto& candidate : candidates_)
+            candidate = bulkFvGridGeometry.elementMapper().index(bBoxTree.entitySet().entity(candidate));
+        std::sort(candidates_.begin(), candidates_.end()); // same summation order as a loop over all elements
+    }
+
+    //! removes the kernel weights of the removed point sources, only the bulk elements within their support are visited
+    template<class PointSources>
+    void removeKernelWeights_(const PointSources& removed, const Scalar kernelWidth)
+    {
+        for (const auto& source : removed)
+        {
+            computeSupportCandidates_(source.position(), kernelWidth);
+            for (const auto bulkElementIdx : candidates_)
+            {
+                auto& ids = bulkSourceIds_[bulkElementIdx];
+                auto& weights = bulkSourceWeights_[bulkElementIdx];
+                std::size_t k = 0;
+                for (std::size_t j = 0; j < ids.size(); ++j)
+                {
+                    if (ids[j] == source.id())
+                        continue;
+                    ids[k] = ids[j];
+                    weights[k] = weights[j];
+                    ++k;
+                }
+                ids.resize(k);
+                weights.resize(k);
+            }
+        }
+    }
+
+    /*!
+     * \brief Computes the kernel source weights of one point source in the bulk domain
+     *
+     * Only the bulk elements within the support of the kernel are visited, they are
+     * found by descending the bulk bounding box tree with the bounding box of the kernel support.
+     */
     void computeBulkSource(const GlobalPosition& globalPos, const Scalar kernelWidth,
                            std::size_t id, std::size_t lowDimElementIdx, std::size_t coupledBulkElementIdx,
                            Scalar pointSourceWeight)
     {
+        const auto& bulkFvGridGeometry = this->problem(bulkIdx).fvGridGeometry();
+        computeSupportCandidates_(globalPos, kernelWidth);
+
         // make sure it is mass conservative
         // i.e. the point source in the 1d domain needs to have the exact same integral as the distributed
         // kernel source integral in the 3d domain. Correct the integration formula by balancing the error
         // by scaling the kernel with the checksum inverse
         Scalar checkSum = 0.0;
-        std::vector<bool> mask(this->gridView(bulkIdx).size(0), false);
-        for (const auto& element : elements(this->gridView(bulkIdx)))
+        touched_.clear();
+        for (const auto bulkElementIdx : candidates_)
         {
             Scalar weight = 0.0;
-            const auto geometry = element.geometry();
+            const auto geometry = bulkFvGridGeometry.element(bulkElementIdx).geometry();
             const auto& quad = Dune::QuadratureRules<Scalar, bulkDim>::rule(geometry.type(), 3);
             for (auto&& qp : quad)
             {
@@ -1162,34 +1819,34 @@ private:
 
             if (weight > 1e-13)
             {
-                const auto bulkElementIdx = this->problem(bulkIdx).fvGridGeometry().elementMapper().index(element);
                 bulkSourceIds_[bulkElementIdx].push_back(id);
                 bulkSourceWeights_[bulkElementIdx].push_back(weight*pointSourceWeight);
-                mask[bulkElementIdx] = true;
+                touched_.push_back(bulkElementIdx);
 
                 // add lowDim dofs that the source is related to to the bulk stencil
                 if (isBox<lowDimIdx>())
                 {
                     const auto& vertices = this->vertexIndices(lowDimIdx, lowDimElementIdx);
-                    this->couplingStencils(bulkIdx)[bulkElementIdx].insert(this->couplingStencils(bulkIdx)[bulkElementIdx].end(),
-                                                                           vertices.begin(), vertices.end());
+                    EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], vertices.begin(), vertices.end(), couplingStencilsGrew_);
 
                 }
                 else
                 {
-                    this->couplingStencils(bulkIdx)[bulkElementIdx].push_back(lowDimElementIdx);
+                    EmbeddedCoupling::extendStencil(this->couplingStencils(bulkIdx)[bulkElementIdx], lowDimElementIdx, couplingStencilsGrew_);
                 }
 
                 // tpfa
-                extendedSourceStencil_.stencil()[bulkElementIdx].push_back(coupledBulkElementIdx);
+                extendExtendedStencil_(bulkElementIdx, std::array<std::size_t, 1>{{coupledBulkElementIdx}});
 
                 // compute check sum -> should sum up to 1.0 to be mass conservative
                 checkSum += weight;
             }
         }
 
-        for (std::size_t eIdx = 0; eIdx < bulkSourceWeights_.size(); ++eIdx)
-            if (mask[eIdx]) bulkSourceWeights_[eIdx].back() /= checkSum;
+        // sparse normalization, only the elements within the support got a new weight
+        for (const auto eIdx : touched_)
+            bulkSourceWeights_[eIdx].back() /= checkSum;
+        updatedBulkElements_.insert(updatedBulkElements_.end(), touched_.begin(), touched_.end());
 
         // balance error of the quadrature rule -> TODO: what to do at boundaries
         // const auto diff = 1.0 - checkSum;
@@ -1219,12 +1876,23 @@ private:
 
     //! the extended source stencil object for kernel coupling
     EmbeddedCoupling::ExtendedSourceStencil<ThisType> extendedSourceStencil_;
-    //! vector for the volume fraction of the lowdim domain in the bulk domain cells
-    std::vector<Scalar> lowDimVolumeInBulkElement_;
+    //! the volume of the lowdim domain in the bulk domain cells
+    EmbeddedCoupling::LowDimVolumes<Scalar> lowDimVolumeInBulkElement_;
+
+    //! see pointSourcesRenumbered() and couplingStencilsGrew()
+    bool pointSourcesRenumbered_ = true;
+    bool couplingStencilsGrew_ = true;
+    //! the number of point source ids removed since the point sources were computed
+    std::size_t numRemovedIds_ = 0;
     //! kernel sources to integrate for each bulk element
     std::vector<std::vector<std::size_t>> bulkSourceIds_;
     //! the integral of the kernel for each point source / integration point, i.e. weight for the source
     std::vector<std::vector<Scalar>> bulkSourceWeights_;
+    //! scratch: bulk elements within the kernel support bounding box, and elements with non-zero weight
+    std::vector<std::size_t> candidates_;
+    std::vector<std::size_t> touched_;
+    //! bulk elements that got new kernel sources during an update
+    std::vector<std::size_t> updatedBulkElements_;
 };
 
 } // end namespace Dumux
@@ -0,0 +1,166 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup EmbeddedCoupling
+ * \brief Base class of the sub problems of the embedded (root soil) coupling,
+ *        whose point source map is updated after growth instead of being rebuilt
+ */
+#ifndef DUMUX_MULTIDOMAIN_EMBEDDED_POINTSOURCE_PROBLEM_HH
+#define DUMUX_MULTIDOMAIN_EMBEDDED_POINTSOURCE_PROBLEM_HH
+
+#include <atomic>
+#include <vector>
+
+#include <dumux/common/properties.hh>
+#include <dumux/discretization/method.hh>
+#include <dumux/porousmediumflow/problem.hh>
+#include <dumux/multidomain/embedded/pointsourceupdate.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup EmbeddedCoupling
+ * \brief A PorousMediumFlowProblem, whose point sources (given by the coupling manager in addPointSources)
+ *        are kept in an EmbeddedCoupling::PointSourceMap
+ *
+ * computePointSourceMap() maps all point sources, updatePointSourceMap() only the changes after
+ * EmbeddedCouplingManager1d3d::update (see there). For the box method, both rebuild the map of FVProblem.
+ * The numeric differentiation evaluates the sources of an element many times, so the last map lookup
+ * is cached per thread (e.g. the threads of ParallelMultiDomainFVAssembler).
+ * \note The methods hide the ones of FVProblem, the assembly calls them on the actual problem type.
+ */
+template<class TypeTag>
+class EmbeddedPointSourceProblem : public PorousMediumFlowProblem<TypeTag>
+{
+    using ParentType = PorousMediumFlowProblem<TypeTag>;
+    using Implementation = GetPropType<TypeTag, Properties::Problem>;
+    using PointSource = GetPropType<TypeTag, Properties::PointSource>;
+    using NumEqVector = GetPropType<TypeTag, Properties::NumEqVector>;
+    using FVGridGeometry = GetPropType<TypeTag, Properties::FVGridGeometry>;
+    using FVElementGeometry = typename FVGridGeometry::LocalView;
+    using SubControlVolume = typename FVGridGeometry::SubControlVolume;
+    using Element = typename FVGridGeometry::GridView::template Codim<0>::Entity;
+    using PointSourceMap = EmbeddedCoupling::PointSourceMap<PointSource>;
+
+    static constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
+
+public:
+    using ParentType::ParentType;
+
+    //! maps all point sources
+    void computePointSourceMap()
+    {
+        if (isBox)
+            ParentType::computePointSourceMap();
+        else
+        {
+            std::vector<PointSource> sources;
+            asImp_().addPointSources(sources);
+            pointSourceMap_.compute(sources);
+            mapVersion_ = ++lastMapVersion_;
+        }
+    }
+
+    //! erases the removed point sources, and adds the new ones (the ids of the others must not have changed)
+    void updatePointSourceMap()
+    {
+        if (isBox)
+            ParentType::computePointSourceMap();
+        else
+        {
+            std::vector<PointSource> sources;
+            asImp_().addPointSources(sources);
+            pointSourceMap_.update(sources);
+            mapVersion_ = ++lastMapVersion_;
+        }
+    }
+
+    //! the point sources per (element, scv)
+    const typename PointSourceMap::Map& getPointSourceMap() const
+    { return isBox ? ParentType::getPointSourceMap() : pointSourceMap_.map(); }
+
+    /*!
+     * \brief The point sources of a sub control volume divided by its volume, as FVProblem::scvPointSources
+     */
+    template<class ElementVolumeVariables>
+    NumEqVector scvPointSources(const Element& element,
+                                const FVElementGeometry& fvGeometry,
+                                const ElementVolumeVariables& elemVolVars,
+                                const SubControlVolume& scv) const
+    {
+        if (isBox)
+            return ParentType::scvPointSources(element, fvGeometry, elemVolVars, scv);
+
+        NumEqVector source(0.0);
+        const auto* sources = pointSources_(this->fvGridGeometry().elementMapper().index(element), scv.indexInElement());
+        if (!sources)
+            return source;
+
+        // the user specifies absolute values in kg/s, the local residual multiplies with the volume again
+        const auto volume = scv.volume()*elemVolVars[scv].extrusionFactor();
+        for (const auto& ps : *sources)
+        {
+            auto pointSource = ps; // a copy, the values are set by the problem
+            pointSource.update(asImp_(), element, fvGeometry, elemVolVars, scv);
+            asImp_().pointSource(pointSource, element, fvGeometry, elemVolVars, scv);
+            pointSource /= volume*pointSource.embeddings();
+            source += pointSource.values();
+        }
+        return source;
+    }
+
+private:
+    //! the point sources of (element, scv) or nullptr, the last lookup of the calling thread is reused
+    const std::vector<PointSource>* pointSources_(std::size_t eIdx, std::size_t scvIdx) const
+    {
+        struct Lookup
+        {
+            std::size_t mapVersion = 0; // unique over all problems, 0 is never used
+            typename PointSourceMap::Key key;
+            const std::vector<PointSource>* sources = nullptr;
+        };
+        static thread_local Lookup last;
+
+        const auto key = std::make_pair(eIdx, scvIdx);
+        if (last.mapVersion != mapVersion_ || last.key != key)
+        {
+            const auto& map = pointSourceMap_.map();
+            const auto it = map.find(key);
+            last.mapVersion = mapVersion_;
+            last.key = key;
+            last.sources = it == map.end() ? nullptr : &it->second;
+        }
+        return last.sources;
+    }
+
+    const Implementation& asImp_() const
+    { return *static_cast<const Implementation*>(this); }
+
+    PointSourceMap pointSourceMap_;
+    std::size_t mapVersion_ = 0;
+    static std::atomic<std::size_t> lastMapVersion_;
+};
+
+template<class TypeTag>
+std::atomic<std::size_t> EmbeddedPointSourceProblem<TypeTag>::lastMapVersion_{0};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,471 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup EmbeddedCoupling
+ * \brief Helpers for the local (incremental) update of the point sources of
+ *        EmbeddedCouplingManager1d3d after the low-dimensional grid has grown
+ */
+#ifndef DUMUX_MULTIDOMAIN_EMBEDDED_POINTSOURCE_UPDATE_HH
+#define DUMUX_MULTIDOMAIN_EMBEDDED_POINTSOURCE_UPDATE_HH
+
+#include <cmath>
+#include <array>
+#include <iterator>
+#include <map>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+
+#include <dune/geometry/referenceelements.hh>
+
+namespace Dumux {
+namespace EmbeddedCoupling {
+
+/*!
+ * \brief Collects the entity indices (of the tree's entity set) of all leafs of a
+ *        bounding box tree, whose bounding boxes intersect the axis aligned box
+ *
+ * \param box   the box, first the minimal, then the maximal coordinates
+ */
+template<class BoundingBoxTree, class ctype, std::size_t n>
+void boxIntersectingEntities(const BoundingBoxTree& tree, std::size_t nodeIdx,
+                          const std::array<ctype, n>& box, std::vector<std::size_t>& entities)
+{
+    constexpr int dimWorld = n/2;
+    const auto& node = tree.getBoundingBoxNode(nodeIdx);
+    const auto* b = tree.getBoundingBoxCoordinates(nodeIdx);
+    for (int i = 0; i < dimWorld; ++i)
+        if (b[i] > box[i+dimWorld] || b[i+dimWorld] < box[i])
+            return;
+
+    if (tree.isLeaf(node, nodeIdx))
+        entities.push_back(node.child1);
+    else
+    {
+        boxIntersectingEntities(tree, node.child0, box, entities);
+        boxIntersectingEntities(tree, node.child1, box, entities);
+    }
+}
+
+//! Collects the entity indices of all leafs whose bounding boxes intersect the box, starting at the root node
+template<class BoundingBoxTree, class ctype, std::size_t n>
+std::vector<std::size_t> boxIntersectingEntities(const BoundingBoxTree& tree, const std::array<ctype, n>& box)
+{
+    std::vector<std::size_t> entities;
+    boxIntersectingEntities(tree, tree.numBoundingBoxes() - 1, box, entities);
+    return entities;
+}
+
+/*!
+ * \brief A part of a segment that lies within one or more bulk elements
+ *        (more than one, if it lies on a face or edge), equivalent to an intersection of the glue
+ */
+template<class GlobalPosition>
+struct SegmentIntersection
+{
+    std::vector<GlobalPosition> corners;
+    std::vector<std::size_t> bulkElementIndices;
+};
+
+/*!
+ * \brief Clips the segment [a, b] against a convex bulk element (Cyrus-Beck)
+ *
+ * \return false, if the segment does not intersect the element in more than a point
+ */
+template<class Geometry, class GlobalPosition>
+bool clipSegment(const Geometry& geometry, const GlobalPosition& a, const GlobalPosition& b,
+                 GlobalPosition& c0, GlobalPosition& c1)
+{
+    using ctype = typename Geometry::ctype;
+    constexpr int dim = Geometry::mydimension;
+    static_assert(dim == 3, "clipSegment is implemented for three-dimensional bulk elements");
+
+    const auto refElement = Dune::ReferenceElements<ctype, dim>::general(geometry.type());
+    const auto center = geometry.center();
+    const auto d = b - a;
+    ctype tMin = 0.0, tMax = 1.0;
+    for (int f = 0; f < refElement.size(1); ++f)
+    {
+        // face plane from three of its corners, normal pointing outwards
+        std::array<GlobalPosition, 3> p;
+        for (int k = 0; k < 3; ++k)
+            p[k] = geometry.corner(refElement.subEntity(f, 1, k, dim));
+        const auto u = p[1] - p[0];
+        const auto v = p[2] - p[0];
+        GlobalPosition normal({u[1]*v[2] - u[2]*v[1], u[2]*v[0] - u[0]*v[2], u[0]*v[1] - u[1]*v[0]});
+        if (normal*(center - p[0]) > 0.0)
+            normal *= -1.0;
+
+        const auto num = normal*(p[0] - a);
+        const auto den = normal*d;
+        if (std::abs(den) < std::numeric_limits<ctype>::epsilon()*normal.two_norm()*d.two_norm())
+        {
+            if (num < 0.0) // parallel and outside
+                return false;
+            continue;
+        }
+        const auto t = num/den;
+        if (den < 0.0) // entering
+            tMin = std::max(tMin, t);
+        else // leaving
+            tMax = std::min(tMax, t);
+        if (tMin >= tMax)
+            return false;
+    }
+
+    c0 = a; c0.axpy(tMin, d);
+    c1 = a; c1.axpy(tMax, d);
+    return tMax - tMin > 1e-10;
+}
+
+/*!
+ * \brief Intersects a single segment [a, b] with the bulk grid
+ *
+ * The candidate bulk elements are found by the bulk bounding box tree, pieces that
+ * coincide (segment on a face or edge) are merged, as in the grid glue.
+ */
+template<class BulkFVGridGeometry, class GlobalPosition>
+std::vector<SegmentIntersection<GlobalPosition>> segmentIntersections(const BulkFVGridGeometry& bulkFvGridGeometry,
+                                                                      const GlobalPosition& a, const GlobalPosition& b)
+{
+    using ctype = typename GlobalPosition::value_type;
+    constexpr int dimWorld = GlobalPosition::dimension;
+
+    const auto& tree = bulkFvGridGeometry.boundingBoxTree();
+    std::array<ctype, 2*dimWorld> box;
+    for (int i = 0; i < dimWorld; ++i)
+    {
+        box[i] = std::min(a[i], b[i]);
+        box[i+dimWorld] = std::max(a[i], b[i]);
+    }
+
+    const ctype eps = 1e-8*(b - a).two_norm();
+    std::vector<SegmentIntersection<GlobalPosition>> pieces;
+    for (const auto entityIdx : boxIntersectingEntities(tree, box))
+    {
+        const auto& element = tree.entitySet().entity(entityIdx);
+        GlobalPosition c0, c1;
+        if (!clipSegment(element.geometry(), a, b, c0, c1))
+            continue;
+
+        const auto bulkElementIdx = bulkFvGridGeometry.elementMapper().index(element);
+        auto it = std::find_if(pieces.begin(), pieces.end(), [&](const auto& piece)
+                               { return (piece.corners[0] - c0).two_norm() < eps && (piece.corners[1] - c1).two_norm() < eps; });
+        if (it != pieces.end())
+            it->bulkElementIndices.push_back(bulkElementIdx);
+        else
+            pieces.push_back({ {c0, c1}, {bulkElementIdx} });
+    }
+
+    // same order of the neighbors as a loop over the bulk elements
+    for (auto& piece : pieces)
+        std::sort(piece.bulkElementIndices.begin(), piece.bulkElementIndices.end());
+    return pieces;
+}
+
+/*!
+ * \brief The volume the low-dimensional domain occupies in each bulk element, together with
+ *        the contributions of every low-dimensional element, such that they can be replaced
+ */
+template<class Scalar>
+class LowDimVolumes
+{
+public:
+    //! set all volumes to zero
+    void reset(std::size_t numBulkElements, std::size_t numLowDimElements)
+    {
+        volume_.assign(numBulkElements, 0.0);
+        contributions_.assign(numLowDimElements, {});
+    }
+
+    //! the number of low-dimensional elements known
+    std::size_t numLowDimElements() const
+    { return contributions_.size(); }
+
+    //! the number of bulk elements known
+    std::size_t numBulkElements() const
+    { return volume_.size(); }
+
+    //! add the volume of a low-dimensional element (or a part of it) in a bulk element
+    void add(std::size_t lowDimElementIdx, std::size_t bulkElementIdx, Scalar volume)
+    {
+        if (lowDimElementIdx >= contributions_.size())
+            contributions_.resize(lowDimElementIdx + 1);
+        volume_[bulkElementIdx] += volume;
+        contributions_[lowDimElementIdx].emplace_back(bulkElementIdx, volume);
+    }
+
+    //! remove all volumes of a low-dimensional element
+    void remove(std::size_t lowDimElementIdx)
+    {
+        if (lowDimElementIdx >= contributions_.size())
+        {
+            contributions_.resize(lowDimElementIdx + 1);
+            return;
+        }
+        for (const auto& c : contributions_[lowDimElementIdx])
+            volume_[c.first] = std::max(volume_[c.first] - c.second, Scalar(0.0));
+        contributions_[lowDimElementIdx].clear();
+    }
+
+    //! the volume of the low-dimensional domain in a bulk element
+    Scalar operator[](std::size_t bulkElementIdx) const
+    { return volume_[bulkElementIdx]; }
+
+private:
+    std::vector<Scalar> volume_;
+    std::vector<std::vector<std::pair<std::size_t, Scalar>>> contributions_;
+};
+
+/*!
+ * \brief Replaces the volume of a low-dimensional (segment) element in the bulk elements,
+ *        assuming a radial tube
+ */
+template<class Scalar, class BulkFVGridGeometry, class LowDimGeometry>
+void updateLowDimVolume(LowDimVolumes<Scalar>& volumes, const BulkFVGridGeometry& bulkFvGridGeometry,
+                        std::size_t lowDimElementIdx, const LowDimGeometry& lowDimGeometry, Scalar radius)
+{
+    volumes.remove(lowDimElementIdx);
+    for (const auto& piece : segmentIntersections(bulkFvGridGeometry, lowDimGeometry.corner(0), lowDimGeometry.corner(1)))
+    {
+        const auto volume = (piece.corners[1] - piece.corners[0]).two_norm()*M_PI*radius*radius;
+        for (const auto bulkElementIdx : piece.bulkElementIndices)
+            volumes.add(lowDimElementIdx, bulkElementIdx, volume);
+    }
+}
+
+/*!
+ * \brief The low-dimensional elements whose point sources have to be updated:
+ *        the given elements and all elements that were added since the last update
+ *
+ * \param isUpdated     is set to mark the updated elements
+ */
+inline std::vector<std::size_t> updatedElements(const std::vector<std::size_t>& lowDimElementIndices,
+                                                std::size_t numOldElements, std::size_t numElements,
+                                                std::vector<bool>& isUpdated)
+{
+    isUpdated.assign(numElements, false);
+    for (const auto lowDimElementIdx : lowDimElementIndices)
+        isUpdated[lowDimElementIdx] = true;
+    for (std::size_t lowDimElementIdx = numOldElements; lowDimElementIdx < numElements; ++lowDimElementIdx)
+        isUpdated[lowDimElementIdx] = true;
+
+    std::vector<std::size_t> updated;
+    for (std::size_t lowDimElementIdx = 0; lowDimElementIdx < numElements; ++lowDimElementIdx)
+        if (isUpdated[lowDimElementIdx])
+            updated.push_back(lowDimElementIdx);
+    return updated;
+}
+
+/*!
+ * \brief Removes all point sources belonging to the marked low-dimensional elements,
+ *        the ids of the remaining ones do not change
+ *
+ * \param isRemoved         marks the low-dimensional element indices, whose sources are removed
+ * \return                  the removed low-dimensional point sources
+ *
+ * The point source data of the removed ids stays in place (unused), the new point sources are appended
+ * with new ids, such that the point source maps of the sub problems can be updated by id (see PointSourceMap).
+ * The bulk point source vector is either empty (kernel coupling), or holds the
+ * same ids as the low-dimensional one.
+ */
+template<class PointSources, class PointSourceData>
+PointSources removePointSources(PointSources& bulkPointSources, PointSources& lowDimPointSources,
+                                const std::vector<PointSourceData>& pointSourceData,
+                                const std::vector<bool>& isRemoved)
+{
+    auto removed = [&](const auto& source)
+    {
+        const auto lowDimElementIdx = pointSourceData[source.id()].lowDimElementIdx();
+        return lowDimElementIdx < isRemoved.size() && isRemoved[lowDimElementIdx];
+    };
+
+    PointSources removedSources;
+    std::copy_if(lowDimPointSources.begin(), lowDimPointSources.end(), std::back_inserter(removedSources), removed);
+    bulkPointSources.erase(std::remove_if(bulkPointSources.begin(), bulkPointSources.end(), removed), bulkPointSources.end());
+    lowDimPointSources.erase(std::remove_if(lowDimPointSources.begin(), lowDimPointSources.end(), removed), lowDimPointSources.end());
+    return removedSources;
+}
+
+/*!
+ * \brief Appends entries to a coupling stencil (made unique later), and sets grew if one of them is new
+ *
+ * After growth the Jacobian pattern has to grow only if a stencil got a new entry. The look up
+ * is skipped once grew is set (e.g. for new low-dimensional elements, or the full computation).
+ */
+template<class Stencil, class Iterator>
+void extendStencil(Stencil& stencil, Iterator first, Iterator last, bool& grew)
+{
+    for (auto it = first; it != last && !grew; ++it)
+        grew = std::find(stencil.begin(), stencil.end(), *it) == stencil.end();
+    stencil.insert(stencil.end(), first, last);
+}
+
+//! appends one entry to a coupling stencil, and sets grew if it is new
+template<class Stencil>
+void extendStencil(Stencil& stencil, std::size_t entry, bool& grew)
+{
+    if (!grew)
+        grew = std::find(stencil.begin(), stencil.end(), entry) == stencil.end();
+    stencil.push_back(entry);
+}
+
+/*!
+ * \brief Erases the stencils of the given keys, and returns them
+ */
+template<class Stencils, class Keys>
+Stencils eraseStencils(Stencils& stencils, const Keys& keys)
+{
+    Stencils erased;
+    for (const auto key : keys)
+    {
+        auto it = stencils.find(key);
+        if (it == stencils.end())
+            continue;
+        erased.emplace(key, std::move(it->second));
+        stencils.erase(it);
+    }
+    return erased;
+}
+
+/*!
+ * \brief If a (sorted and unique) stencil of the given keys has an entry the erased stencil did not have
+ */
+template<class Stencils, class Keys>
+bool stencilsGrew(const Stencils& stencils, const Stencils& erased, const Keys& keys)
+{
+    for (const auto key : keys)
+    {
+        auto it = stencils.find(key);
+        if (it == stencils.end())
+            continue;
+        auto old = erased.find(key);
+        if (old == erased.end() || !std::includes(old->second.begin(), old->second.end(), it->second.begin(), it->second.end()))
+            return true;
+    }
+    return false;
+}
+
+/*!
+ * \brief Sorts and makes the stencils of the given keys unique
+ */
+template<class Stencils, class Keys>
+void makeStencilsUnique(Stencils& stencils, const Keys& keys)
+{
+    for (const auto key : keys)
+    {
+        auto it = stencils.find(key);
+        if (it == stencils.end())
+            continue;
+        auto& stencil = it->second;
+        std::sort(stencil.begin(), stencil.end());
+        stencil.erase(std::unique(stencil.begin(), stencil.end()), stencil.end());
+    }
+}
+
+/*!
+ * \brief The point sources of a cell-centered sub problem per element, updated by id after growth
+ *
+ * The same map as FVProblem::computePointSourceMap, but the point sources are located by their element
+ * index (set by the coupling manager) instead of searching the bounding box tree. As the coupling manager
+ * keeps the ids of the remaining point sources and appends the new ones with new ids (see removePointSources),
+ * update() only erases the sources whose ids are gone, and adds those with ids not seen before.
+ */
+template<class PointSource>
+class PointSourceMap
+{
+    static constexpr std::size_t noElement = std::numeric_limits<std::size_t>::max();
+public:
+    //! (element index, scv index), as for FVProblem::getPointSourceMap
+    using Key = std::pair<std::size_t, std::size_t>;
+    using Map = std::map<Key, std::vector<PointSource>>;
+
+    //! maps all point sources (the ids are new)
+    void compute(const std::vector<PointSource>& sources)
+    {
+        map_.clear();
+        elementOfId_.clear();
+        update(sources);
+    }
+
+    //! erases the sources whose ids are not given anymore, and adds those with new ids
+    void update(const std::vector<PointSource>& sources)
+    {
+        const std::size_t numOldIds = elementOfId_.size();
+        std::vector<bool> isGiven(numOldIds, false);
+        for (const auto& source : sources)
+        {
+            const std::size_t id = source.id();
+            if (id < numOldIds)
+            {
+                isGiven[id] = true;
+                continue;
+            }
+            // split the source values equally among all concerned elements, as IntegrationPointSourceHelper
+            const auto& elementIndices = source.elementIndices();
+            for (const auto eIdx : elementIndices)
+            {
+                auto& elementSources = map_[Key(eIdx, 0)];
+                elementSources.push_back(source);
+                elementSources.back().setEmbeddings(source.embeddings()*elementIndices.size());
+            }
+            if (id >= elementOfId_.size())
+                elementOfId_.resize(id + 1, noElement);
+            elementOfId_[id] = elementIndices[0];
+        }
+
+        for (std::size_t id = 0; id < numOldIds; ++id)
+        {
+            if (isGiven[id] || elementOfId_[id] == noElement)
+                continue;
+            const auto& first = map_.at(Key(elementOfId_[id], 0));
+            const auto elementIndices = std::find_if(first.begin(), first.end(), [id](const auto& s){ return s.id() == id; })->elementIndices();
+            for (const auto eIdx : elementIndices)
+                erase_(eIdx, id);
+            elementOfId_[id] = noElement;
+        }
+    }
+
+    const Map& map() const
+    { return map_; }
+
+private:
+    void erase_(std::size_t eIdx, std::size_t id)
+    {
+        auto it = map_.find(Key(eIdx, 0));
+        auto& elementSources = it->second;
+        elementSources.erase(std::remove_if(elementSources.begin(), elementSources.end(),
+                                            [id](const auto& s){ return s.id() == id; }), elementSources.end());
+        if (elementSources.empty())
+            map_.erase(it);
+    }
+
+    Map map_;
+    std::vector<std::size_t> elementOfId_; //!< the element of each mapped id (noElement if removed)
+};
+
+template<class PointSource>
+constexpr std::size_t PointSourceMap<PointSource>::noElement;
+
+} // end namespace EmbeddedCoupling
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,381 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup MultiDomain
+ * \ingroup Assembly
+ * \brief A multidomain assembler assembling the Jacobian and the residual with several threads
+ *        (shared memory), using a coloring of the elements of each sub domain
+ */
+#ifndef DUMUX_MULTIDOMAIN_PARALLEL_FV_ASSEMBLER_HH
+#define DUMUX_MULTIDOMAIN_PARALLEL_FV_ASSEMBLER_HH
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/hybridutilities.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/threadpool.hh>
+#include <dumux/discretization/method.hh>
+#include <dumux/multidomain/fvassembler.hh>
+#include <dumux/multidomain/subdomaincclocalassembler.hh>
+#include <dumux/multidomain/subdomainboxlocalassembler.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup MultiDomain
+ * \ingroup Assembly
+ * \brief MultiDomainFVAssembler, which assembles the Jacobian and the residual in parallel
+ *
+ * The elements of each sub domain are colored, such that two elements of the same color never
+ *  - write the same Jacobian entry or residual entry,
+ *  - perturb a solution value (of any domain), that the other one reads or perturbs.
+ *
+ * Two elements get different colors, if their Jacobian rows (of any block, including the coupling blocks)
+ * share a column, or if they share a degree of freedom. This covers the numeric differentiation with respect
+ * to the coupled degrees of freedom, which perturbs the solution stored in the coupling manager (e.g.
+ * EmbeddedCouplingManager1d3d, including its extended source stencils). The elements of one color are then
+ * assembled in parallel without locks, the colors one after another.
+ *
+ * Each element is assembled by its own local assembler (the local assemblers of dumux bind their element
+ * in the constructor), i.e. the local views (geometry, volume variables) are thread local. The point sources are
+ * looked up through a cache per thread (see EmbeddedPointSourceProblem). Grid wide caches of volume variables
+ * and flux variables must therefore be disabled. Coupling managers that bind a per element coupling context
+ * are not supported.
+ *
+ * The number of threads is given by the parameter Assembly.NumThreads (default 1, 0 uses all hardware threads).
+ * With a single thread the sequential assembly of MultiDomainFVAssembler is used.
+ * The coloring is recomputed, if the number of elements or the Jacobian pattern changed (it keeps a hash of the
+ * pattern), i.e. after setLinearSystem(), setJacobianPattern(), or grid adaption, called on any type.
+ * The thread scaling is measured by the rosi_perf benchmark coupled_c12 (speedup of threads4 over serial).
+ *
+ * \note setPreviousSolution() hides the one of MultiDomainFVAssembler, because the parallel assembly checks
+ *       that it was called. Use the assembler as this type (as the Newton solver and the drivers do),
+ *       not through a reference to MultiDomainFVAssembler.
+ */
+template<class MDTraits, class CMType, DiffMethod diffMethod, bool useImplicitAssembly = true>
+class ParallelMultiDomainFVAssembler : public MultiDomainFVAssembler<MDTraits, CMType, diffMethod, useImplicitAssembly>
+{
+    using ParentType = MultiDomainFVAssembler<MDTraits, CMType, diffMethod, useImplicitAssembly>;
+
+    template<std::size_t id>
+    using SubDomainTypeTag = typename MDTraits::template SubDomain<id>::TypeTag;
+
+    static constexpr std::size_t numSubDomains = MDTraits::numSubDomains;
+
+public:
+    using typename ParentType::SolutionVector;
+    using typename ParentType::JacobianMatrix;
+    using typename ParentType::CouplingManager;
+
+    template<std::size_t id>
+    using GridVariables = typename MDTraits::template SubDomain<id>::GridVariables;
+
+    template<std::size_t id>
+    using FVGridGeometry = typename MDTraits::template SubDomain<id>::FVGridGeometry;
+
+    template<std::size_t id>
+    using Problem = typename MDTraits::template SubDomain<id>::Problem;
+
+private:
+    using ProblemTuple = typename MDTraits::template TupleOfSharedPtrConst<Problem>;
+    using FVGridGeometryTuple = typename MDTraits::template TupleOfSharedPtrConst<FVGridGeometry>;
+    using GridVariablesTuple = typename MDTraits::template TupleOfSharedPtr<GridVariables>;
+    using TimeLoop = TimeLoopBase<typename MDTraits::Scalar>;
+
+    template<DiscretizationMethod discMethod, std::size_t id>
+    struct SubDomainAssemblerType;
+
+    template<std::size_t id>
+    struct SubDomainAssemblerType<DiscretizationMethod::cctpfa, id>
+    { using type = SubDomainCCLocalAssembler<id, SubDomainTypeTag<id>, ParentType, diffMethod, ParentType::isImplicit()>; };
+
+    template<std::size_t id>
+    struct SubDomainAssemblerType<DiscretizationMethod::ccmpfa, id>
+    { using type = SubDomainCCLocalAssembler<id, SubDomainTypeTag<id>, ParentType, diffMethod, ParentType::isImplicit()>; };
+
+    template<std::size_t id>
+    struct SubDomainAssemblerType<DiscretizationMethod::box, id>
+    { using type = SubDomainBoxLocalAssembler<id, SubDomainTypeTag<id>, ParentType, diffMethod, ParentType::isImplicit()>; };
+
+    template<std::size_t id>
+    using SubDomainAssembler = typename SubDomainAssemblerType<FVGridGeometry<id>::discMethod, id>::type;
+
+public:
+
+    /*!
+     * \brief The constructor for stationary problems
+     */
+    ParallelMultiDomainFVAssembler(ProblemTuple&& problem,
+                                   FVGridGeometryTuple&& fvGridGeometry,
+                                   GridVariablesTuple&& gridVariables,
+                                   std::shared_ptr<CouplingManager> couplingManager)
+    : ParentType(std::move(problem), std::move(fvGridGeometry), GridVariablesTuple(gridVariables), couplingManager)
+    , gridVariablesTuple_(std::move(gridVariables))
+    , couplingManager_(couplingManager)
+    { init_(); }
+
+    /*!
+     * \brief The constructor for instationary problems
+     */
+    ParallelMultiDomainFVAssembler(ProblemTuple&& problem,
+                                   FVGridGeometryTuple&& fvGridGeometry,
+                                   GridVariablesTuple&& gridVariables,
+                                   std::shared_ptr<CouplingManager> couplingManager,
+                                   std::shared_ptr<const TimeLoop> timeLoop)
+    : ParentType(std::move(problem), std::move(fvGridGeometry), GridVariablesTuple(gridVariables), couplingManager, timeLoop)
+    , gridVariablesTuple_(std::move(gridVariables))
+    , couplingManager_(couplingManager)
+    { init_(); }
+
+    /*!
+     * \brief Assembles the global Jacobian of the residual and the residual for the current solution,
+     *        the elements of one color in parallel
+     */
+    void assembleJacobianAndResidual(const SolutionVector& curSol)
+    {
+        if (threadPool_->size() == 1)
+        {
+            ParentType::assembleJacobianAndResidual(curSol);
+            return;
+        }
+
+        checkAssemblerState_();
+        resetJacobian_();
+        resetResidual_();
+
+        if (!colorsValid_())
+            computeColors_();
+
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::Hybrid::size(this->jacobian())), [&](const auto domainId)
+        {
+            this->assembleJacobianAndResidual_(domainId, curSol);
+        });
+    }
+
+    //! Sets the solution from which to start the time integration (hides the one of MultiDomainFVAssembler)
+    void setPreviousSolution(const SolutionVector& u)
+    {
+        ParentType::setPreviousSolution(u);
+        hasPrevSol_ = true;
+    }
+
+    //! The number of threads used for assembly
+    int numThreads() const
+    { return threadPool_->size(); }
+
+    //! The number of colors of sub domain i (valid after the first parallel assembly)
+    template<std::size_t i>
+    std::size_t numColors(Dune::index_constant<i> domainId) const
+    { return colors_[i].size(); }
+
+private:
+
+    void init_()
+    {
+        threadPool_ = std::make_unique<ThreadPool>(getParam<int>("Assembly.NumThreads", 1));
+        chunkSize_ = std::max(getParam<int>("Assembly.ChunkSize", 32), 1);
+
+        if (threadPool_->size() > 1)
+        {
+            using namespace Dune::Hybrid;
+            forEach(std::make_index_sequence<numSubDomains>{}, [&](auto domainId)
+            {
+                using GV = GridVariables<decltype(domainId)::value>;
+                if (GV::GridVolumeVariables::cachingEnabled || GV::GridFluxVariablesCache::cachingEnabled)
+                    DUNE_THROW(Dune::NotImplemented, "Parallel assembly with grid wide volume variables or flux variables caches");
+            });
+        }
+    }
+
+    // the checks and resets of MultiDomainFVAssembler::assembleJacobianAndResidual
+    // (the parent's helpers are private in dumux 3.0)
+    void checkAssemblerState_() const
+    {
+        if (!this->isStationaryProblem() && !hasPrevSol_)
+            DUNE_THROW(Dune::InvalidStateException, "Assembling instationary problem but previous solution was not set!");
+    }
+
+    void resetJacobian_()
+    { this->jacobian() = 0.0; }
+
+    void resetResidual_()
+    {
+        this->setResidualSize(this->residual());
+        this->residual() = 0.0;
+    }
+
+    //! assembles the elements of sub domain i, color by color
+    template<std::size_t i>
+    void assembleJacobianAndResidual_(Dune::index_constant<i> domainId, const SolutionVector& curSol)
+    {
+        auto& jacRow = this->jacobian()[domainId];
+        auto& subRes = this->residual()[domainId];
+        const auto& fvGridGeometry = this->fvGridGeometry(domainId);
+
+        for (const auto& color : colors_[i])
+        {
+            const int numChunks = (color.size() + chunkSize_ - 1)/chunkSize_;
+            threadPool_->parallelFor(numChunks, [&](int chunk)
+            {
+                const std::size_t end = std::min(color.size(), std::size_t(chunk + 1)*chunkSize_);
+                for (std::size_t k = std::size_t(chunk)*chunkSize_; k < end; ++k)
+                {
+                    const auto element = fvGridGeometry.element(color[k]);
+                    SubDomainAssembler<i> subDomainAssembler(*this, element, curSol, *couplingManager_);
+                    subDomainAssembler.assembleJacobianAndResidual(jacRow, subRes, gridVariablesTuple_);
+                }
+            });
+        }
+    }
+
+    //! true if the coloring is up to date, i.e. the number of elements and the Jacobian pattern did not change
+    bool colorsValid_() const
+    {
+        bool valid = true;
+        using namespace Dune::Hybrid;
+        forEach(std::make_index_sequence<numSubDomains>{}, [&](auto domainId)
+        {
+            valid = valid && colored_[domainId] && patternHash_[domainId] == computePatternHash_(domainId);
+        });
+        return valid;
+    }
+
+    //! hash of the number of elements and of the pattern of the Jacobian rows of sub domain i, O(nonzeros)
+    template<std::size_t i>
+    std::uint64_t computePatternHash_(Dune::index_constant<i> domainId) const
+    {
+        std::uint64_t hash = this->fvGridGeometry(domainId).gridView().size(0);
+        auto combine = [&hash](std::uint64_t v) { hash ^= v + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+        using namespace Dune::Hybrid;
+        forEach(std::make_index_sequence<numSubDomains>{}, [&](auto domainJ)
+        {
+            const auto& block = this->jacobian()[domainId][domainJ];
+            combine(block.N());
+            combine(block.M());
+            for (auto row = block.begin(); row != block.end(); ++row)
+            {
+                combine(row.index());
+                for (auto col = row->begin(); col != row->end(); ++col)
+                    combine(col.index());
+            }
+        });
+        return hash;
+    }
+
+    //! greedy coloring of the elements of each sub domain
+    void computeColors_()
+    {
+        using namespace Dune::Hybrid;
+        forEach(std::make_index_sequence<numSubDomains>{}, [&](auto domainId)
+        {
+            this->computeColors_(domainId);
+        });
+    }
+
+    template<std::size_t i>
+    void computeColors_(Dune::index_constant<i> domainId)
+    {
+        const auto& fvGridGeometry = this->fvGridGeometry(domainId);
+        const auto& gridView = fvGridGeometry.gridView();
+        static constexpr int dim = std::decay_t<decltype(gridView)>::dimension;
+
+        // offsets of the columns of block (i, j) in a common numbering
+        std::array<std::size_t, numSubDomains + 1> offset;
+        offset[0] = 0;
+        using namespace Dune::Hybrid;
+        forEach(std::make_index_sequence<numSubDomains>{}, [&](auto domainJ)
+        {
+            offset[domainJ + 1] = offset[domainJ] + this->jacobian()[domainId][domainJ].M();
+        });
+
+        // colors of the elements, which touched a column so far
+        std::vector<std::vector<int>> columnColors(offset[numSubDomains]);
+        std::vector<std::size_t> forbidden; // element index (+1) that marked the color as forbidden last
+        std::vector<std::size_t> dofs, columns;
+
+        colors_[i].clear();
+        for (const auto& element : elements(gridView))
+        {
+            const auto eIdx = fvGridGeometry.elementMapper().index(element);
+
+            dofs.clear();
+            if (FVGridGeometry<i>::discMethod == DiscretizationMethod::box)
+                for (unsigned int v = 0; v < element.subEntities(dim); ++v)
+                    dofs.push_back(fvGridGeometry.vertexMapper().subIndex(element, v, dim));
+            else
+                dofs.push_back(eIdx);
+
+            columns.clear();
+            for (auto dof : dofs)
+                columns.push_back(offset[i] + dof);
+            forEach(std::make_index_sequence<numSubDomains>{}, [&](auto domainJ)
+            {
+                const auto& block = this->jacobian()[domainId][domainJ];
+                for (auto dof : dofs)
+                    for (auto col = block[dof].begin(); col != block[dof].end(); ++col)
+                        columns.push_back(offset[domainJ] + col.index());
+            });
+            std::sort(columns.begin(), columns.end());
+            columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+            for (auto c : columns)
+                for (int color : columnColors[c])
+                    forbidden[color] = eIdx + 1;
+
+            std::size_t color = 0;
+            while (color < forbidden.size() && forbidden[color] == eIdx + 1)
+                ++color;
+            if (color == forbidden.size())
+            {
+                forbidden.push_back(0);
+                colors_[i].emplace_back();
+            }
+
+            colors_[i][color].push_back(eIdx);
+            for (auto c : columns)
+                columnColors[c].push_back(color);
+        }
+        patternHash_[i] = computePatternHash_(domainId);
+        colored_[i] = true;
+    }
+
+    GridVariablesTuple gridVariablesTuple_;
+    std::shared_ptr<CouplingManager> couplingManager_;
+
+    std::unique_ptr<ThreadPool> threadPool_;
+    std::size_t chunkSize_ = 32;
+
+    std::array<std::vector<std::vector<std::size_t>>, numSubDomains> colors_; // element indices of each color
+    std::array<std::uint64_t, numSubDomains> patternHash_; // of the colored pattern
+    std::array<bool, numSubDomains> colored_ = {};
+    bool hasPrevSol_ = false;
+};
+
+} // end namespace Dumux
+
+#endif
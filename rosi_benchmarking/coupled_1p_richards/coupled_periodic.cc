@@ -34,6 +34,8 @@
 
 // Dumux
 #include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh> // DUMUX_PROFILE_ZONE, ProfiledCoupling
+#include <dumux/common/profiledsolvers.hh>
 #include <dumux/common/valgrind.hh>
 #include <dumux/common/dumuxmessage.hh>
 #include <dumux/common/defaultusagemessage.hh>
@@ -41,7 +43,7 @@
 #include <dumux/nonlinear/newtonsolver.hh>
 #include <dumux/common/timeloop.hh>
 #include <dumux/assembly/fvassembler.hh>
-#include <dumux/io/vtkoutputmodule.hh>
+#include <dumux/io/asyncvtkoutputmodule.hh> // Vtk.AsynchronousOutput
 
 #include <dumux/periodic/tpfa/periodicnetworkgridmanager.hh>
 #include <dumux/periodic/tpfa/fvgridgeometry.hh>
@@ -49,6 +51,7 @@
 
 #include <dumux/multidomain/traits.hh>
 #include <dumux/multidomain/fvassembler.hh>
+#include <dumux/multidomain/parallelfvassembler.hh>
 #include <dumux/multidomain/newtonsolver.hh>
 
 // growth model
@@ -272,9 +275,8 @@ int main(int argc, char** argv) try
     oldSol = sol;
 
     // coupling manager
-    couplingManager->init(soilProblem, rootProblem, sol);
-    soilProblem->computePointSourceMap();
-    rootProblem->computePointSourceMap();
+    ProfiledCoupling<CouplingManager, SoilProblem, RootProblem> coupling(couplingManager, soilProblem, rootProblem);
+    coupling.init(sol); // coupling maps and point sources
 
     // the grid variables
     using SoilGridVariables = GetPropType<SoilTypeTag, Properties::GridVariables>;
@@ -289,10 +291,12 @@ int main(int argc, char** argv) try
 
     // get some time loop parameters & instantiate time loop
     bool grow = false;
+    bool incrementalCoupling = false;
     const auto tEnd = getParam<double>("TimeLoop.TEnd");
     std::shared_ptr<CheckPointTimeLoop<double>> timeLoop;
     if (tEnd > 0) { // dynamic problem
         grow = getParam<bool>("RootSystem.Grid.Grow", false); // use grid growth
+        incrementalCoupling = getParam<bool>("MixedDimension.IncrementalUpdate", false); // update the coupling maps locally after growth
         auto initialDt = getParam<double>("TimeLoop.DtInitial"); // initial time step
         timeLoop = std::make_shared<CheckPointTimeLoop<double>>(restartTime, initialDt, tEnd);
         timeLoop->setMaxTimeStepSize(getParam<double>("TimeLoop.MaxTimeStepSize"));
@@ -312,12 +316,12 @@ int main(int argc, char** argv) try
 
     // intialize the vtk output module
     using SoilSolution = std::decay_t<decltype(sol[soilDomainIdx])>;
-    VtkOutputModule<SoilGridVariables, SoilSolution> soilVtkWriter(*soilGridVariables, sol[soilDomainIdx], soilProblem->name());
+    AsyncVtkOutputModule<SoilGridVariables, SoilSolution> soilVtkWriter(*soilGridVariables, sol[soilDomainIdx], soilProblem->name());
     GetPropType<SoilTypeTag, Properties::VtkOutputFields>::initOutputModule(soilVtkWriter);
     soilVtkWriter.write(restartTime);
 
     using RootSolution = std::decay_t<decltype(sol[rootDomainIdx])>;
-    VtkOutputModule<RootGridVariables, RootSolution> rootVtkWriter(*rootGridVariables, sol[rootDomainIdx], rootProblem->name());
+    AsyncVtkOutputModule<RootGridVariables, RootSolution> rootVtkWriter(*rootGridVariables, sol[rootDomainIdx], rootProblem->name());
     GetPropType<RootTypeTag, Properties::VtkOutputFields>::initOutputModule(rootVtkWriter);
 
     rootProblem->userData("pSoil", sol[rootDomainIdx]);
@@ -343,7 +347,7 @@ int main(int argc, char** argv) try
     rootVtkWriter.write(restartTime);
 
     // the assembler with time loop for instationary problem
-    using Assembler = MultiDomainFVAssembler<Traits, CouplingManager, DiffMethod::numeric>;
+    using Assembler = ProfiledAssembler<ParallelMultiDomainFVAssembler<Traits, CouplingManager, DiffMethod::numeric>>; // Assembly.NumThreads
     std::shared_ptr<Assembler> assembler;
     if (tEnd > 0) {
         assembler = std::make_shared<Assembler>(std::make_tuple(soilProblem, rootProblem),
@@ -358,7 +362,7 @@ int main(int argc, char** argv) try
     }
 
     // the linear solver
-    using LinearSolver = BlockDiagILU0BiCGSTABSolver;
+    using LinearSolver = ProfiledLinearSolver<BlockDiagILU0BiCGSTABSolver>;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
@@ -394,15 +398,8 @@ int main(int argc, char** argv) try
                         rootProblem->applyInitialSolution(sol[rootDomainIdx]);
                         rootGridVariables->updateAfterGridAdaption(sol[rootDomainIdx]); // update the secondary variables
 
-                        couplingManager->updateAfterGridAdaption(soilGridGeometry, rootGridGeometry);
-                        couplingManager->init(soilProblem, rootProblem, sol); // recompute coupling maps
-                        couplingManager->updateSolution(sol); // update the solution vector for the coupling manager
-
-                        soilProblem->computePointSourceMap(); // recompute the coupling sources
-                        rootProblem->computePointSourceMap(); // recompute the coupling sources
-
-                        assembler->setJacobianPattern(assembler->jacobian()); // resize and set Jacobian pattern
-                        assembler->setResidualSize(assembler->residual()); // resize residual vector
+                        coupling.updateAfterGrowth(soilGridGeometry, rootGridGeometry, // coupling maps, point sources, and matrix pattern
+                                                   incrementalCoupling ? &gridGrowth->changedElements() : nullptr, sol, *assembler);
 
                         oldSol[rootDomainIdx] = sol[rootDomainIdx]; // // update old solution to new grid
 
@@ -414,7 +411,10 @@ int main(int argc, char** argv) try
             // set previous solution for storage evaluations
             assembler->setPreviousSolution(oldSol);
 
-            nonLinearSolver.solve(sol, *timeLoop);
+            {
+                DUMUX_PROFILE_ZONE("newton solve");
+                nonLinearSolver.solve(sol, *timeLoop);
+            }
 
             soilControl(*soilGridGeometry, *soilGridVariables, sol[soilDomainIdx], oldSol[soilDomainIdx], t, dt); //debugging soil water content
 
@@ -429,6 +429,7 @@ int main(int argc, char** argv) try
             timeLoop->advanceTimeStep(); // advance to the time loop to the next step
 
             if ((timeLoop->isCheckPoint()) || (timeLoop->finished())) { // write vtk output (only at check points)
+                DUMUX_PROFILE_ZONE("output");
                 if (grow) { // prepare static fields also
                     rootProblem->userData("radius", sol[rootDomainIdx]);
                     rootProblem->userData("order", sol[rootDomainIdx]);
@@ -460,7 +461,10 @@ int main(int argc, char** argv) try
         std::cout << "a static model \n\n" << std::flush;
 
         assembler->setPreviousSolution(oldSol); // set previous solution for storage evaluations
-        nonLinearSolver.solve(sol); // solve the non-linear system
+        {
+            DUMUX_PROFILE_ZONE("newton solve");
+            nonLinearSolver.solve(sol); // solve the non-linear system
+        }
 
         // write outputs
         rootProblem->userData("p", sol[rootDomainIdx]);
@@ -481,11 +485,16 @@ int main(int argc, char** argv) try
     // finalize, print dumux message to say goodbye
     ////////////////////////////////////////////////////////////-ro
 
+    soilVtkWriter.finish(); // wait for the pending output
+    rootVtkWriter.finish();
+
     // print dumux end message
     if (mpiHelper.rank() == 0) {
         Parameters::print();
     }
 
+    Profiler::instance().write(rootProblem->name(), mpiHelper.getCollectiveCommunication()); // only with DUMUX_PROFILING
+
     return 0;
 } // end main
 catch (Dumux::ParameterException &e) {
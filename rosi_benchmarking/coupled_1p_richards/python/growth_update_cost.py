@@ -0,0 +1,54 @@
+''' Measures the cost of the update after each growth step of the coupled problem (coupled):
+    incremental update of the coupling maps (MixedDimension.IncrementalUpdate = true) versus the full recomputation
+
+    usage: python3 growth_update_cost.py [--build-dir DIR] [--input NAME]
+
+    The input needs a growing root system (RootSystem.Grid.Grow = true in its root input, as small_rb).
+    Each run writes one row per growth step to the file MixedDimension.UpdateCostFile:
+    time, segments, new segments, changed segments, coupling [s], total [s].
+    Prints the mean cost per step, and linear fits of the coupling time against the number of new segments
+    and against the number of segments (the incremental update should only depend on the first) '''
+
+import argparse
+import os
+import subprocess
+
+import numpy as np
+
+path = os.path.dirname(os.path.realpath(__file__))
+parser = argparse.ArgumentParser()
+parser.add_argument("--build-dir", default = os.path.join(path, "..", "..", "..", "build-cmake", "rosi_benchmarking"),
+                    help = "the rosi_benchmarking folder of the build directory (as for rosi_perf.py)")
+parser.add_argument("--input", default = "small_rb", help = "input file in input/ (without .input)")
+args = parser.parse_args()
+
+# go to the right place
+os.chdir(os.path.join(os.path.abspath(args.build_dir), "coupled_1p_richards"))
+if not os.path.exists("coupled"):
+    raise FileNotFoundError("growth_update_cost.py: {} is not built (make coupled)".format(os.path.abspath("coupled")))
+
+results = {}  # incremental -> rows of the update cost file
+for incremental in ["false", "true"]:
+    name = args.input + "_update_cost_" + ("incremental" if incremental == "true" else "full")
+    subprocess.run(["./coupled", "input/" + args.input + ".input", "-Problem.Name", name,
+                    "-MixedDimension.IncrementalUpdate", incremental, "-MixedDimension.UpdateCostFile", name + ".csv"],
+                   stdout = subprocess.DEVNULL, check = True)
+    rows = np.loadtxt(name + ".csv", delimiter = ',', ndmin = 2)
+    if rows.shape[0] == 0:
+        raise ValueError("growth_update_cost.py: {}.csv is empty, does the root system grow?".format(name))
+    results[incremental] = rows
+
+print("\n{:>12} {:>7} {:>10} {:>14} {:>14} {:>16} {:>16}".format(
+    "update", "steps", "segments", "coupling [ms]", "total [ms]", "[ms] per new seg.", "[ms] per segment"))
+for incremental, rows in results.items():
+    segments, new, coupling, total = rows[:, 1], rows[:, 2], 1.e3 * rows[:, 4], 1.e3 * rows[:, 5]
+    # coupling time = a + b * new segments, and = a + c * segments
+    b = np.polyfit(new, coupling, 1)[0] if np.ptp(new) > 0 else float("nan")
+    c = np.polyfit(segments, coupling, 1)[0] if np.ptp(segments) > 0 else float("nan")
+    print("{:>12} {:>7} {:>10} {:>14.3f} {:>14.3f} {:>16.4f} {:>16.4f}".format(
+        "incremental" if incremental == "true" else "full", rows.shape[0], int(segments[-1]),
+        np.mean(coupling), np.mean(total), b, c))
+
+full, incremental = results["false"], results["true"]
+print("\nincremental update relative to the full recomputation: coupling {:.2f}, total {:.2f}".format(
+    np.sum(incremental[:, 4]) / np.sum(full[:, 4]), np.sum(incremental[:, 5]) / np.sum(full[:, 5])))
@@ -0,0 +1,62 @@
+''' Compares the linear solvers of the coupled problem:
+    block diagonal ILU0 (coupled, BlockDiagILU0BiCGSTABSolver) versus
+    root-soil Schur complement with AMG and tree elimination (coupled_schur, RootSoilSchurBiCGSTABSolver)
+
+    usage: python3 linear_solvers.py [--build-dir DIR] [--cells "NX NY NZ" ...] [--input NAME]
+
+    Prints the linear solver statistics of both executables per soil resolution,
+    and the iterations and times of the Schur complement solver relative to the block diagonal ILU0 '''
+
+import argparse
+import os
+import re
+import subprocess
+import time
+
+path = os.path.dirname(os.path.realpath(__file__))
+parser = argparse.ArgumentParser()
+parser.add_argument("--build-dir", default = os.path.join(path, "..", "..", "..", "build-cmake", "rosi_benchmarking"),
+                    help = "the rosi_benchmarking folder of the build directory (as for rosi_perf.py)")
+parser.add_argument("--cells", nargs = "+", default = ["8 8 15", "16 16 30", "32 32 60"], help = "soil resolutions")
+parser.add_argument("--input", default = "benchmarkC12", help = "input file in input/ (without .input)")
+args = parser.parse_args()
+
+# go to the right place
+os.chdir(os.path.join(os.path.abspath(args.build_dir), "coupled_1p_richards"))
+
+solvers = [("coupled", "BlockDiagILU0BiCGSTABSolver"), ("coupled_schur", "RootSoilSchurBiCGSTABSolver")]
+statistics = re.compile(r"Linear solver statistics \(.*\): (\d+) solves, (\d+) failed, (\d+) iterations \((\S+) per solve\), (\S+) s")
+
+results = {}  # (cells, exe) -> (wall time, solves, failed, iterations, iterations per solve, linear solver time)
+for cells in args.cells:
+    for exe, _ in solvers:
+        if not os.path.exists(exe):
+            raise FileNotFoundError("linear_solvers.py: {} is not built (make {})".format(os.path.abspath(exe), exe))
+        t = time.time()
+        out = subprocess.run(["./" + exe, "input/" + args.input + ".input", "-Soil.Grid.Cells", cells,
+                              "-Problem.Name", args.input + "_" + exe], stdout = subprocess.PIPE, universal_newlines = True).stdout
+        t = time.time() - t
+        stats = statistics.findall(out)
+        if stats:
+            s = stats[-1]
+            results[(cells, exe)] = (t, int(s[0]), int(s[1]), int(s[2]), float(s[3]), float(s[4]))
+        else:
+            results[(cells, exe)] = None
+            print("cells {}: {} gave no statistics (failed?)".format(cells, exe))
+
+print("\n{:>9}  {:>28}  {:>7} {:>7} {:>10} {:>10} {:>12} {:>12}".format(
+    "cells", "linear solver", "solves", "failed", "iterations", "per solve", "solver [s]", "wall [s]"))
+for cells in args.cells:
+    for exe, name in solvers:
+        r = results[(cells, exe)]
+        if r:
+            print("{:>9}  {:>28}  {:>7} {:>7} {:>10} {:>10.1f} {:>12.2f} {:>12.2f}".format(cells, name, r[1], r[2], r[3], r[4], r[5], r[0]))
+
+print("\nRootSoilSchurBiCGSTABSolver relative to BlockDiagILU0BiCGSTABSolver")
+print("{:>9}  {:>16} {:>12} {:>12}".format("cells", "iter. per solve", "solver time", "wall time"))
+for cells in args.cells:
+    ilu, schur = results[(cells, solvers[0][0])], results[(cells, solvers[1][0])]
+    if ilu and schur and ilu[4] > 0 and ilu[5] > 0:
+        print("{:>9}  {:>16.2f} {:>12.2f} {:>12.2f}".format(cells, schur[4] / ilu[4], schur[5] / ilu[5], schur[0] / ilu[0]))
+    else:
+        print("{:>9}  {:>16}".format(cells, "n/a"))
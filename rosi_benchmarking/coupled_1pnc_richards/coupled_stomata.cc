@@ -8,7 +8,9 @@
 #include <config.h>
 
 #include <ctime>
+#include <cstdint>
 #include <iostream>
+#include <random>
 
 // Dune
 #include <dune/common/parallel/mpihelper.hh>
@@ -20,6 +22,8 @@
 
 // Dumux
 #include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh> // DUMUX_PROFILE_ZONE, ProfiledCoupling
+#include <dumux/common/profiledsolvers.hh>
 #include <dumux/common/valgrind.hh>
 #include <dumux/common/dumuxmessage.hh>
 #include <dumux/common/defaultusagemessage.hh>
@@ -27,15 +31,17 @@
 #include <dumux/nonlinear/newtonsolver.hh>
 #include <dumux/common/timeloop.hh>
 #include <dumux/assembly/fvassembler.hh>
-#include <dumux/io/vtkoutputmodule.hh>
+#include <dumux/io/asyncvtkoutputmodule.hh> // Vtk.AsynchronousOutput
 #include <dumux/io/grid/gridmanager.hh>
 
 #include <dumux/periodic/tpfa/periodicnetworkgridmanager.hh>
 #include <dumux/periodic/tpfa/fvgridgeometry.hh>
 #include <dumux/io/loadsolution.hh> // functions to resume a simulation
+#include <dumux/io/binarycheckpoint.hh> // checkpoints to resume a simulation
 
 #include <dumux/multidomain/traits.hh>
 #include <dumux/multidomain/fvassembler.hh>
+#include <dumux/multidomain/parallelfvassembler.hh>
 #include <dumux/multidomain/newtonsolver.hh>
 
 // growth model
@@ -46,6 +52,7 @@
 #include <dumux/growth/growthinterface.hh>
 #include <dumux/growth/cplantboxadapter.hh>
 #include <dumux/growth/gridgrowth.hh>
+#include <dumux/growth/batchedgrowth.hh>
 
 #include "../roots_1pnc/rootsproblem_stomata.hh" // Stomata model
 #include "../soil_richards/richardsproblem.hh" // Richards model in soil
@@ -123,6 +130,13 @@ int main(int argc, char** argv) try
     auto soilGridGeometry = std::make_shared<SoilFVGridGeometry>(soilGridView);
     soilGridGeometry->update();
 
+    // restart from a checkpoint, or write checkpoints (at the check points of the time loop)
+    std::shared_ptr<BinaryCheckpointReader> checkpoint;
+    if (hasParam("Restart.Checkpoint")) {
+        checkpoint = std::make_shared<BinaryCheckpointReader>(checkpointFileName(getParam<std::string>("Restart.Checkpoint"), mpiHelper.rank()));
+    }
+    const bool writeCheckpoints = getParam<bool>("Restart.WriteCheckpoints", false);
+
     // root gridmanager and grid
     using GlobalPosition = Dune::FieldVector<double, 3>;
     using Grid = Dune::FoamGrid<1, 3>;
@@ -130,6 +144,8 @@ int main(int argc, char** argv) try
     GridManager<Grid> rootGridManager; // only for dgf
     std::shared_ptr<CPlantBox::RootSystem> rootSystem; // only for rootbox
     GrowthModule::GrowthInterface<GlobalPosition>* growth = nullptr; // in case of RootBox (or in future PlantBox)
+    GrowthModule::BatchedGrowth<GlobalPosition>* batchedGrowth = nullptr; // wraps growth, to replay the growth steps of a checkpoint
+    unsigned int seed = 0; // of the growth model, if checkpoints are used
     if (simtype==Properties::dgf) { // for a static dgf grid
         std::cout << "\nSimulation type is dgf \n\n" << std::flush;
         rootGridManager.init("RootSystem");
@@ -142,6 +158,10 @@ int main(int argc, char** argv) try
         // rootSystem->setGeometry(new CPlantBox::SDF_HalfPlane(CPlantBox::Vector3d(0.,0.,0.5), CPlantBox::Vector3d(0.,0.,1.))); // care, collar needs to be top, make sure plant seed is located below -1 cm
         const auto size = soilGridGeometry->bBoxMax() - soilGridGeometry->bBoxMin();
         rootSystem->setGeometry(new CPlantBox::SDF_PlantBox(size[0]*100, size[1]*100, size[2]*100));
+        if (checkpoint || writeCheckpoints) { // the root system of a checkpoint is reproduced from the seed and the growth steps
+            seed = checkpoint ? checkpoint->read<unsigned int>("RootSystem.seed") : getParam<unsigned int>("RootSystem.Grid.Seed", std::random_device()());
+            rootSystem->setSeed(seed);
+        }
         rootSystem->initialize();
         double shootZ = getParam<double>("RootSystem.Grid.ShootZ", 0.); // root system initial time
         rootGrid = GrowthModule::RootSystemGridFactory::makeGrid(*rootSystem, shootZ, true); // in dumux/growth/rootsystemgridfactory.hh
@@ -149,6 +169,10 @@ int main(int argc, char** argv) try
         //    auto soilLookup = SoilLookUpBBoxTree<GrowthModule::Grid> (soilGridView, soilGridGeoemtry->boundingBoxTree(), saturation);
         //    rootSystem->setSoil(&soilLookup);
         growth = new GrowthModule::CPlantBoxAdapter<GlobalPosition>(rootSystem);
+        if (checkpoint) { // modify the grid once for all replayed growth steps
+            batchedGrowth = new GrowthModule::BatchedGrowth<GlobalPosition>(growth);
+            growth = batchedGrowth;
+        }
     }
 
     // root grid geometry
@@ -179,7 +203,7 @@ int main(int argc, char** argv) try
     rootProblem->setCouplingManager(&(*couplingManager));
 
     // check if we are about to restart a previously interrupted simulation
-    double restartTime = getParam<double>("Restart.Time", 0);
+    double restartTime = checkpoint ? checkpoint->read<double>("TimeLoop.time") : getParam<double>("Restart.Time", 0);
 
     // the solution vector
     Traits::SolutionVector sol;
@@ -196,7 +220,23 @@ int main(int argc, char** argv) try
         gridGrowth = new GrowthModule::GridGrowth<RootTypeTag>(rootGrid, rootGridGeometry, growth, sol[rootDomainIdx]); // in growth/gridgrowth.hh
         std::cout << "...grid grower initialized \n" << std::flush;
         initialTime = getParam<double>("RootSystem.Grid.InitialT")*24*3600;
-        gridGrowth->grow(initialTime);
+        if (checkpoint) { // repeat the growth steps of the checkpoint, and modify the grid once
+            for (double growthDt : checkpoint->readVector<double>("GridGrowth.steps")) {
+                gridGrowth->simulate(growthDt);
+            }
+            gridGrowth->update();
+            // the growth steps are replayed, the root system must be the one of the checkpoint
+            const std::size_t numSegments = rootGrid->leafGridView().size(0), numNodes = rootGrid->leafGridView().size(Grid::dimension);
+            const auto chkSegments = checkpoint->read<std::uint64_t>("RootSystem.numSegments");
+            const auto chkNodes = checkpoint->read<std::uint64_t>("RootSystem.numNodes");
+            if (chkSegments != numSegments || chkNodes != numNodes) {
+                DUNE_THROW(Dune::IOError, "The replayed root growth does not reproduce the root system of the checkpoint: "
+                    << numSegments << " segments and " << numNodes << " nodes, the checkpoint has "
+                    << chkSegments << " segments and " << chkNodes << " nodes (different root parameters or CPlantBox version?)");
+            }
+        } else {
+            gridGrowth->grow(initialTime);
+        }
         std::cout << "\ninitial growth performed... \n" << std::flush;
     }
 
@@ -205,12 +245,31 @@ int main(int argc, char** argv) try
         rootProblem->spatialParams().initParameters(*rootGridManager.getGridData());
     } else if (simtype==Properties::rootbox){
         rootProblem->spatialParams().updateParameters(*growth);
+        if (batchedGrowth) {
+            batchedGrowth->clear();
+        }
     }
 
     // the solution vector
     sol[soilDomainIdx].resize(soilGridGeometry->numDofs());
     sol[rootDomainIdx].resize(rootGridGeometry->numDofs());
-    if (restartTime > 0)
+    if (checkpoint)
+    {
+        auto soilSol = sol[soilDomainIdx];
+        auto rootSol = sol[rootDomainIdx]; // in the order of the growth model segments
+        checkpoint->readBlockVector("Soil.solution", soilSol);
+        checkpoint->readBlockVector("Root.solution", rootSol);
+        if (soilSol.size() != sol[soilDomainIdx].size() || rootSol.size() != sol[rootDomainIdx].size()) {
+            DUNE_THROW(Dune::IOError, "Checkpoint does not match the grids: " << soilSol.size() << " soil and "
+                << rootSol.size() << " root dofs");
+        }
+        sol[soilDomainIdx] = soilSol;
+        for (size_t i = 0; i < rootSol.size(); i++) {
+            sol[rootDomainIdx][growth ? growth->map2dune(i) : i] = rootSol[i];
+        }
+        rootProblem->readCheckpoint(*checkpoint); // hormone masses and rates
+    }
+    else if (restartTime > 0)
     {
         // soil
         using soilIOFields = GetPropType<SoilTypeTag, Properties::IOFields>;
@@ -240,9 +299,8 @@ int main(int argc, char** argv) try
 
 
     // coupling manager
-    couplingManager->init(soilProblem, rootProblem, sol);
-    soilProblem->computePointSourceMap();
-    rootProblem->computePointSourceMap();
+    ProfiledCoupling<CouplingManager, SoilProblem, RootProblem> coupling(couplingManager, soilProblem, rootProblem);
+    coupling.init(sol); // coupling maps and point sources
 
     // the grid variables
     using SoilGridVariables = GetPropType<SoilTypeTag, Properties::GridVariables>;
@@ -257,10 +315,12 @@ int main(int argc, char** argv) try
 
     // get some time loop parameters & instantiate time loop
     bool grow = false;
+    bool incrementalCoupling = false;
     const auto tEnd = getParam<double>("TimeLoop.TEnd");
     std::shared_ptr<CheckPointTimeLoop<double>> timeLoop;
     if (tEnd > 0) { // dynamic problem
         grow = getParam<bool>("RootSystem.Grid.Grow", false); // use grid growth
+        incrementalCoupling = getParam<bool>("MixedDimension.IncrementalUpdate", false); // update the coupling maps locally after growth
         auto initialDt = getParam<double>("TimeLoop.DtInitial"); // initial time step
         timeLoop = std::make_shared<CheckPointTimeLoop<double>>(/*start time*/0., initialDt, tEnd);
         timeLoop->setMaxTimeStepSize(getParam<double>("TimeLoop.MaxTimeStepSize"));
@@ -275,17 +335,21 @@ int main(int argc, char** argv) try
             std::cout << "using periodic check times \n";
             timeLoop->setPeriodicCheckPoint(getParam<double>("TimeLoop.PeriodicCheckTimes"));
         }
+        if (checkpoint) {
+            timeLoop->setTime(restartTime, checkpoint->read<int>("TimeLoop.timeStepIndex"));
+            timeLoop->setTimeStepSize(checkpoint->read<double>("TimeLoop.timeStepSize"));
+        }
     } else { // static
     }
 
     // intialize the vtk output module
     using SoilSolution = std::decay_t<decltype(sol[soilDomainIdx])>;
-    VtkOutputModule<SoilGridVariables, SoilSolution> soilVtkWriter(*soilGridVariables, sol[soilDomainIdx], soilProblem->name());
+    AsyncVtkOutputModule<SoilGridVariables, SoilSolution> soilVtkWriter(*soilGridVariables, sol[soilDomainIdx], soilProblem->name());
     GetPropType<SoilTypeTag, Properties::VtkOutputFields>::initOutputModule(soilVtkWriter);
     soilVtkWriter.write(0.0);
 
     using RootSolution = std::decay_t<decltype(sol[rootDomainIdx])>;
-    VtkOutputModule<RootGridVariables, RootSolution> rootVtkWriter(*rootGridVariables, sol[rootDomainIdx], rootProblem->name());
+    AsyncVtkOutputModule<RootGridVariables, RootSolution> rootVtkWriter(*rootGridVariables, sol[rootDomainIdx], rootProblem->name());
     GetPropType<RootTypeTag, Properties::VtkOutputFields>::initOutputModule(rootVtkWriter);
 
     rootProblem->userData("pSoil", sol[rootDomainIdx]);
@@ -311,7 +375,7 @@ int main(int argc, char** argv) try
     rootVtkWriter.write(0.0);
 
     // the assembler with time loop for instationary problem
-    using Assembler = MultiDomainFVAssembler<Traits, CouplingManager, DiffMethod::numeric>;
+    using Assembler = ProfiledAssembler<ParallelMultiDomainFVAssembler<Traits, CouplingManager, DiffMethod::numeric>>; // Assembly.NumThreads
     std::shared_ptr<Assembler> assembler;
     if (tEnd > 0) {
         assembler = std::make_shared<Assembler>(std::make_tuple(soilProblem, rootProblem),
@@ -326,13 +390,39 @@ int main(int argc, char** argv) try
     }
 
     // the linear solver
-    using LinearSolver = BlockDiagILU0BiCGSTABSolver;
+    using LinearSolver = ProfiledLinearSolver<BlockDiagILU0BiCGSTABSolver>;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
     using NewtonSolver = MultiDomainNewtonSolver<Assembler, LinearSolver, CouplingManager>;
     NewtonSolver nonLinearSolver(assembler, linearSolver, couplingManager);
 
+    // writes the current state into the checkpoint <Restart.CheckpointName>_<time step index>-<rank>.chk
+    auto writeCheckpoint = [&]() {
+        const auto name = getParam<std::string>("Restart.CheckpointName", "checkpoint") + "_" + std::to_string(timeLoop->timeStepIndex());
+        BinaryCheckpointWriter checkpointWriter(checkpointFileName(name, mpiHelper.rank()));
+        checkpointWriter.write("TimeLoop.time", timeLoop->time());
+        checkpointWriter.write("TimeLoop.timeStepSize", timeLoop->timeStepSize());
+        checkpointWriter.write("TimeLoop.timeStepIndex", timeLoop->timeStepIndex());
+        checkpointWriter.writeBlockVector("Soil.solution", sol[soilDomainIdx]);
+        auto rootSol = sol[rootDomainIdx]; // in the order of the growth model segments
+        for (size_t i = 0; i < rootSol.size(); i++) {
+            rootSol[i] = sol[rootDomainIdx][growth ? growth->map2dune(i) : i];
+        }
+        checkpointWriter.writeBlockVector("Root.solution", rootSol);
+        if (gridGrowth) {
+            checkpointWriter.write("RootSystem.seed", seed);
+            checkpointWriter.write("GridGrowth.steps", gridGrowth->growthSteps());
+            checkpointWriter.write("RootSystem.numSegments", std::uint64_t(rootGrid->leafGridView().size(0))); // to verify the replayed growth
+            checkpointWriter.write("RootSystem.numNodes", std::uint64_t(rootGrid->leafGridView().size(Grid::dimension)));
+        }
+        rootProblem->writeCheckpoint(checkpointWriter); // hormone masses and rates
+        checkpointWriter.close();
+        rootProblem->flushTimeSeries(); // the time series are complete up to the checkpoint
+        soilProblem->flushTimeSeries();
+        std::cout << "checkpoint " << name << " written \n" << std::flush;
+    };
+
     std::cout << "\ni plan to actually start \n" << std::flush;
     if (tEnd > 0) // dynamic
     {
@@ -362,17 +452,13 @@ int main(int argc, char** argv) try
                         rootProblem->applyInitialSolution(sol[rootDomainIdx]);
                         rootGridVariables->updateAfterGridAdaption(sol[rootDomainIdx]); // update the secondary variables
 
-                        couplingManager->updateAfterGridAdaption(soilGridGeometry, rootGridGeometry);
-                        couplingManager->init(soilProblem, rootProblem, sol); // recompute coupling maps
-                        couplingManager->updateSolution(sol); // update the solution vector for the coupling manager
-
-                        soilProblem->computePointSourceMap(); // recompute the coupling sources
-                        rootProblem->computePointSourceMap(); // recompute the coupling sources
-
-                        assembler->setJacobianPattern(assembler->jacobian()); // resize and set Jacobian pattern
-                        assembler->setResidualSize(assembler->residual()); // resize residual vector
+                        coupling.updateAfterGrowth(soilGridGeometry, rootGridGeometry, // coupling maps, point sources, and matrix pattern
+                                                   incrementalCoupling ? &gridGrowth->changedElements() : nullptr, sol, *assembler);
 
                         oldSol[rootDomainIdx] = sol[rootDomainIdx]; // // update old solution to new grid
+                        if (batchedGrowth) {
+                            batchedGrowth->clear(); // the accumulated growth step is applied
+                        }
 
                         std::cout << "grew \n"<< std::flush;
                     }
@@ -381,7 +467,10 @@ int main(int argc, char** argv) try
             // set previous solution for storage evaluations
             assembler->setPreviousSolution(oldSol);
 
-            nonLinearSolver.solve(sol, *timeLoop);
+            {
+                DUMUX_PROFILE_ZONE("newton solve");
+                nonLinearSolver.solve(sol, *timeLoop);
+            }
 
             soilControl(*soilGridGeometry, *soilGridVariables, sol[soilDomainIdx], oldSol[soilDomainIdx], t, dt); //debugging soil water content
 
@@ -396,6 +485,7 @@ int main(int argc, char** argv) try
             timeLoop->advanceTimeStep(); // advance to the time loop to the next step
 
             if ((timeLoop->isCheckPoint()) || (timeLoop->finished())) { // write vtk output (only at check points)
+                DUMUX_PROFILE_ZONE("output");
                 if (grow) { // prepare static fields also
                     rootProblem->userData("radius", sol[rootDomainIdx]);
                     rootProblem->userData("order", sol[rootDomainIdx]);
@@ -418,6 +508,10 @@ int main(int argc, char** argv) try
             timeLoop->reportTimeStep();  // report statistics of this time step
             timeLoop->setTimeStepSize(nonLinearSolver.suggestTimeStepSize(timeLoop->timeStepSize())); // set new dt as suggested by the newton solver
 
+            if (writeCheckpoints && (timeLoop->isCheckPoint() || timeLoop->finished())) {
+                writeCheckpoint();
+            }
+
         } while (!timeLoop->finished());
 
         timeLoop->finalize();
@@ -428,7 +522,10 @@ int main(int argc, char** argv) try
 
         assembler->setPreviousSolution(oldSol); // set previous solution for storage evaluations
 
-        nonLinearSolver.solve(sol); // solve the non-linear system
+        {
+            DUMUX_PROFILE_ZONE("newton solve");
+            nonLinearSolver.solve(sol); // solve the non-linear system
+        }
 
         // write outputs
         rootProblem->userData("p", sol[rootDomainIdx]);
@@ -449,11 +546,16 @@ int main(int argc, char** argv) try
     // finalize, print dumux message to say goodbye
     ////////////////////////////////////////////////////////////
 
+    soilVtkWriter.finish(); // wait for the pending output
+    rootVtkWriter.finish();
+
     // print dumux end message
     if (mpiHelper.rank() == 0) {
         Parameters::print();
     }
 
+    Profiler::instance().write(rootProblem->name(), mpiHelper.getCollectiveCommunication()); // only with DUMUX_PROFILING
+
     return 0;
 } // end main
 catch (Dumux::ParameterException &e) {
@@ -1,6 +1,8 @@
-''' singleroot '''
+''' singleroot: runs the first week (test_restart1) writing checkpoints, and resumes the second week (test_restart2)
+    from the last checkpoint, including the hormone masses and rates of the stomata model '''
 
 import os
+import glob
 import matplotlib.pyplot as plt
 from vtk_tools import *
 import van_genuchten as vg
@@ -14,8 +16,15 @@ path = os.path.dirname(os.path.realpath(__file__))
 os.chdir(path)
 os.chdir("../../../build-cmake/rosi_benchmarking/coupled_1pnc_richards")
 
-# # run simulation
-os.system("./coupled_periodic_1pnc_richards input/" + name + ".input")
+# run the first week, with checkpoints test_restart1_<time step index>-<rank>.chk
+os.system("./coupled_1pnc_richards input/test_restart1.input -Restart.WriteCheckpoints true -Restart.CheckpointName test_restart1")
+checkpoints = glob.glob("test_restart1_*-0.chk")
+if not checkpoints:
+    raise FileNotFoundError("test_restart.py: test_restart1 wrote no checkpoint")
+last = max(checkpoints, key = lambda f: int(f[len("test_restart1_"):-len("-0.chk")]))
+
+# resume from the last checkpoint
+os.system("./coupled_1pnc_richards input/" + name + ".input -Restart.Checkpoint " + last[:-len("-0.chk")])
 
 # move results to folder 'name'
 if not os.path.exists("results_" + name):
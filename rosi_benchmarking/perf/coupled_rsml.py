@@ -0,0 +1,108 @@
+"""
+Benchmark M1.2 static root system in soil (like python_solver/coupled/coupled_c12.py), without plots, for rosi_perf.py
+
+usage: python3 coupled_rsml.py [--rsml FILE] [--cells NX NY NZ] [--days T] [--dt DT] [--name NAME]
+
+The root system (rsml) and the soil resolution are arguments, prints the wall time per phase as ROSI_PERF {json}
+(the soil solver writes its profile, if the binding is built with DUMUX_ROSI_PROFILING)
+"""
+import argparse
+import json
+import timeit
+
+from xylem_flux import XylemFluxPython  # Python hybrid solver
+import plantbox as pb
+from rosi_richards import RichardsSP  # C++ part (Dumux binding)
+from richards import RichardsWrapper  # Python part
+
+from math import *
+import numpy as np
+from mpi4py import MPI; comm = MPI.COMM_WORLD; rank = comm.Get_rank()
+
+import sys; sys.path.append(".")  # runs in python_solver/coupled
+from root_conductivities import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--rsml", default = "../grids/RootSystem.rsml")
+parser.add_argument("--cells", type = int, nargs = 3, default = [8, 8, 15])
+parser.add_argument("--days", type = float, default = 1.)  # [day]
+parser.add_argument("--dt", type = float, default = 120.)  # [s]
+parser.add_argument("--name", default = "coupled_rsml")
+args = parser.parse_args()
+
+
+def sinusoidal(t):
+    return np.sin(2. * pi * np.array(t) - 0.5 * pi) + 1.
+
+
+""" Parameters """
+min_b = [-4., -4., -15.]
+max_b = [4., 4., 0.]
+cell_number = args.cells
+loam = [0.08, 0.43, 0.04, 1.6, 50]
+initial = -659.8 + 7.5
+trans = 6.4  # cm3 /day (sinusoidal)
+wilting_point = -15000  # cm
+dt = args.dt / (24 * 3600)  # [days]
+timer = { "setup": 0., "root solve": 0., "soil fluxes": 0., "soil solve": 0. }
+
+""" Initialize macroscopic soil model """
+start_time = timeit.default_timer()
+cpp_base = RichardsSP()
+s = RichardsWrapper(cpp_base)
+s.initialize()
+s.createGrid(min_b, max_b, cell_number, False)  # [cm]
+s.setHomogeneousIC(initial, True)  # cm pressure head, equilibrium
+s.setTopBC("noFlux")
+s.setBotBC("noFlux")
+s.setVGParameters([loam])
+s.initializeProblem()
+s.setCriticalPressure(wilting_point)
+
+""" Initialize xylem model """
+r = XylemFluxPython(args.rsml)
+r.rs.setRectangularGrid(pb.Vector3d(min_b[0], min_b[1], min_b[2]), pb.Vector3d(max_b[0], max_b[1], max_b[2]),
+                        pb.Vector3d(cell_number[0], cell_number[1], cell_number[2]))
+init_conductivities(r, False)
+r.rs.sort()  # ensures segment is located at index s.y-1
+nodes = r.get_nodes()
+rs_age = np.max(r.get_ages())
+
+""" Coupling (map indices) """
+picker = lambda x, y, z : s.pick([x, y, z])
+r.rs.setSoilGrid(picker)  # maps segments
+cci = picker(nodes[0, 0], nodes[0, 1], nodes[0, 2])  # collar cell index
+timer["setup"] = timeit.default_timer() - start_time
+
+""" Numerical solution """
+sx = s.getSolutionHead()  # inital condition, solverbase.py
+N = round(args.days / dt)
+t = 0.
+for i in range(0, N):
+
+    t0 = timeit.default_timer()
+    if rank == 0:  # Root part is not parallel
+        rx = r.solve(rs_age + t, -trans * sinusoidal(t), sx[cci], sx, True, wilting_point, [])  # xylem_flux.py
+        t1 = timeit.default_timer()
+        fluxes = r.soilFluxes(rs_age + t, rx, sx, approx = False)
+        timer["root solve"] += t1 - t0
+        timer["soil fluxes"] += timeit.default_timer() - t1
+    else:
+        fluxes = None
+    fluxes = comm.bcast(fluxes, root = 0)  # Soil part runs parallel
+    s.setSource(fluxes)  # richards.py
+
+    t0 = timeit.default_timer()
+    s.ddt = dt / 10
+    s.solve(dt)
+    sx = s.getSolutionHead()  # richards.py
+    timer["soil solve"] += timeit.default_timer() - t0
+    t += dt
+
+if hasattr(cpp_base, "writeProfile"):
+    cpp_base.writeProfile(args.name)  # <name>_profile.json, if profiling is enabled
+
+if rank == 0:
+    print("Coupled benchmark solved in ", timeit.default_timer() - start_time, " s")
+    print("ROSI_PERF " + json.dumps({ "phases": timer, "segments": len(r.rs.segments), "soil_cells": int(np.prod(cell_number)),
+                                      "coupling_steps": N }))
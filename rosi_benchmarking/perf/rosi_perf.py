@@ -0,0 +1,337 @@
+""" Runs the performance benchmark matrix (matrix.json), writes a machine readable report, and compares it with a baseline
+
+    usage: python3 rosi_perf.py [--build-dir DIR] [--matrix matrix.json] [--suite quick|full] [--cases REGEX]
+                                [--repeat N] [--report report.json] [--baseline baseline.json] [--write-baseline FILE]
+           python3 rosi_perf.py --compare report.json --baseline baseline.json
+
+    Per case the report contains
+      - wall_time [s] (minimum over --repeat runs), peak_rss [MB] (maximum over the processes of the case),
+      - newton_iterations, linear_iterations, accepted_steps, rejected_steps (parsed from the output of the Newton solver),
+      - phases: wall time per profiling zone [s] (from <name>_profile.json, needs the CMake option DUMUX_ROSI_PROFILING=ON),
+      - speedup: wall and phase times of the reference case divided by the ones of the case, if the benchmark
+        names a reference value of an axis (e.g. "speedup": { "parallel": "serial" }),
+    and the status (ok, failed, timeout, or missing, if the executable or a required module is not built).
+
+    Compared with a baseline, wall and phase times, or peak RSS larger than the tolerance, changed iteration or step counts,
+    and failing cases are regressions (exit code 1). Times below --min-time are not compared (noise).
+
+    The CMake targets rosi_perf, rosi_perf_quick, rosi_perf_compare, and rosi_perf_baseline call this script.
+"""
+import argparse
+import datetime
+import glob
+import itertools
+import json
+import os
+import platform
+import re
+import resource
+import subprocess
+import sys
+import time
+
+perf_dir = os.path.dirname(os.path.abspath(__file__))
+
+_newton = re.compile(r"Newton iteration \d+ done")
+_accepted = re.compile(r"Time step \d+ done")
+_rejected = re.compile(r"Retrying with time step")
+_linear = re.compile(r"Linear solver statistics.*?(\d+) solves, (\d+) failed, (\d+) iterations")
+_extra = re.compile(r"^ROSI_PERF (\{.*\})\s*$", re.MULTILINE)
+
+counts = ["newton_iterations", "linear_iterations", "accepted_steps", "rejected_steps"]
+
+
+def expand(matrix):
+    """ the cases of the matrix, i.e. per benchmark the cartesian product of its axes """
+    cases = []
+    for b in matrix["benchmarks"]:
+        axes = list(b.get("axes", {}).items())
+        for values in itertools.product(*[list(a[1].items()) for a in axes]):
+            case = { "name": "-".join([b["name"]] + [v[0] for v in values]),
+                     "benchmark": b["name"],
+                     "axes": { a[0]: v[0] for a, v in zip(axes, values) },
+                     "target": b.get("target"),
+                     "script": b.get("script"),
+                     "cwd": b.get("cwd"),
+                     "input": b.get("input"),
+                     "requires": b.get("requires", []),
+                     "params": dict(b.get("params", {})),
+                     "args": list(b.get("args", [])),
+                     "np": b.get("np", 1),
+                     "speedup": b.get("speedup", {}) }
+            for v in values:
+                case["params"].update(v[1].get("params", {}))
+                case["args"] += v[1].get("args", [])
+                case["np"] = v[1].get("np", case["np"])
+                case["target"] = v[1].get("target", case["target"])
+            quick = b.get("quick", {})
+            case["suites"] = ["full"] + (["quick"] if all(v in quick.get(a, []) for a, v in case["axes"].items()) else [])
+            cases.append(case)
+    return cases
+
+
+def command(case, args):
+    """ the command line, and the working directory of the case """
+    if case["target"]:
+        exe = os.path.join(args.build_dir, case["target"])
+        cwd = os.path.join(args.build_dir, case["cwd"] or os.path.dirname(case["target"]))
+        cmd = [exe] + ([case["input"]] if case["input"] else [])
+        for key, value in sorted(case["params"].items()):
+            cmd += ["-" + key, str(value)]
+        cmd += ["-Problem.Name", "perf_" + case["name"].replace("-", "_")]
+    else:
+        exe = os.path.join(perf_dir, case["script"])
+        cwd = os.path.join(perf_dir, "..", case["cwd"] or "perf")  # the python scripts run in the source folder
+        cmd = [sys.executable, exe, "--name", "perf_" + case["name"].replace("-", "_")]
+    cmd += case["args"]
+    if case["np"] > 1:
+        cmd = [args.mpiexec, "-np", str(case["np"])] + cmd
+    return exe, cwd, cmd
+
+
+def parse(output):
+    """ the iteration and step counts, and the metrics printed as ROSI_PERF {json} (by the python benchmarks) """
+    m = { "newton_iterations": len(_newton.findall(output)),
+          "accepted_steps": len(_accepted.findall(output)),
+          "rejected_steps": len(_rejected.findall(output)),
+          "linear_iterations": None }
+    linear = _linear.findall(output)
+    if linear:
+        m["linear_iterations"] = sum(int(l[2]) for l in linear)
+    for extra in _extra.findall(output):
+        m.update(json.loads(extra))
+    return m
+
+
+def phases(cwd, name, since):
+    """ the wall time per profiling zone (maximum over ranks) [s], if the run has written a profile """
+    profiles = [f for f in glob.glob(os.path.join(cwd, name + "*_profile.json")) if os.path.getmtime(f) >= since]
+    if not profiles:
+        return {}
+    with open(max(profiles, key = os.path.getmtime)) as f:
+        profile = json.load(f)
+    return { z["name"]: z["total"]["max"] for z in profile["zones"] }
+
+
+def measure(out, cmd):
+    """ runs cmd in a fresh process (called with --measure), so that its peak RSS is not mixed up with other cases """
+    start = time.perf_counter()
+    returncode = subprocess.call(cmd)
+    wall_time = time.perf_counter() - start
+    usage = resource.getrusage(resource.RUSAGE_CHILDREN)
+    rss = usage.ru_maxrss / (1024. * 1024. if sys.platform == "darwin" else 1024.)  # [MB]
+    with open(out, "w") as f:
+        json.dump({ "returncode": returncode, "wall_time": wall_time, "peak_rss": rss,
+                    "user_time": usage.ru_utime, "system_time": usage.ru_stime }, f)
+    return 0
+
+
+def run(case, args, log_dir):
+    """ runs the case --repeat times, returns its result """
+    exe, cwd, cmd = command(case, args)
+    result = { "axes": case["axes"], "np": case["np"], "command": " ".join(cmd) }
+    if not os.path.exists(exe) or not all(glob.glob(os.path.join(args.build_dir, r)) for r in case["requires"]):
+        result["status"] = "missing"
+        return result
+    env = dict(os.environ, OMP_NUM_THREADS = "1")
+    if case["script"]:
+        env["PYTHONPATH"] = os.pathsep.join([os.path.join(args.build_dir, "python_solver"),
+                                             os.path.join(perf_dir, "..", "python_solver", "solvers"),
+                                             env.get("PYTHONPATH", "")])
+    log = os.path.join(log_dir, case["name"] + ".log")
+    usage = os.path.join(log_dir, case["name"] + ".usage.json")
+    runs = []
+    for i in range(0, args.repeat):
+        since = time.time()
+        with open(log, "w") as f:
+            try:
+                subprocess.run([sys.executable, os.path.abspath(__file__), "--measure", usage, "--"] + cmd, cwd = cwd,
+                               env = env, stdout = f, stderr = subprocess.STDOUT, timeout = args.timeout)
+            except subprocess.TimeoutExpired:
+                result["status"] = "timeout"
+                return result
+        with open(usage) as f:
+            u = json.load(f)
+        with open(log, errors = "replace") as f:
+            output = f.read()
+        if u["returncode"] != 0:
+            result.update(status = "failed", returncode = u["returncode"], log = log)
+            return result
+        m = parse(output)
+        m.update(wall_time = u["wall_time"], peak_rss = u["peak_rss"], user_time = u["user_time"], system_time = u["system_time"])
+        m["phases"] = dict(phases(cwd, "perf_" + case["name"].replace("-", "_"), since), **m.get("phases", {}))
+        runs.append(m)
+    best = min(runs, key = lambda m: m["wall_time"])
+    result.update(best)
+    result.update(status = "ok", log = log, wall_times = [m["wall_time"] for m in runs],
+                  peak_rss = max(m["peak_rss"] for m in runs))
+    return result
+
+
+def speedups(report, cases):
+    """ adds the speedups over the reference cases (see "speedup" in the matrix) to the results of the cases """
+    names = { (c["benchmark"], tuple(sorted(c["axes"].items()))): c["name"] for c in cases }
+    for c in cases:
+        r = report["cases"].get(c["name"])
+        for axis, reference in c["speedup"].items():
+            if r is None or r["status"] != "ok" or c["axes"].get(axis) in (None, reference):
+                continue
+            ref_name = names.get((c["benchmark"], tuple(sorted(dict(c["axes"], **{ axis: reference }).items()))))
+            ref = report["cases"].get(ref_name)
+            if ref is None or ref["status"] != "ok":
+                continue
+            r["speedup"] = { "reference": ref_name,
+                             "wall_time": ref["wall_time"] / r["wall_time"],
+                             "phases": { z: t / r["phases"][z] for z, t in ref.get("phases", {}).items() if r["phases"].get(z) } }
+
+
+def print_speedups(report):
+    rows = [(n, r["speedup"]) for n, r in sorted(report["cases"].items()) if "speedup" in r]
+    if rows:
+        print("\n{:48s} {:>48s} {:>8s} {:>9s}".format("case", "over", "wall", "assembly"))
+        for name, s in rows:
+            assembly = s["phases"].get("assembly")
+            print("{:48s} {:>48s} {:8.2f} {:>9s}".format(name, s["reference"], s["wall_time"],
+                  "{:.2f}".format(assembly) if assembly else "-"))
+
+
+def machine():
+    """ where and what was measured """
+    try:
+        commit = subprocess.check_output(["git", "rev-parse", "HEAD"], cwd = perf_dir, stderr = subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        commit = None
+    return { "host": platform.node(), "platform": platform.platform(), "processor": platform.processor(),
+             "cpus": os.cpu_count(), "python": platform.python_version(), "commit": commit,
+             "date": datetime.datetime.now().isoformat(timespec = "seconds") }
+
+
+def compare(report, baseline, args):
+    """ the differences of report to baseline, as list of (case, metric, baseline value, value, regression) """
+    diffs = []
+
+    def time_diff(name, metric, old, new, tolerance):
+        if old is None or new is None or max(old, new) < args.min_time:
+            return
+        if new > old * (1. + tolerance):
+            diffs.append((name, metric, old, new, True))
+        elif new < old * (1. - tolerance):
+            diffs.append((name, metric, old, new, False))
+
+    for name, old in sorted(baseline["cases"].items()):
+        new = report["cases"].get(name)
+        if new is None:
+            diffs.append((name, "status", old["status"], "not run", False))
+            continue
+        if new["status"] != "ok" or old["status"] != "ok":
+            if new["status"] != old["status"]:
+                diffs.append((name, "status", old["status"], new["status"], new["status"] != "ok"))
+            continue
+        time_diff(name, "wall_time", old["wall_time"], new["wall_time"], args.time_tolerance)
+        for zone, t in sorted(old.get("phases", {}).items()):
+            time_diff(name, "phases." + zone, t, new.get("phases", {}).get(zone), args.time_tolerance)
+        if new["peak_rss"] > old["peak_rss"] * (1. + args.rss_tolerance):
+            diffs.append((name, "peak_rss", old["peak_rss"], new["peak_rss"], True))
+        for c in counts:
+            o, n = old.get(c), new.get(c)
+            if o is not None and n is not None and abs(n - o) > args.iteration_tolerance * max(o, 1):
+                diffs.append((name, c, o, n, n > o))
+    for name in sorted(set(report["cases"]) - set(baseline["cases"])):
+        diffs.append((name, "status", "not in baseline", report["cases"][name]["status"], False))
+    return diffs
+
+
+def print_summary(report):
+    print("\n{:48s} {:>8s} {:>10s} {:>10s} {:>8s} {:>8s} {:>9s}".format("case", "status", "wall [s]", "RSS [MB]", "newton", "linear", "steps"))
+    for name, r in sorted(report["cases"].items()):
+        if r["status"] == "ok":
+            print("{:48s} {:>8s} {:10.2f} {:10.1f} {:8d} {:>8s} {:5d}/{:<3d}".format(name, r["status"], r["wall_time"], r["peak_rss"],
+                  r["newton_iterations"], str(r["linear_iterations"]), r["accepted_steps"], r["rejected_steps"]))
+        else:
+            print("{:48s} {:>8s}".format(name, r["status"]))
+
+
+def print_diffs(diffs, baseline):
+    print("\nCompared with the baseline of", baseline["machine"].get("date"), "(commit", str(baseline["machine"].get("commit")) + ")")
+    if not diffs:
+        print("no differences")
+    for name, metric, old, new, regression in diffs:
+        f = lambda v: "{:.3g}".format(v) if isinstance(v, float) else str(v)
+        print("  {:12s} {:48s} {:28s} {:>12s} -> {:<12s}".format("REGRESSION" if regression else "changed", name, metric, f(old), f(new)))
+
+
+def main():
+    if len(sys.argv) > 3 and sys.argv[1] == "--measure" and sys.argv[3] == "--":
+        sys.exit(measure(sys.argv[2], sys.argv[4:]))
+
+    parser = argparse.ArgumentParser(description = __doc__, formatter_class = argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--build-dir", default = os.path.join(perf_dir, "..", "..", "build-cmake", "rosi_benchmarking"),
+                        help = "the rosi_benchmarking folder of the build directory")
+    parser.add_argument("--matrix", default = os.path.join(perf_dir, "matrix.json"))
+    parser.add_argument("--suite", default = "full", choices = ["quick", "full"])
+    parser.add_argument("--cases", default = None, help = "only cases matching this regular expression")
+    parser.add_argument("--list", action = "store_true", help = "print the cases and their command lines, and exit")
+    parser.add_argument("--repeat", type = int, default = 1, help = "runs per case, the fastest one is reported")
+    parser.add_argument("--timeout", type = float, default = 7200., help = "per run [s]")
+    parser.add_argument("--mpiexec", default = os.environ.get("MPIEXEC", "mpiexec"))
+    parser.add_argument("--report", default = "rosi_perf_report.json")
+    parser.add_argument("--compare", default = None, help = "compare this report with the baseline (without running)")
+    parser.add_argument("--baseline", default = None, help = "compare the report with this baseline (ignored, if the file does not exist)")
+    parser.add_argument("--write-baseline", default = None, help = "copy the report to this file")
+    parser.add_argument("--time-tolerance", type = float, default = 0.1, help = "relative, for wall and phase times")
+    parser.add_argument("--rss-tolerance", type = float, default = 0.1, help = "relative, for the peak RSS")
+    parser.add_argument("--iteration-tolerance", type = float, default = 0., help = "relative, for iteration and step counts")
+    parser.add_argument("--min-time", type = float, default = 0.5, help = "times below [s] are not compared")
+    args = parser.parse_args()
+    args.build_dir = os.path.abspath(args.build_dir)
+
+    if args.compare:
+        if not os.path.exists(args.compare):
+            print("no report", args.compare, "(run the benchmarks first, e.g. make rosi_perf)")
+            return 1
+        with open(args.compare) as f:
+            report = json.load(f)
+    else:
+        with open(args.matrix) as f:
+            cases = [c for c in expand(json.load(f)) if args.suite in c["suites"]]
+        if args.cases:
+            cases = [c for c in cases if re.search(args.cases, c["name"])]
+        if args.list:
+            for c in cases:
+                print(c["name"] + ":", " ".join(command(c, args)[2]))
+            return 0
+        log_dir = os.path.abspath(os.path.splitext(args.report)[0] + "_logs")
+        os.makedirs(log_dir, exist_ok = True)
+        report = { "machine": machine(), "suite": args.suite, "repeat": args.repeat, "cases": {} }
+        for i, c in enumerate(cases):
+            print("[{:d}/{:d}] {:s}".format(i + 1, len(cases), c["name"]), flush = True)
+            report["cases"][c["name"]] = run(c, args, log_dir)
+            print("  ", report["cases"][c["name"]]["status"], flush = True)
+        speedups(report, cases)
+        with open(args.report, "w") as f:
+            json.dump(report, f, indent = 2, sort_keys = True)
+        print_summary(report)
+        print_speedups(report)
+        print("\nwrote", args.report)
+        if args.write_baseline:
+            with open(args.write_baseline, "w") as f:
+                json.dump(report, f, indent = 2, sort_keys = True)
+            print("wrote baseline", args.write_baseline)
+
+    failed = [n for n, r in report["cases"].items() if r["status"] in ("failed", "timeout")]
+    regressions = bool(failed)
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if not args.compare:  # compare only the cases of the suite
+            baseline["cases"] = { n: r for n, r in baseline["cases"].items() if n in report["cases"] }
+        diffs = compare(report, baseline, args)
+        print_diffs(diffs, baseline)
+        regressions = regressions or any(d[4] for d in diffs)
+    elif args.baseline:
+        print("\nno baseline", args.baseline, "(create it with make rosi_perf_baseline)")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
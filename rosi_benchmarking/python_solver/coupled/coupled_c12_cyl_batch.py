@@ -0,0 +1,284 @@
+import sys
+sys.path.append("../../../build-cmake/rosi_benchmarking/python_solver/")
+sys.path.append("../solvers/")  # for pure python solvers
+
+from xylem_flux import XylemFluxPython  # Python hybrid solver
+import plantbox as pb  # CPlantBox
+import rsml_reader as rsml
+from rosi_richards import RichardsSP  # C++ part (Dumux binding), macroscopic soil model
+from rosi_richards_cyl_batch import RichardsCylBatch  # C++ part, all local cylindrical models
+from richards import RichardsWrapper  # Python part
+import vtk_plot as vp
+import vtk_tools as vt
+import van_genuchten as vg
+from root_conductivities import *
+
+from math import *
+import numpy as np
+import matplotlib.pyplot as plt
+import timeit
+
+
+def sinusoidal(t):
+    """ sinusoidal function (used for transpiration) """
+    return np.sin(2. * pi * np.array(t) - 0.5 * pi) + 1.
+
+""" 
+Benchmark M1.2 static root system in soil, coupled to cylindrical richards (batched C++ solver, one model per segment)
+"""
+
+""" Parameters """
+min_b = [-4., -4., -15.]
+max_b = [4., 4., 0.]
+cell_number = [4, 4, 7]  # [8, 8, 15]  # [16, 16, 30]  # [32, 32, 60]  # [8, 8, 15]
+periodic = False
+
+name = "dumux_c12_2cm_batch"
+loam = [0.08, 0.43, 0.04, 1.6, 50]
+soil = vg.Parameters(loam)
+initial = -659.8 + 7.5  # -659.8
+
+trans = 6.4  # cm3 /day (sinusoidal)
+wilting_point = -15000  # cm
+
+sim_time = 1  # 0.65  # 0.25  # [day]
+age_dependent = False  # conductivities
+predefined_growth = False  # growth by setting radial conductivities
+
+NC = 10  # dof+1
+logbase = 1.5
+split_type = 0  # type 0 == volume, type 1 == surface, type 2 == length
+
+NT = round(10 * sim_time * 24 * 3600 / 1200)
+skip = 1  # for output and results, skip iteration
+domain_volume = np.prod(np.array(max_b) - np.array(min_b))
+
+""" Initialize macroscopic soil model """
+cpp_base = RichardsSP()
+s = RichardsWrapper(cpp_base)
+s.initialize()
+s.createGrid(min_b, max_b, cell_number, periodic)  # [cm]
+s.setHomogeneousIC(initial, True)  # cm pressure head, equilibrium
+s.setTopBC("noFlux")
+s.setBotBC("noFlux")
+s.setVGParameters([loam])
+s.initializeProblem()
+s.setCriticalPressure(wilting_point)  # new source term regularisation
+s.setRegularisation(1.e-4, 1.e-4)
+s.ddt = 1.e-5  # [day] initial Dumux time step
+
+""" Initialize xylem model (a) or (b)"""
+r = XylemFluxPython("../grids/RootSystem.rsml")
+print("number of segments", len(r.get_segments()))
+r.rs.setRectangularGrid(pb.Vector3d(min_b[0], min_b[1], min_b[2]), pb.Vector3d(max_b[0], max_b[1], max_b[2]),
+                        pb.Vector3d(cell_number[0], cell_number[1], cell_number[2]))
+init_conductivities(r, age_dependent)
+picker = lambda x, y, z : s.pick([x, y, z])
+r.rs.setSoilGrid(picker)  # maps segments
+r.rs.sort()  # <- ensures segment is located at index s.y-1
+
+nodes = r.get_nodes()
+cci = picker(nodes[0, 0], nodes[0, 1], nodes[0, 2])  # collar cell index
+segs = r.get_segments()
+rs_age = 8 * (not predefined_growth) + 1 * predefined_growth  # rs_age = 0 in case of growth, else 8 days
+seg_ages = r.get_ages(rs_age)
+seg_types = r.rs.types
+seg_length = r.segLength()
+inner_radii = np.array(r.rs.radii)
+outer_radii = r.segOuterRadii(split_type)
+
+# # For debugging
+# ana2 = pb.SegmentAnalyser(r.rs.nodes, r.rs.segments, r.rs.nodeCTs[1:], r.rs.radii)
+# types = np.array(r.rs.types, dtype = np.float64)
+# ana2.addData("subType", types)
+# ana2.addData("age", r.get_ages())
+# pd = vp.segs_to_polydata(ana2, 1., ["radius", "subType", "creationTime", "age"])
+# vp.plot_roots(pd, "creationTime")
+
+r.test()  # sanity checks
+print("Initial root system age ", rs_age)
+print("Initial pressure head", s.getSolutionHeadAt(cci), s.getSolutionHeadAt(picker(0., 0., min_b[2])))
+# input()
+
+""" Initialize local soil models (around each root segment) """
+ns = len(seg_length)  # number of segments
+ndof = NC - 1
+small = outer_radii <= inner_radii  # this happens if elements are not within the domain
+if np.any(small):
+    print("Segments", np.nonzero(small)[0], "have no outer radius")
+    outer_radii[small] = 1.1 * inner_radii[small]
+points = np.logspace(np.log(inner_radii) / np.log(logbase), np.log(outer_radii) / np.log(logbase), NC, base = logbase, axis = 1)
+z = 0.5 * (nodes[segs[:, 0], 2] + nodes[segs[:, 1], 2])
+
+start_time = timeit.default_timer()
+cyls = RichardsCylBatch()
+cyls.setVGParameters([loam])
+cyls.createGrids(points, seg_length)
+cyls.setInitialHead(initial - 7.5 - z)
+cyls.criticalPressure = wilting_point
+cyls.ddt = 1.e-5  # [day]
+print ("Initialized in", timeit.default_timer() - start_time, " s")
+
+""" Simulation """
+print("Starting simulation")
+start_time = timeit.default_timer()
+
+dt = sim_time / NT
+
+min_rx, min_rsx, collar_sx, collar_flux, out_times = [], [], [], [], []  # cm
+water_uptake, water_collar_cell, water_cyl, water_domain = [], [], [], []  # cm3
+
+rsx = np.zeros((ns,))  # matric potential at the root soil interface [cm]
+cell_volumes = s.getCellVolumes()
+inital_soil_water = np.sum(np.multiply(np.array(s.getWaterContent()), cell_volumes))
+
+net_flux = np.zeros(cell_volumes.shape)
+realized_inner_fluxes = np.zeros((ns,))
+seg_kr = np.zeros((ns,))
+
+for i in range(0, NT):
+
+    wall_iteration = timeit.default_timer()
+    t = i * dt
+
+    """ 
+    Xylem model 
+    """
+    csx = s.getSolutionHeadAt(cci)  # [cm]
+    rsx = np.array(cyls.getInnerHead())  # [cm]
+
+    wall_root_model = timeit.default_timer()
+    soil_k = np.divide(vg.hydraulic_conductivity(rsx, soil), inner_radii)  # only valid for homogenous soil
+    rx = r.solve(rs_age + t, -trans * sinusoidal(t), csx, rsx, False, wilting_point, soil_k)  # [cm]
+    wall_root_model = timeit.default_timer() - wall_root_model
+
+    if i % skip == 0:
+        out_times.append(t)
+        collar_flux.append(r.collar_flux(rs_age + t, rx, rsx, soil_k, 0, False))
+        min_rsx.append(np.min(np.array(rsx)))
+        collar_sx.append(csx)
+        min_rx.append(np.min(np.array(rx)))
+        print("Minimum of cylindrical model {:g} cm, soil cell {:g} cm, root xylem {:g} cm".format(min_rsx[-1], np.min(s.getSolutionHead()), min_rx[-1]))
+
+    """
+    Local soil model
+    """
+    proposed_outer_fluxes = r.splitSoilFluxes(net_flux / dt, split_type)
+    for j in range(0, ns):
+        seg_kr[j] = r.kr_f(seg_ages[j] + t, seg_types[j])
+    rx_seg = 0.5 * (np.array(rx)[segs[:, 0]] + np.array(rx)[segs[:, 1]])  # xylem pressure at the segment mid [cm]
+    cyls.setInnerHead(rx_seg, seg_kr)  # "rootsystem" boundary condition
+    cyls.setOuterFlux(np.array(proposed_outer_fluxes) / (2 * np.pi * outer_radii * seg_length))  # [cm/day]
+
+    wall_rhizo_models = timeit.default_timer()
+    cyls.solve(dt)
+    wall_rhizo_models = timeit.default_timer() - wall_rhizo_models
+
+    realized_inner_fluxes = np.array(cyls.getInnerFlux()) * (2 * np.pi * inner_radii * seg_length)  # [cm3/day]
+
+    """
+    Macroscopic soil model
+    """
+    soil_water = np.multiply(np.array(s.getWaterContent()), cell_volumes)  # water per cell [cm3]
+    soil_fluxes = r.sumSoilFluxes(realized_inner_fluxes)  # [cm3/day]
+
+    wall_soil_model = timeit.default_timer()
+    s.setSource(soil_fluxes.copy())  # [cm3/day], in richards.py
+    s.solve(dt)  # in solverbase.py
+    wall_soil_model = timeit.default_timer() - wall_soil_model
+
+    new_soil_water = np.multiply(np.array(s.getWaterContent()), cell_volumes)
+    net_flux = new_soil_water - soil_water  # change in water per cell [cm3]
+    for k, root_flux in soil_fluxes.items():
+        net_flux[k] -= root_flux * dt
+    soil_water = new_soil_water
+
+    if i % skip == 0:
+        min_soil_fluxes, max_soil_fluxes, summed_soil_fluxes = 1.e9, -1.e9, 0.
+        for k, v in soil_fluxes.items():
+            summed_soil_fluxes += v
+            if max_soil_fluxes < v:
+                max_soil_fluxes = v
+            if min_soil_fluxes > v:
+                min_soil_fluxes = v
+        print("Fluxes: realized per segment", summed_soil_fluxes, np.sum(realized_inner_fluxes), "predescribed: ", collar_flux[-1], -trans * sinusoidal(t))
+        print("      : min {:g}, max {:g}".format(min_soil_fluxes, max_soil_fluxes))
+        # print("Summed net flux {:g}, min movement {:g}, max {:g} cm3".format(np.sum(net_flux), np.min(net_flux), np.max(net_flux)))  # summed fluxes should equal zero
+
+    """ 
+    Water (for output only)
+    """
+    wall_iteration = timeit.default_timer() - wall_iteration
+    if i % skip == 0:
+        water_domain.append(np.min(soil_water))  # from previous time step
+        water_collar_cell.append(soil_water[cci])
+        water_uptake.append(summed_soil_fluxes)  # cm3/day
+        cyl_water = np.sum(np.array(cyls.getWaterVolume())[r.rs.cell2seg[cci]])  # segments in the collar cell
+        water_cyl.append(cyl_water)
+        print("Iteration {:g} s, rhizo {:g} s, {:g}% root, {:g}% rhizo {:g}% soil".
+              format(wall_iteration, wall_rhizo_models, wall_root_model / wall_iteration, wall_rhizo_models / wall_iteration, wall_soil_model / wall_iteration))
+        n = round(float(i) / float(NT) * 100.)
+        print("[" + ''.join(["*"]) * n + ''.join([" "]) * (100 - n) + "], {:g} days".format(s.simTime))
+        print()
+
+print ("Coupled benchmark solved in ", timeit.default_timer() - start_time, " s")
+
+vp.plot_roots_and_soil(r.rs, "pressure head", rsx, s, periodic, min_b, max_b, cell_number, name)  # VTK vizualisation
+
+fig, ((ax1, ax2), (ax3, ax4)) = plt.subplots(2, 2)
+x_ = out_times
+
+ax1.set_title("Water amount")
+ax1.plot(x_, np.array(water_collar_cell), label = "water cell")
+ax1.plot(x_, np.array(water_cyl), label = "water cylindric")
+ax1.legend()
+ax1.set_xlabel("Time (days)")
+ax1.set_ylabel("(cm3)")
+
+ax2.set_title("Pressure")
+ax2.plot(x_, np.array(collar_sx), label = "soil at root collar")
+ax2.plot(x_, np.array(min_rx), label = "root collar")
+ax2.plot(x_, np.array(min_rsx), label = "1d model at root surface")
+ax2.legend()
+ax2.set_xlabel("Time (days)")
+ax2.set_ylabel("Matric potential (cm)")
+# plt.ylim(-15000, 0)
+
+ax3.set_title("Water uptake")
+ax3.plot(x_, -np.array(water_uptake))
+ax3.set_xlabel("Time (days)")
+ax3.set_ylabel("Uptake (cm/day)")
+
+ax4.set_title("Water in domain")
+ax4.plot(x_, np.array(water_domain))
+ax4.set_xlabel("Time (days)")
+ax4.set_ylabel("cm3")
+plt.show()
+
+fig, ax1 = plt.subplots()
+ax1.plot(x_, trans * sinusoidal(x_), 'k', label = "potential")  # potential transpiration * sinusoidal(x_)
+ax1.plot(x_, -np.array(water_uptake), 'g', label = "actual")  # actual transpiration (neumann)
+ax1.plot(x_, -np.array(collar_flux), 'r:', label = "collar flux")  # actual transpiration (neumann)
+ax2 = ax1.twinx()
+ax2.plot(x_, np.array(min_rx), label = "root collar")
+ax1.set_xlabel("Time [d]")
+ax1.set_ylabel("Transpiration $[cm^3 d^{-1}]$")
+ax2.set_ylabel("Min collar pressure $[cm]$")
+fig.legend()
+
+np.savetxt("results/" + name, np.vstack((x_, -np.array(collar_flux), -np.array(water_uptake))), delimiter = ';')
+
+plt.show()
+
+# old_rs = XylemFluxPython("../grids/RootSystem_big.rsml")
+# ana = pb.SegmentAnalyser(old_rs.rs)
+# ana.filter("creationTime", 0., 8)
+# ana.crop(pb.SDF_PlantBox(7.76, 7.76, 14.76))
+# ana.pack()
+# segCT = ana.data["creationTime"]  # per segment
+# nodeCT = np.zeros((len(segCT) + 1))  # convert segCT to nodeCT
+# for i, seg in enumerate(ana.segments):
+#     nodeCT[seg.y] = segCT[i]
+# subType = np.array(ana.data["subType"], dtype = np.int64)  # convert to int
+# rs = pb.MappedSegments(ana.nodes, nodeCT, ana.segments, ana.data["radius"], subType)
+# r = XylemFluxPython(rs)
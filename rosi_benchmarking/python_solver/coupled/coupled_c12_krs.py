@@ -0,0 +1,137 @@
+import sys
+sys.path.append("../../../build-cmake/rosi_benchmarking/python_solver/")
+sys.path.append("../solvers/")  # for pure python solvers
+
+from xylem_flux import XylemFluxPython  # Python hybrid solver
+from reduced_xylem_flux import ReducedXylemFlux  # Krs and SUF
+import plantbox as pb
+import rsml_reader as rsml
+from rosi_richards import RichardsSP  # C++ part (Dumux binding)
+from richards import RichardsWrapper  # Python part
+import vtk_plot as vp
+import van_genuchten as vg
+from root_conductivities import *
+
+from math import *
+import numpy as np
+import matplotlib.pyplot as plt
+import timeit
+from mpi4py import MPI; comm = MPI.COMM_WORLD; rank = comm.Get_rank()
+
+
+def sinusoidal(t):
+    return np.sin(2. * pi * np.array(t) - 0.5 * pi) + 1.
+
+""" 
+Benchmark M1.2 static root system in soil (with the classic sink), 
+using the reduced order root model (root system conductance Krs and standard uptake fraction SUF)
+
+also works parallel with mpiexec (only slightly faster, due to overhead)
+"""
+
+""" Parameters """
+min_b = [-4., -4., -15.]
+max_b = [4., 4., 0.]
+cell_number = [8, 8, 15]  # [8, 8, 15]  # [16, 16, 30]  # [32, 32, 60]  # [8, 8, 15]
+periodic = False
+
+name = "DuMux_1cm_krs"
+loam = [0.08, 0.43, 0.04, 1.6, 50]
+initial = -659.8 + 7.5  # -659.8
+
+trans = 6.4  # cm3 /day (sinusoidal)
+wilting_point = -15000  # cm
+
+sim_time = 1  # [day] for task b
+age_dependent = True  # conductivities
+dt = 120. / (24 * 3600)  # [days] Time step must be very small
+
+""" Initialize macroscopic soil model """
+cpp_base = RichardsSP()
+s = RichardsWrapper(cpp_base)
+s.initialize()
+s.createGrid(min_b, max_b, cell_number, periodic)  # [cm]
+s.setHomogeneousIC(initial, True)  # cm pressure head, equilibrium
+s.setTopBC("noFlux")
+s.setBotBC("noFlux")
+s.setVGParameters([loam])
+s.initializeProblem()
+s.setCriticalPressure(wilting_point)
+
+""" Initialize xylem model (a) or (b)"""
+r = XylemFluxPython("../grids/RootSystem.rsml")
+r.rs.setRectangularGrid(pb.Vector3d(min_b[0], min_b[1], min_b[2]), pb.Vector3d(max_b[0], max_b[1], max_b[2]),
+                        pb.Vector3d(cell_number[0], cell_number[1], cell_number[2]))
+init_conductivities(r, age_dependent)
+r.rs.sort()  # ensures segment is located at index s.y-1
+r.test()  # sanity checks
+nodes = r.get_nodes()
+rs_age = np.max(r.get_ages())
+
+""" Coupling (map indices) """
+picker = lambda x, y, z : s.pick([x, y, z])
+r.rs.setSoilGrid(picker)  # maps segments
+cci = picker(nodes[0, 0], nodes[0, 1], nodes[0, 2])  # collar cell index
+reduced = ReducedXylemFlux(r, refresh_interval = 0.25, tol = 0.05)  # Krs and SUF are refreshed every 6 hours
+
+""" Numerical solution (a) """
+start_time = timeit.default_timer()
+x_, y_, w_, cpx, cps = [], [], [], [], []
+sx = s.getSolutionHead()  # inital condition, solverbase.py
+
+N = round(sim_time / dt)
+t = 0.
+
+for i in range(0, N):
+
+    if rank == 0:  # Root part is not parallel
+        fluxes = reduced.soil_fluxes(rs_age + t, -trans * sinusoidal(t), sx, wilting_point)  # reduced_xylem_flux.py
+        h_collar, t_act = reduced.collar_potential(-trans * sinusoidal(t), sx, wilting_point)
+        print("Fluxes ", sum(fluxes.values()), "= actual", t_act, "(prescribed", -trans * sinusoidal(t), "), Krs", reduced.krs,
+              "refreshs", reduced.num_refreshs, "(full model after", reduced.num_fallbacks, "), relative error at last refresh", reduced.error)
+
+    else:
+        fluxes = None
+
+    fluxes = comm.bcast(fluxes, root = 0)  # Soil part runs parallel
+    s.setSource(fluxes)  # richards.py
+
+    s.ddt = dt / 10
+    s.solve(dt)
+
+    sx = s.getSolutionHead()  # richards.py
+    water = s.getWaterVolume()
+
+    if rank == 0:
+        n = round(float(i) / float(N) * 100.)
+        min_sx = np.min(sx)
+        max_sx = np.max(sx)
+        print("[" + ''.join(["*"]) * n + ''.join([" "]) * (100 - n) + "], [{:g}, {:g}] cm soil, {:g} cm root collar at {:g} days"
+              .format(min_sx, max_sx, h_collar, s.simTime))
+        x_.append(t)
+        y_.append(t_act)
+        w_.append(water)
+        cpx.append(h_collar)
+        cps.append(float(sx[cci]))
+
+        # print("Time:", t, ", collar flux", f, "cm^3/day at", rx[0], "cm xylem ", float(sx_old[cci]), "cm soil", "; domain water", s.getWaterVolume(), "cm3")
+
+    t += dt
+
+s.writeDumuxVTK(name)
+
+""" Plot """
+if rank == 0:
+    print ("Coupled benchmark solved in ", timeit.default_timer() - start_time, " s")
+
+    fig, ax1 = plt.subplots()
+    ax1.plot(x_, trans * sinusoidal(x_), 'k')  # potential transpiration
+    ax1.plot(x_, -np.array(y_), 'g')  # actual transpiration (neumann)
+    ax2 = ax1.twinx()
+    ax2.plot(x_, np.cumsum(-np.array(y_) * dt), 'c--')  # cumulative transpiration (neumann)
+    ax1.set_xlabel("Time [d]")
+    ax1.set_ylabel("Transpiration $[cm^3 d^{-1}]$")
+    ax1.legend(['Potential', 'Actual', 'Cumulative'], loc = 'upper left')
+    np.savetxt(name, np.vstack((x_, -np.array(y_))), delimiter = ';')
+    plt.show()
+
@@ -15,6 +15,7 @@ namespace py = pybind11;
 
 #include <dumux/linear/amgbackend.hh>
 #include <dumux/assembly/fvassembler.hh>
+#include <dumux/common/profiledsolvers.hh> // zones of the Newton solver, if DUMUX_PROFILING
 
 #include <dumux/discretization/cctpfa.hh>
 #include <dumux/discretization/box.hh>
@@ -67,8 +68,8 @@ struct Grid<TypeTag, TTag::RichardsSPTT> { using type = Dune::SPGrid<GetPropType
  * pick assembler, linear solver and problem
  */
 using RSPTT = Dumux::Properties::TTag::RichardsSPCC; // CC!
-using RichardsSPAssembler = Dumux::FVAssembler<RSPTT, Dumux::DiffMethod::numeric>;
-using RichardsSPLinearSolver = Dumux::AMGBackend<RSPTT>;
+using RichardsSPAssembler = Dumux::ProfiledAssembler<Dumux::FVAssembler<RSPTT, Dumux::DiffMethod::numeric>>;
+using RichardsSPLinearSolver = Dumux::ProfiledLinearSolver<Dumux::AMGBackend<RSPTT>>;
 using RichardsSPProblem = Dumux::RichardsProblem<RSPTT>;
 
 //using RUGTT = Dumux::Properties::TTag::RichardsUGBox;
@@ -15,6 +15,7 @@ namespace py = pybind11;
 
 #include <dumux/linear/amgbackend.hh>
 #include <dumux/assembly/fvassembler.hh>
+#include <dumux/common/profiledsolvers.hh> // zones of the Newton solver, if DUMUX_PROFILING
 
 #include <dumux/discretization/cctpfa.hh>
 #include <dumux/discretization/box.hh>
@@ -56,8 +57,8 @@ struct Grid<TypeTag, TTag::RichardsCylFoamTT> { using type = Dune::FoamGrid<1,1>
  * pick assembler, linear solver and problem
  */
 using RCFoamTT = Dumux::Properties::TTag::RichardsCylFoamCC;
-using RichardsCylFoamAssembler = Dumux::FVAssembler<RCFoamTT, Dumux::DiffMethod::numeric>;
-using RichardsCylFoamLinearSolver = Dumux::AMGBackend<RCFoamTT>;
+using RichardsCylFoamAssembler = Dumux::ProfiledAssembler<Dumux::FVAssembler<RCFoamTT, Dumux::DiffMethod::numeric>>;
+using RichardsCylFoamLinearSolver = Dumux::ProfiledLinearSolver<Dumux::AMGBackend<RCFoamTT>>;
 using RichardsCylFoamProblem = Dumux::RichardsProblem<RCFoamTT>;
 
 
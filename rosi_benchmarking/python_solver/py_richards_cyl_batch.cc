@@ -0,0 +1 @@
+#include "py_richards_cyl_batch.hh"
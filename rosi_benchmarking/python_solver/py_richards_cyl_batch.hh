@@ -0,0 +1,17 @@
+#ifndef PYTHON_RICHARDS_CYL_BATCH_H_
+#define PYTHON_RICHARDS_CYL_BATCH_H_
+
+#include <dune/pybindxi/pybind11.h>
+#include <dune/pybindxi/stl.h>
+#include <dune/pybindxi/numpy.h>
+namespace py = pybind11;
+
+#include <config.h> // configuration file
+
+#include "richards_cyl_batch.hh" // independent of solverbase, no Dumux grid or assembler
+
+PYBIND11_MODULE(rosi_richards_cyl_batch, m) {
+    init_richards_cyl_batch(m, "RichardsCylBatch");
+}
+
+#endif
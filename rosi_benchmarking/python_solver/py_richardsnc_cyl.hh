@@ -15,6 +15,7 @@ namespace py = pybind11;
 
 #include <dumux/linear/amgbackend.hh>
 #include <dumux/assembly/fvassembler.hh>
+#include <dumux/common/profiledsolvers.hh> // zones of the Newton solver, if DUMUX_PROFILING
 
 #include <dumux/discretization/cctpfa.hh>
 #include <dumux/discretization/box.hh>
@@ -59,8 +60,8 @@ struct UseMoles<TypeTag, TTag::RichardsTT> { static constexpr bool value = false
  * pick assembler, linear solver and problem
  */
 using RCFoamTT = Dumux::Properties::TTag::RichardsNCCylFoamCC;
-using RichardsCylFoamAssembler = Dumux::FVAssembler<RCFoamTT, Dumux::DiffMethod::numeric>;
-using RichardsCylFoamLinearSolver = Dumux::AMGBackend<RCFoamTT>;
+using RichardsCylFoamAssembler = Dumux::ProfiledAssembler<Dumux::FVAssembler<RCFoamTT, Dumux::DiffMethod::numeric>>;
+using RichardsCylFoamLinearSolver = Dumux::ProfiledLinearSolver<Dumux::AMGBackend<RCFoamTT>>;
 using RichardsCylFoamProblem = Dumux::Richards1P2CProblem<RCFoamTT>;
 
 
@@ -4,10 +4,6 @@
 // most includes are in solverbase
 #include "solverbase.hh"
 
-#include <dumux/material/fluidmatrixinteractions/2p/regularizedvangenuchten.hh>
-// #include <dumux/material/fluidmatrixinteractions/2p/vangenuchten.hh>
-#include <dumux/material/fluidmatrixinteractions/2p/efftoabslaw.hh>
-
 // writeDumuxVTK
 #include <dumux/io/vtkoutputmodule.hh>
 
@@ -20,7 +16,7 @@ template<class Problem, class Assembler, class LinearSolver, int dim = 3>
 class Richards : public SolverBase<Problem, Assembler, LinearSolver, dim> {
 public:
 
-    using MaterialLaw = Dumux::EffToAbsLaw<Dumux::RegularizedVanGenuchten<double>>;
+    using MaterialLaw = typename Problem::SpatialParams::MaterialLaw; // (tabulated) van Genuchten law of the soil
     using MaterialLawParams = typename MaterialLaw::Params;
 
     virtual ~Richards() { }
@@ -128,9 +124,9 @@ public:
      * Gathering and mapping is done in Python
      */
     virtual std::vector<double> getSolutionHead(int eqIdx = 0) {
-        std::vector<double> sol = this->getSolution(eqIdx);
-        std::transform(sol.begin(), sol.end(), sol.begin(), std::bind1st(std::plus<double>(), -1.e5));
-        std::transform(sol.begin(), sol.end(), sol.begin(), std::bind1st(std::multiplies<double>(), 100. / 1.e3 / 9.81));
+        int n = this->checkInitialized();
+        std::vector<double> sol(n);
+        fillSolutionHead(sol.data(), eqIdx);
         return sol;
     }
 
@@ -143,50 +139,59 @@ public:
      * Gathering and mapping is done in Python
      */
     virtual std::vector<double> getWaterContent() {
-    	int n =  this->checkInitialized();
-        std::vector<double> theta;
-        theta.reserve(n);
-        for (const auto& element : Dune::elements(this->gridGeometry->gridView())) { // soil elements
-            double t = 0;
-            auto fvGeometry = Dumux::localView(*this->gridGeometry); // soil solution -> volume variable
-            fvGeometry.bindElement(element);
-            auto elemVolVars = Dumux::localView(this->gridVariables->curGridVolVars());
-            elemVolVars.bindElement(element, fvGeometry, this->x);
-            int c = 0;
-            for (const auto& scv : scvs(fvGeometry)) {
-                c++;
-                t += elemVolVars[scv].waterContent();
-            }
-            theta.push_back(t/c); // mean value
-        }
+    	this->checkInitialized();
+        std::vector<double> theta(this->gridGeometry->gridView().size(0));
+        fillWaterContent(theta.data());
         return theta;
     }
 
+    /**
+     * Writes the water content of each element of a single mpi process into @param theta
+     * (in the order of getCellIndices(), at least gridView().size(0) entries)
+     */
+    virtual void fillWaterContent(double* theta) {
+        if (this->isBox) {
+            fillVolVarMean_(theta, [](const auto& volVars) { return volVars.waterContent(); });
+        } else {
+            const auto& params = this->problem->spatialParams();
+            fillSaturation_(theta, [&](const auto& e, double sw) { return params.porosity(e) * sw; });
+        }
+    }
 
     /**
      * Returns the current solution for a single mpi process.
      * Gathering and mapping is done in Python
      */
     virtual std::vector<double> getSaturation() {
-    	int n =  this->checkInitialized();
-        std::vector<double> s;
-        s.reserve(n);
-        for (const auto& element : Dune::elements(this->gridGeometry->gridView())) { // soil elements
-            double t = 0;
-            auto fvGeometry = Dumux::localView(*this->gridGeometry); // soil solution -> volume variable
-            fvGeometry.bindElement(element);
-            auto elemVolVars = Dumux::localView(this->gridVariables->curGridVolVars());
-            elemVolVars.bindElement(element, fvGeometry, this->x);
-            int c = 0;
-            for (const auto& scv : scvs(fvGeometry)) {
-                c++;
-                t += elemVolVars[scv].saturation();
-            }
-            s.push_back(t/c); // mean value
-        }
+    	this->checkInitialized();
+        std::vector<double> s(this->gridGeometry->gridView().size(0));
+        fillSaturation(s.data());
         return s;
     }
 
+    /**
+     * Writes the saturation of each element of a single mpi process into @param s
+     * (in the order of getCellIndices(), at least gridView().size(0) entries)
+     */
+    virtual void fillSaturation(double* s) {
+        if (this->isBox) {
+            fillVolVarMean_(s, [](const auto& volVars) { return volVars.saturation(); });
+        } else {
+            fillSaturation_(s, [](const auto& e, double sw) { return sw; });
+        }
+    }
+
+    /**
+     * Writes the current solution of a single mpi process in cm pressure head into @param h
+     * (at least as many entries as dofs) @see getSolutionHead
+     */
+    virtual void fillSolutionHead(double* h, int eqIdx = 0) {
+        int n = this->checkInitialized();
+        for (int c = 0; c<n; c++) {
+            h[c] = (this->x[c][eqIdx] - 1.e5) * 100. / 1.e3 / 9.81;
+        }
+    }
+
     /**
      * Returns the total water volume [m3] within the domain
      */
@@ -215,16 +220,13 @@ public:
 		int n = this->checkInitialized();
 		std::vector<double> v;
 		v.resize(n);
-		for (const auto& e : Dune::elements(this->gridGeometry->gridView())) { // soil elements
+		auto faceFluxes = this->getBoundaryFluxes(0); // only boundary faces have a neumann flux
+		for (size_t i = 0; i < this->boundaryElements_.size(); i++) {
 			double f = 0.;
-			auto fvGeometry = Dumux::localView(*this->gridGeometry); // soil solution -> volume variable
-			fvGeometry.bindElement(e);
-			for (const auto& scvf : scvfs(fvGeometry)) {
-				auto elemVolVars = Dumux::localView(this->gridVariables->curGridVolVars());
-				elemVolVars.bindElement(e, fvGeometry, this->x);
-				f += this->problem->neumann(e, fvGeometry, elemVolVars, scvf)[0]/1000.; // [kg / (m2 s)] -> [m/s]
+			for (int j = this->boundaryFaceOffset_[i]; j < this->boundaryFaceOffset_[i+1]; j++) {
+				f += faceFluxes[j]/1000.; // [kg / (m2 s)] -> [m/s]
 			}
-			v[this->cellIdx->index(e)] = f;
+			v[this->boundaryCells_[i]] = f;
 		}
 		return v;
 	}
@@ -278,6 +280,51 @@ public:
 
 protected:
 
+    /**
+     * Writes the mean over the scvs of @param f (volVars) for each element into @param y,
+     * binding the element volume variables once per element
+     */
+    template<class F>
+    void fillVolVarMean_(double* y, const F& f) {
+        this->checkInitialized();
+        auto fvGeometry = Dumux::localView(*this->gridGeometry); // soil solution -> volume variable
+        auto elemVolVars = Dumux::localView(this->gridVariables->curGridVolVars());
+        int i = 0;
+        for (const auto& element : Dune::elements(this->gridGeometry->gridView())) { // soil elements
+            fvGeometry.bindElement(element);
+            elemVolVars.bindElement(element, fvGeometry, this->x);
+            double t = 0;
+            int c = 0;
+            for (const auto& scv : scvs(fvGeometry)) {
+                c++;
+                t += f(elemVolVars[scv]);
+            }
+            y[i++] = t/c; // mean value
+        }
+    }
+
+    /**
+     * Writes @param f (element, saturation) for each element into @param y (cell-centered),
+     * the saturations are evaluated at once per soil layer (see RichardsParams::saturations),
+     * equal to the ones of the volume variables
+     */
+    template<class F>
+    void fillSaturation_(double* y, const F& f) {
+        int n = this->checkInitialized();
+        pw_.resize(n);
+        for (int c = 0; c<n; c++) {
+            pw_[c] = this->x[c][0]; // water pressure [Pa]
+        }
+        this->problem->spatialParams().saturations(pw_, this->problem->nonWettingReferencePressure(), sw_);
+        int i = 0;
+        for (const auto& element : Dune::elements(this->gridGeometry->gridView())) { // soil elements
+            y[i++] = f(element, sw_[this->gridGeometry->elementMapper().index(element)]);
+        }
+    }
+
+    std::vector<double> pw_; // water pressures of fillSaturation_, kept to avoid allocations
+    std::vector<double> sw_; // saturations of fillSaturation_
+
     std::vector<double> cellVolume;
 
     using SolutionVector = typename Problem::SolutionVector;
@@ -314,6 +361,13 @@ void init_richardssp(py::module &m, std::string name) {
    .def("getSolutionHeadAt", &RichardsSP::getSolutionHeadAt, py::arg("gIdx"), py::arg("eqIdx") = 0)
    .def("getWaterContent",&RichardsSP::getWaterContent)
    .def("getSaturation",&RichardsSP::getSaturation)
+   // derived fields written into caller supplied (contiguous float64) arrays, single mpi process
+   .def("fillWaterContent", [](RichardsSP& r, py::array_t<double, py::array::c_style> a) {
+       r.fillWaterContent(writeableData(a, r.numberOfLocalCells())); }, py::arg("theta").noconvert())
+   .def("fillSaturation", [](RichardsSP& r, py::array_t<double, py::array::c_style> a) {
+       r.fillSaturation(writeableData(a, r.numberOfLocalCells())); }, py::arg("s").noconvert())
+   .def("fillSolutionHead", [](RichardsSP& r, py::array_t<double, py::array::c_style> a, int eqIdx) {
+       r.fillSolutionHead(writeableData(a, r.checkInitialized()), eqIdx); }, py::arg("h").noconvert(), py::arg("eqIdx") = 0)
    .def("getWaterVolume",&RichardsSP::getWaterVolume)
    .def("getVelocity1D", &RichardsSP::getVelocity1D)
    .def("writeDumuxVTK",&RichardsSP::writeDumuxVTK)
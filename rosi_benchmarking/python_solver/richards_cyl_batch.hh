@@ -0,0 +1,619 @@
+#ifndef PYTHON_RICHARDS_CYL_BATCH_SOLVER_H_
+#define PYTHON_RICHARDS_CYL_BATCH_SOLVER_H_
+
+#include <dumux/common/threadpool.hh>
+
+#include <dune/pybindxi/pybind11.h>
+#include <dune/pybindxi/stl.h>
+namespace py = pybind11;
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Solves Richards equation for a batch of N axially symmetric 1D (cylindrical) models,
+ * e.g. one rhizosphere model per root segment.
+ *
+ * Replaces N instances of RichardsCyl (or of the Python FVRichards1D) by a single object.
+ * The discretisation follows FVRichards1D (fv_richards.py): cell centered finite volumes,
+ * implicit Euler, hydraulic conductivities of the last time step (harmonic mean),
+ * Mualem - van Genuchten soil. Each time step is solved with Newton's method,
+ * the Jacobian is tridiagonal and solved with the Thomas algorithm.
+ *
+ * All cylinders have the same number of cells, but individual radii, lengths, and soils.
+ * The data is stored as structure of arrays with index [cell * N + cylinder], so all loops run over
+ * the cylinders in the innermost loop. The cylinders are split into chunks of chunkSize cylinders.
+ * A chunk shares the Newton loop and the time step control, and the chunks are distributed over a
+ * thread pool. Results do not depend on the number of threads.
+ *
+ * Units are the ones of the Python solvers: [cm], [day], pressure head [cm]
+ */
+class RichardsCylBatch {
+public:
+
+    int numThreads = 0; // number of threads, 0 uses all hardware threads
+    int chunkSize = 64; // number of cylinders sharing one Newton loop
+    double criticalPressure = -15000.; // [cm] limits the inner and outer flux boundary conditions
+    double newtonTolerance = 1.e-8; // [cm] maximal change of the pressure head in the last Newton iteration
+    int maxIterations = 25; // maximal Newton iterations per time step
+    double ddt = -1.; // [day] initial internal time step, per default dt / 10
+
+    double simTime = 0.; // [day]
+    long newtonIterations = 0; // accumulated Newton iterations of all chunks
+    long timeSteps = 0; // accumulated successful time steps of all chunks
+    double solveTime = 0.; // [s] accumulated wall time of solve()
+
+    virtual ~RichardsCylBatch() { }
+
+    /**
+     * Sets the van Genuchten parameter sets of the soils,
+     * each given as [theta_r, theta_s, alpha [1/cm], n, Ksat [cm/day]]
+     */
+    void setVGParameters(const std::vector<std::vector<double>>& soils) {
+        soils_.clear();
+        for (const auto& p : soils) {
+            if (p.size() != 5) {
+                throw std::invalid_argument("RichardsCylBatch::setVGParameters: each soil needs [theta_r, theta_s, alpha, n, Ksat]");
+            }
+            soils_.push_back(VanGenuchten { p[0], p[1], p[2], p[3], 1. - 1. / p[3], p[4] });
+        }
+    }
+
+    /**
+     * Creates the grids, row c of @param points are the radial nodes of cylinder c [cm] (increasing),
+     * all rows must have the same length.
+     *
+     * @param lengths       lengths of the cylinders (i.e. root segments) [cm], per default 1 cm
+     *
+     * Resets initial values to zero, boundary conditions to no flux, and all cylinders to soil 0
+     */
+    void createGrids(const std::vector<std::vector<double>>& points, std::vector<double> lengths = std::vector<double>(0)) {
+        size_t nc = points.size();
+        if (nc == 0 || points[0].size() < 3) {
+            throw std::invalid_argument("RichardsCylBatch::createGrids: need at least one cylinder with two cells");
+        }
+        if (lengths.empty()) {
+            lengths.resize(nc, 1.);
+        }
+        if (lengths.size() != nc) {
+            throw std::invalid_argument("RichardsCylBatch::createGrids: number of lengths and cylinders differ");
+        }
+        N_ = nc;
+        n_ = points[0].size() - 1;
+        vol_.resize(n_ * N_);
+        faceT_.resize((n_ - 1) * N_);
+        innerA_.resize(N_);
+        innerDx_.resize(N_);
+        outerA_.resize(N_);
+        outerDx_.resize(N_);
+        extrapolate_.resize(N_);
+        for (size_t c = 0; c < N_; c++) {
+            const auto& r = points[c];
+            if (r.size() != n_ + 1) {
+                throw std::invalid_argument("RichardsCylBatch::createGrids: all cylinders need the same number of nodes");
+            }
+            for (size_t i = 0; i < n_; i++) {
+                if (r[i + 1] <= r[i]) {
+                    throw std::invalid_argument("RichardsCylBatch::createGrids: nodes must be increasing");
+                }
+                vol_[i * N_ + c] = M_PI * (r[i + 1] * r[i + 1] - r[i] * r[i]);
+            }
+            for (size_t i = 0; i < n_ - 1; i++) { // face between cell i and i+1
+                double dx = 0.5 * (r[i + 2] - r[i]); // distance of the cell centers
+                faceT_[i * N_ + c] = 2 * M_PI * r[i + 1] / dx;
+            }
+            innerA_[c] = 2 * M_PI * r[0];
+            innerDx_[c] = 0.5 * (r[1] - r[0]);
+            outerA_[c] = 2 * M_PI * r[n_];
+            outerDx_[c] = 0.5 * (r[n_] - r[n_ - 1]);
+            extrapolate_[c] = innerDx_[c] / (0.5 * (r[2] - r[0])); // dx0 / dx1 (see getInnerHead)
+        }
+        length_ = lengths;
+        soilIdx_.assign(N_, 0);
+        h_.assign(n_ * N_, 0.);
+        innerType_.assign(N_, fluxBC);
+        innerValue_.assign(N_, 0.);
+        innerKr_.assign(N_, 0.);
+        outerFlux_.assign(N_, 0.);
+        innerFlux_.assign(N_, 0.);
+        chunkDdt_.clear();
+        simTime = 0.;
+    }
+
+    /**
+     * Sets the soil (index into the parameter sets of setVGParameters) of each cylinder
+     */
+    void setSoilIndices(const std::vector<int>& indices) {
+        checkSize_(indices.size(), "setSoilIndices");
+        for (int i : indices) {
+            if (i < 0 || i >= int(soils_.size())) {
+                throw std::invalid_argument("RichardsCylBatch::setSoilIndices: soil index out of range");
+            }
+        }
+        soilIdx_ = indices;
+    }
+
+    /**
+     * Sets the initial pressure head [cm], either one value per cylinder (size N),
+     * or per cylinder and cell (size N * number of cells, cylinder by cylinder)
+     */
+    void setInitialHead(const std::vector<double>& h) {
+        if (h.size() == N_) {
+            for (size_t i = 0; i < n_; i++) {
+                std::copy(h.begin(), h.end(), h_.begin() + i * N_);
+            }
+        } else if (h.size() == N_ * n_) {
+            for (size_t c = 0; c < N_; c++) {
+                for (size_t i = 0; i < n_; i++) {
+                    h_[i * N_ + c] = h[c * n_ + i];
+                }
+            }
+        } else {
+            throw std::invalid_argument("RichardsCylBatch::setInitialHead: wrong size");
+        }
+        innerFlux_.assign(N_, 0.);
+    }
+
+    /**
+     * Sets a flux boundary condition at the inner boundary (root surface) [cm/day], positive values enter the cylinder.
+     * The flux is limited, so that the pressure head stays above criticalPressure (outflow), and below zero (inflow).
+     */
+    void setInnerFlux(const std::vector<double>& q) {
+        checkSize_(q.size(), "setInnerFlux");
+        innerType_.assign(N_, fluxBC);
+        innerValue_ = q;
+    }
+
+    /**
+     * Sets the pressure head at the inner boundary (root surface) [cm], e.g. the root xylem pressure.
+     * The flux is K/dx * (h - h0), where K is the soil hydraulic conductivity, and dx the half width of the first cell.
+     * If a radial root conductivity @param kr [1/day] is given, the conductance is min(kr, K/dx), like
+     * the "rootsystem" boundary condition of FVRichards1D.
+     */
+    void setInnerHead(const std::vector<double>& h, const std::vector<double>& kr = std::vector<double>(0)) {
+        checkSize_(h.size(), "setInnerHead");
+        innerType_.assign(N_, headBC);
+        innerValue_ = h;
+        if (kr.empty()) {
+            innerKr_.assign(N_, 0.);
+        } else {
+            checkSize_(kr.size(), "setInnerHead");
+            innerKr_ = kr;
+        }
+    }
+
+    /**
+     * Sets a flux boundary condition at the outer boundary [cm/day], positive values enter the cylinder,
+     * limited like the inner flux
+     */
+    void setOuterFlux(const std::vector<double>& q) {
+        checkSize_(q.size(), "setOuterFlux");
+        outerFlux_ = q;
+    }
+
+    /**
+     * Simulates all cylinders for the time span @param dt [day]
+     */
+    void solve(double dt) {
+        if (N_ == 0 || soils_.empty()) {
+            throw std::invalid_argument("RichardsCylBatch::solve: call setVGParameters and createGrids first");
+        }
+        auto start = std::chrono::steady_clock::now();
+        int threads = (numThreads > 0) ? numThreads : std::max(int(std::thread::hardware_concurrency()), 1);
+        if (!pool_ || pool_->size() != threads) {
+            pool_ = std::make_unique<Dumux::ThreadPool>(threads);
+        }
+        size_t cs = std::max(chunkSize, 1);
+        size_t numChunks = (N_ + cs - 1) / cs;
+        if (chunkDdt_.size() != numChunks) {
+            chunkDdt_.assign(numChunks, (ddt > 0) ? ddt : dt / 10.);
+        }
+        std::vector<long> iterations(numChunks, 0);
+        std::vector<long> steps(numChunks, 0);
+        pool_->parallelFor(int(numChunks), [&](int k) {
+            size_t c0 = k * cs;
+            size_t c1 = std::min(c0 + cs, N_);
+            solveChunk_(k, c0, c1, dt, iterations[k], steps[k]);
+        });
+        for (size_t k = 0; k < numChunks; k++) {
+            newtonIterations += iterations[k];
+            timeSteps += steps[k];
+        }
+        simTime += dt;
+        solveTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Realized flux at the inner boundary (root surface) [cm/day], averaged over the last call of solve,
+     * positive values enter the cylinder. Multiply by 2 pi r_in l to obtain [cm3/day].
+     */
+    std::vector<double> getInnerFlux() const {
+        return innerFlux_;
+    }
+
+    /**
+     * Pressure head at the inner boundary (root surface) [cm], linearly extrapolated from the first two cells
+     */
+    std::vector<double> getInnerHead() const {
+        std::vector<double> hs(N_);
+        for (size_t c = 0; c < N_; c++) {
+            double h0 = h_[c];
+            double h1 = h_[N_ + c];
+            hs[c] = h0 - (h1 - h0) * extrapolate_[c];
+        }
+        return hs;
+    }
+
+    /**
+     * Water volume of each cylinder [cm3]
+     */
+    std::vector<double> getWaterVolume() const {
+        std::vector<double> v(N_, 0.);
+        for (size_t i = 0; i < n_; i++) {
+            for (size_t c = 0; c < N_; c++) {
+                v[c] += soils_[soilIdx_[c]].theta(h_[i * N_ + c]) * vol_[i * N_ + c];
+            }
+        }
+        for (size_t c = 0; c < N_; c++) {
+            v[c] *= length_[c];
+        }
+        return v;
+    }
+
+    /**
+     * Pressure head [cm] of all cells, cylinder by cylinder (size N * number of cells)
+     */
+    std::vector<double> getSolutionHead() const {
+        std::vector<double> h(N_ * n_);
+        for (size_t c = 0; c < N_; c++) {
+            for (size_t i = 0; i < n_; i++) {
+                h[c * n_ + i] = h_[i * N_ + c];
+            }
+        }
+        return h;
+    }
+
+    /**
+     * Water content [1] of all cells, cylinder by cylinder (size N * number of cells)
+     */
+    std::vector<double> getWaterContent() const {
+        std::vector<double> theta(N_ * n_);
+        for (size_t c = 0; c < N_; c++) {
+            for (size_t i = 0; i < n_; i++) {
+                theta[c * n_ + i] = soils_[soilIdx_[c]].theta(h_[i * N_ + c]);
+            }
+        }
+        return theta;
+    }
+
+    int numberOfCylinders() const {
+        return int(N_);
+    }
+
+    int numberOfCells() const {
+        return int(n_);
+    }
+
+    /**
+     * Quick overview
+     */
+    std::string toString() const {
+        std::ostringstream msg;
+        msg << "RichardsCylBatch with " << N_ << " cylinders of " << n_ << " cells, " << soils_.size() << " soil(s)";
+        if (simTime > 0) {
+            msg << "\nSimulation time is " << simTime << " days, " << timeSteps << " time steps and " << newtonIterations
+                << " Newton iterations (summed over chunks of " << chunkSize << " cylinders), solve took " << solveTime << " s";
+        }
+        return msg.str();
+    }
+
+protected:
+
+    //! Mualem - van Genuchten model, see van_genuchten.py
+    struct VanGenuchten {
+        double thetaR, thetaS, alpha, n, m, Ks;
+
+        //! effective saturation [1] at pressure head h [cm]
+        double se(double h) const {
+            return (h >= 0.) ? 1. : std::pow(1. + std::pow(alpha * (-h), n), -m);
+        }
+
+        //! water content [1]
+        double theta(double h) const {
+            return thetaR + (thetaS - thetaR) * se(h);
+        }
+
+        //! water content [1] and specific moisture storage [1/cm], sharing the powers
+        void thetaCapacity(double h, double& theta, double& c) const {
+            if (h >= 0.) {
+                theta = thetaS;
+                c = 0.;
+                return;
+            }
+            double ah = alpha * (-h);
+            double ahn = std::pow(ah, n);
+            double base = 1. + ahn;
+            double se = std::pow(base, -m);
+            theta = thetaR + (thetaS - thetaR) * se;
+            c = (thetaS - thetaR) * m * n * alpha * (ahn / ah) * (se / base);
+        }
+
+        //! hydraulic conductivity [cm/day]
+        double k(double h) const {
+            double s = se(h);
+            double a = 1. - std::pow(1. - std::pow(s, 1. / m), m);
+            return Ks * std::sqrt(s) * a * a;
+        }
+    };
+
+    static constexpr char fluxBC = 0;
+    static constexpr char headBC = 1;
+
+    /**
+     * Solves the cylinders [c0, c1) of chunk k for the time span dt, with shared time step control
+     */
+    void solveChunk_(size_t k, size_t c0, size_t c1, double dt, long& iterations, long& steps) {
+        const size_t m = c1 - c0;
+        std::vector<double> hOld(n_ * m), thetaOld(n_ * m), kFace((n_ - 1) * m), kIn(m), kOut(m);
+        std::vector<double> diag(n_ * m), res(n_ * m), qIn(m), qSum(m, 0.);
+
+        double t = 0.;
+        double step = chunkDdt_[k];
+        while (t < dt * (1. - 1.e-12)) {
+            double cdt = std::min(step, dt - t);
+
+            // values of the last time step
+            for (size_t i = 0; i < n_; i++) {
+                for (size_t j = 0; j < m; j++) {
+                    size_t c = c0 + j;
+                    const auto& s = soils_[soilIdx_[c]];
+                    double h = h_[i * N_ + c];
+                    hOld[i * m + j] = h;
+                    thetaOld[i * m + j] = s.theta(h);
+                    diag[i * m + j] = s.k(h); // temporary storage of the cell conductivities
+                }
+            }
+            for (size_t i = 0; i < n_ - 1; i++) {
+                for (size_t j = 0; j < m; j++) {
+                    double ka = diag[i * m + j];
+                    double kb = diag[(i + 1) * m + j];
+                    double kh = (ka + kb > 0.) ? 2. * ka * kb / (ka + kb) : 0.;
+                    kFace[i * m + j] = kh * faceT_[i * N_ + c0 + j];
+                }
+            }
+            for (size_t j = 0; j < m; j++) {
+                kIn[j] = diag[j] / innerDx_[c0 + j];
+                kOut[j] = diag[(n_ - 1) * m + j] / outerDx_[c0 + j];
+            }
+
+            bool converged = false;
+            int it = 0;
+            while (it < maxIterations && !converged) {
+                it++;
+                assemble_(c0, m, cdt, thetaOld, kFace, kIn, kOut, diag, res, qIn);
+                double maxDh = thomas_(c0, m, cdt, kFace, diag, res);
+                if (!std::isfinite(maxDh)) {
+                    break;
+                }
+                converged = (maxDh < newtonTolerance);
+            }
+            iterations += it;
+
+            if (converged) {
+                assemble_(c0, m, cdt, thetaOld, kFace, kIn, kOut, diag, res, qIn); // realized fluxes of the new solution
+                for (size_t j = 0; j < m; j++) {
+                    qSum[j] += qIn[j] * cdt;
+                }
+                t += cdt;
+                steps++;
+                if (cdt == step) {
+                    step = (it < 5) ? step * 1.25 : step / 1.25;
+                }
+            } else { // retry with smaller time step
+                for (size_t i = 0; i < n_; i++) {
+                    std::copy(hOld.begin() + i * m, hOld.begin() + (i + 1) * m, h_.begin() + i * N_ + c0);
+                }
+                step = cdt / 4.;
+                if (step < dt * 1.e-10) {
+                    throw std::runtime_error("RichardsCylBatch::solve: no convergence for cylinders " + std::to_string(c0) + " to " + std::to_string(c1 - 1));
+                }
+            }
+        }
+        chunkDdt_[k] = step;
+        for (size_t j = 0; j < m; j++) {
+            innerFlux_[c0 + j] = qSum[j] / dt;
+        }
+    }
+
+    /**
+     * Assembles the Newton residual (res) and the Jacobian diagonal (diag) for the current solution h_,
+     * the off diagonal entries are -dt * kFace. qIn is the inner boundary flux [cm/day].
+     */
+    void assemble_(size_t c0, size_t m, double dt, const std::vector<double>& thetaOld, const std::vector<double>& kFace,
+        const std::vector<double>& kIn, const std::vector<double>& kOut, std::vector<double>& diag, std::vector<double>& res,
+        std::vector<double>& qIn) const {
+
+        // storage
+        for (size_t i = 0; i < n_; i++) {
+            for (size_t j = 0; j < m; j++) {
+                size_t c = c0 + j;
+                const auto& s = soils_[soilIdx_[c]];
+                double h = h_[i * N_ + c];
+                double v = vol_[i * N_ + c];
+                double theta, cap;
+                s.thetaCapacity(h, theta, cap);
+                res[i * m + j] = v * (theta - thetaOld[i * m + j]);
+                diag[i * m + j] = v * cap;
+            }
+        }
+        // fluxes over inner faces
+        for (size_t i = 0; i < n_ - 1; i++) {
+            for (size_t j = 0; j < m; j++) {
+                double kf = dt * kFace[i * m + j];
+                double f = kf * (h_[(i + 1) * N_ + c0 + j] - h_[i * N_ + c0 + j]);
+                res[i * m + j] -= f;
+                res[(i + 1) * m + j] += f;
+                diag[i * m + j] += kf;
+                diag[(i + 1) * m + j] += kf;
+            }
+        }
+        // boundary fluxes
+        size_t last = (n_ - 1) * m;
+        for (size_t j = 0; j < m; j++) {
+            size_t c = c0 + j;
+            double dq;
+            if (innerType_[c] == headBC) {
+                double kc = (innerKr_[c] > 0.) ? std::min(innerKr_[c], kIn[j]) : kIn[j];
+                qIn[j] = kc * (innerValue_[c] - h_[c]);
+                dq = -kc;
+            } else {
+                qIn[j] = limitedFlux_(innerValue_[c], h_[c], kIn[j], dq);
+            }
+            res[j] -= dt * innerA_[c] * qIn[j];
+            diag[j] -= dt * innerA_[c] * dq;
+            double qOut = limitedFlux_(outerFlux_[c], h_[(n_ - 1) * N_ + c], kOut[j], dq);
+            res[last + j] -= dt * outerA_[c] * qOut;
+            diag[last + j] -= dt * outerA_[c] * dq;
+        }
+    }
+
+    /**
+     * Solves the tridiagonal systems for the Newton update, updates h_, and returns the maximal update
+     * (diag and res are overwritten)
+     */
+    double thomas_(size_t c0, size_t m, double dt, const std::vector<double>& kFace, std::vector<double>& diag, std::vector<double>& res) {
+        for (size_t i = 1; i < n_; i++) { // forward elimination, off diagonal entries are -dt * kFace
+            for (size_t j = 0; j < m; j++) {
+                double off = -dt * kFace[(i - 1) * m + j];
+                double w = off / diag[(i - 1) * m + j];
+                diag[i * m + j] -= w * off;
+                res[i * m + j] -= w * res[(i - 1) * m + j];
+            }
+        }
+        double maxDh = 0.;
+        for (size_t j = 0; j < m; j++) { // backward substitution, the update is -res
+            res[(n_ - 1) * m + j] /= diag[(n_ - 1) * m + j];
+        }
+        for (size_t i = n_ - 1; i-- > 0;) {
+            for (size_t j = 0; j < m; j++) {
+                double off = -dt * kFace[i * m + j];
+                res[i * m + j] = (res[i * m + j] - off * res[(i + 1) * m + j]) / diag[i * m + j];
+            }
+        }
+        for (size_t i = 0; i < n_; i++) {
+            for (size_t j = 0; j < m; j++) {
+                double dh = res[i * m + j];
+                h_[i * N_ + c0 + j] -= dh;
+                maxDh = std::max(maxDh, std::fabs(dh));
+                if (!std::isfinite(dh)) {
+                    maxDh = dh;
+                }
+            }
+        }
+        return maxDh;
+    }
+
+    /**
+     * Flux q [cm/day] limited to criticalPressure for outflow and to saturation for inflow,
+     * k is the conductance [1/day], dq returns the derivative with respect to the cell pressure head h
+     */
+    double limitedFlux_(double q, double h, double k, double& dq) const {
+        dq = 0.;
+        if (q < 0.) {
+            double maxQ = k * (criticalPressure - h); // maximal possible outflux
+            if (maxQ > 0.) {
+                return 0.;
+            }
+            if (q < maxQ) {
+                dq = -k;
+                return maxQ;
+            }
+        } else if (q > 0.) {
+            double maxQ = k * (0. - h); // maximal possible influx
+            if (maxQ < 0.) {
+                return 0.;
+            }
+            if (q > maxQ) {
+                dq = -k;
+                return maxQ;
+            }
+        }
+        return q;
+    }
+
+    void checkSize_(size_t size, std::string method) const {
+        if (size != N_) {
+            throw std::invalid_argument("RichardsCylBatch::" + method + ": expected one value per cylinder");
+        }
+    }
+
+    size_t N_ = 0; // number of cylinders
+    size_t n_ = 0; // number of cells per cylinder
+
+    std::vector<VanGenuchten> soils_;
+    std::vector<int> soilIdx_; // per cylinder
+
+    std::vector<double> h_; // pressure head [cm], [cell * N + cylinder]
+    std::vector<double> vol_; // cell volume per length [cm2], [cell * N + cylinder]
+    std::vector<double> faceT_; // face area per length divided by the distance of the cell centers [1], [face * N + cylinder]
+    std::vector<double> innerA_, outerA_; // boundary face area per length [cm]
+    std::vector<double> innerDx_, outerDx_; // half width of the boundary cells [cm]
+    std::vector<double> extrapolate_; // dx0 / dx1 for extrapolation to the inner boundary
+    std::vector<double> length_; // [cm]
+
+    std::vector<char> innerType_; // fluxBC or headBC
+    std::vector<double> innerValue_; // [cm/day] or [cm]
+    std::vector<double> innerKr_; // [1/day]
+    std::vector<double> outerFlux_; // [cm/day]
+    std::vector<double> innerFlux_; // realized inner flux of the last solve [cm/day]
+
+    std::vector<double> chunkDdt_; // last internal time step of each chunk [day]
+    std::unique_ptr<Dumux::ThreadPool> pool_;
+
+};
+
+/**
+ * pybind11
+ */
+inline void init_richards_cyl_batch(py::module &m, std::string name) {
+    using Batch = RichardsCylBatch;
+	py::class_<Batch>(m, name.c_str())
+   .def(py::init<>())
+   .def("setVGParameters", &Batch::setVGParameters)
+   .def("createGrids", &Batch::createGrids, py::arg("points"), py::arg("lengths") = std::vector<double>(0))
+   .def("setSoilIndices", &Batch::setSoilIndices)
+   .def("setInitialHead", &Batch::setInitialHead)
+   .def("setInnerFlux", &Batch::setInnerFlux)
+   .def("setInnerHead", &Batch::setInnerHead, py::arg("h"), py::arg("kr") = std::vector<double>(0))
+   .def("setOuterFlux", &Batch::setOuterFlux)
+   .def("solve", &Batch::solve, py::call_guard<py::gil_scoped_release>())
+
+   .def("getInnerFlux", &Batch::getInnerFlux)
+   .def("getInnerHead", &Batch::getInnerHead)
+   .def("getWaterVolume", &Batch::getWaterVolume)
+   .def("getSolutionHead", &Batch::getSolutionHead)
+   .def("getWaterContent", &Batch::getWaterContent)
+   .def("numberOfCylinders", &Batch::numberOfCylinders)
+   .def("numberOfCells", &Batch::numberOfCells)
+   .def("__str__",&Batch::toString)
+
+   .def_readwrite("numThreads", &Batch::numThreads)
+   .def_readwrite("chunkSize", &Batch::chunkSize)
+   .def_readwrite("criticalPressure", &Batch::criticalPressure)
+   .def_readwrite("newtonTolerance", &Batch::newtonTolerance)
+   .def_readwrite("maxIterations", &Batch::maxIterations)
+   .def_readwrite("ddt", &Batch::ddt)
+   .def_readonly("simTime", &Batch::simTime)
+   .def_readonly("newtonIterations", &Batch::newtonIterations)
+   .def_readonly("timeSteps", &Batch::timeSteps)
+   .def_readonly("solveTime", &Batch::solveTime);
+}
+
+#endif
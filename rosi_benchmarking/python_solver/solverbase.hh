@@ -5,6 +5,7 @@
 #include <dune/common/parallel/mpihelper.hh> // in dune parallelization is realized with MPI
 #include <dumux/common/dumuxmessage.hh> // for fun (a static class)
 #include <dumux/common/parameters.hh> // global parameter tree with defaults and parsed from args and .input file
+#include <dumux/common/profiler.hh> // DUMUX_PROFILE_ZONE, for the calls from Python
 
 // createGrid
 #include <dumux/io/grid/gridmanager.hh>
@@ -14,6 +15,7 @@
 #include <dumux/common/timeloop.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 #include <dumux/porousmediumflow/richards/newtonsolver.hh>
+#include <dune/common/timer.hh>
 
 // getDofIndices, getPointIndices, getCellIndices
 #include <dune/grid/utility/globalindexset.hh>
@@ -26,6 +28,31 @@
 #include <iostream>
 #include <limits>
 #include <array>
+#include <algorithm>
+#include <memory>
+
+/**
+ * Wraps memory as read-only numpy array without copying,
+ * the array holds a copy of @param owner (e.g. a shared pointer to the memory) as long as it exists
+ */
+template<class Owner>
+inline py::array_t<double> readOnlyView(const double* data, size_t rows, size_t cols, Owner owner) {
+    py::capsule base(new Owner(std::move(owner)), [](void* o) { delete static_cast<Owner*>(o); });
+    py::array_t<double> a({ rows, cols }, { cols*sizeof(double), sizeof(double) }, data, base);
+    a.attr("setflags")(py::arg("write") = false);
+    return a;
+}
+
+/**
+ * Returns the data of a caller supplied array, that has to have at least @param n entries
+ * (pass the array with noconvert(), otherwise pybind11 might write into a temporary copy)
+ */
+inline double* writeableData(py::array_t<double, py::array::c_style>& a, size_t n) {
+    if (size_t(a.size()) < n) {
+        throw std::invalid_argument("writeableData: the array is smaller than the number of local elements or dofs");
+    }
+    return a.mutable_data();
+}
 
 /**
  * Derived class will pass ownership
@@ -68,6 +95,13 @@ public:
     bool periodic = false; // periodic domain
     std::array<int, dim> numberOfCells;
 
+    bool persistentSolver = false; // keep time loop, assembler, linear and nonlinear solver between calls of solve()
+    double setupTime = 0.; // accumulated wall time [s] of solve() spent for creating (or resetting) the solvers
+    double solveTime = 0.; // accumulated wall time [s] of solve() spent within the time loop
+    int solveCalls = 0; // number of calls of solve()
+
+    bool pickCache = false; // pickCells() reuses the cells of points that were already picked in the last call
+
     SolverBase() {
         for (int i=0; i<dim; i++) { // initialize numberOfCells
             numberOfCells[i] = 0;
@@ -124,6 +158,7 @@ public:
      * Grid.Overlap (should = 0 for box, = 1 for CCTpfa), automatically set in SolverBase::initialize
      */
     virtual void createGrid(std::string modelParamGroup = "") {
+        DUMUX_PROFILE_ZONE("python createGrid");
         std::string pstr =  Dumux::getParam<std::string>("Grid.Periodic", "");
         periodic = ((pstr.at(0)=='t') || (pstr.at(0)=='T')); // always x,y, not z
         GridManagerFix<Grid> gridManager;
@@ -297,9 +332,15 @@ public:
      * i.e. can be analyzed using getSolution().
      */
     virtual void initializeProblem() {
+        DUMUX_PROFILE_ZONE("python initializeProblem");
+        size_t dof = gridGeometry->numDofs();
+        if ((x.size() != dof) && (solutionViews_.use_count() > 1)) { // check before anything is changed
+            throw std::invalid_argument("SolverBase::initializeProblem: the number of dofs changed, while views of the solution exist (delete them first)");
+        }
         problem = std::make_shared<Problem>(gridGeometry);
-        int dof = gridGeometry->numDofs();
-        x = SolutionVector(dof);
+        if (x.size() != dof) {
+            x = SolutionVector(dof);
+        } // otherwise x keeps its memory, i.e. the solution views stay valid
 
         problem->applyInitialSolution(x); // Dumux way of saying x = problem->applyInitialSolution()
 
@@ -308,9 +349,13 @@ public:
 
         simTime = 0; // reset
         ddt = -1;
+        resetSolver(); // the solvers refer to the old problem and grid variables
+        clearPickCache(); // the grid might have changed
 
         pointIdx = std::make_shared<Dune::GlobalIndexSet<GridView>>(grid->leafGridView(), dim); // global index mappers
         cellIdx = std::make_shared<Dune::GlobalIndexSet<GridView>>(grid->leafGridView(), 0);
+        updateBoundaryFaces_(); // uses cellIdx
+        updateGeometry_();
 
         localCellIdx.clear();
         for (const auto& e : Dune::elements(gridGeometry->gridView())) {
@@ -364,31 +409,39 @@ public:
      * Simulates the problem for time span dt, with maximal time step maxDt.
      *
      * Assembler needs a TimeLoop, so i have to create it in each solve call.
-     * (could be improved, but overhead is likely to be small)
+     * If persistentSolver is set, the time loop is only reset, and the assembler (with its Jacobian pattern),
+     * the linear solver (with its parallel index information), and the nonlinear solver are kept,
+     * i.e. they are created only in the first call after initializeProblem().
+     * The time spent in set up and solution is accumulated in setupTime and solveTime.
      */
     virtual void solve(double dt, double maxDt = -1) {
+        DUMUX_PROFILE_ZONE("python solve");
         checkInitialized();
         using namespace Dumux;
 
+        Dune::Timer setupTimer;
         if (ddt<1.e-6) { // happens at the first call
             ddt = getParam<double>("TimeLoop.DtInitial", dt/10); // from params, or guess something
         }
 
-        std::shared_ptr<CheckPointTimeLoop<double>> timeLoop =
-            std::make_shared<CheckPointTimeLoop<double>>(/*start time*/0., ddt, /*final time*/ dt, false); // the main time loop is moved to Python
+        if (persistentSolver && nonLinearSolver) {
+            timeLoop->reset(/*start time*/0., ddt, /*final time*/ dt, false);
+        } else {
+            timeLoop = std::make_shared<CheckPointTimeLoop<double>>(/*start time*/0., ddt, /*final time*/ dt, false); // the main time loop is moved to Python
+            assembler = std::make_shared<Assembler>(problem, gridGeometry, gridVariables, timeLoop); // dynamic
+            linearSolver = std::make_shared<LinearSolver>(gridGeometry->gridView(), gridGeometry->dofMapper());
+            nonLinearSolver = std::make_shared<NonLinearSolver>(assembler, linearSolver);
+            nonLinearSolver->setVerbose(false);
+        }
         if (maxDt<0) { // per default value take from parameter tree
             maxDt = getParam<double>("TimeLoop.MaxTimeStepSize", dt); // if none, default is outer time step
         }
         timeLoop->setMaxTimeStepSize(maxDt);
+        xOld = x; // no reallocation, if the size did not change
+        setupTime += setupTimer.elapsed();
 
-        auto assembler = std::make_shared<Assembler>(problem, gridGeometry, gridVariables, timeLoop); // dynamic
-        auto linearSolver = std::make_shared<LinearSolver>(gridGeometry->gridView(), gridGeometry->dofMapper());
-        using NonLinearSolver = RichardsNewtonSolver<Assembler, LinearSolver>;
-        auto nonLinearSolver = std::make_shared<NonLinearSolver>(assembler, linearSolver);
-        nonLinearSolver->setVerbose(false);
-
+        Dune::Timer solveTimer;
         timeLoop->start();
-        auto xOld = x;
         do {
             ddt = nonLinearSolver->suggestTimeStepSize(timeLoop->timeStepSize());
             ddt = std::max(ddt, 1.); // limit minimal suggestion
@@ -407,16 +460,33 @@ public:
             timeLoop->reportTimeStep(); // report statistics of this time step
 
         } while (!timeLoop->finished());
+        solveTime += solveTimer.elapsed();
+        solveCalls++;
 
+        if (!persistentSolver) {
+            resetSolver();
+        }
         simTime += dt;
     }
 
+    /**
+     * Releases the time loop, assembler, linear and nonlinear solver kept by solve(),
+     * needed if the problem or the grid was changed (called by initializeProblem())
+     */
+    virtual void resetSolver() {
+        nonLinearSolver = nullptr;
+        linearSolver = nullptr;
+        assembler = nullptr;
+        timeLoop = nullptr;
+    }
+
     /**
      * Finds the steady state of the problem.
      *
      * Optionally, solve for a time span first, to get a good initial guess.
      */
     virtual void solveSteadyState() {
+        DUMUX_PROFILE_ZONE("python solveSteadyState");
         checkInitialized();
         using namespace Dumux;
 
@@ -438,17 +508,7 @@ public:
      */
     virtual std::vector<VectorType> getPoints() {
         checkInitialized();
-        std::vector<VectorType> points;
-        points.reserve(gridGeometry->gridView().size(dim));
-        for (const auto& v : vertices(gridGeometry->gridView())) {
-            auto p = v.geometry().center();
-            VectorType vp;
-            for (int i=0; i<dim; i++) { // found no better way
-                vp[i] = p[i];
-            }
-            points.push_back(vp);
-        }
-        return points;
+        return *points_;
     }
 
     /**
@@ -457,17 +517,25 @@ public:
      */
     virtual std::vector<VectorType> getCellCenters() {
         checkInitialized();
-        std::vector<VectorType> cells;
-        cells.reserve(gridGeometry->gridView().size(0));
-        for (const auto& e : elements(gridGeometry->gridView())) {
-            auto p = e.geometry().center();
-            VectorType vp;
-            for (int i=0; i<dim; i++) { // found no better way
-                vp[i] = p[i];
-            }
-            cells.push_back(vp);
-        }
-        return cells;
+        return *cellCenters_;
+    }
+
+    /**
+     * The vertices (@see getPoints) as read-only numpy array without copying,
+     * the view shares the coordinates, i.e. it keeps the vertices of the grid at the time of the call
+     */
+    py::array_t<double> getPointsView() {
+        checkInitialized();
+        return readOnlyView(points_->empty() ? nullptr : (*points_)[0].data(), points_->size(), dim, points_);
+    }
+
+    /**
+     * The element centers (@see getCellCenters) as read-only numpy array without copying,
+     * the view shares the coordinates, i.e. it keeps the centers of the grid at the time of the call
+     */
+    py::array_t<double> getCellCentersView() {
+        checkInitialized();
+        return readOnlyView(cellCenters_->empty() ? nullptr : (*cellCenters_)[0].data(), cellCenters_->size(), dim, cellCenters_);
     }
 
     /**
@@ -593,6 +661,18 @@ public:
         return sol;
     }
 
+    /**
+     * Returns the current solution of a single mpi process as read-only numpy array (dof, eqIdx) without copying.
+     * The view follows the solution, also over initializeProblem(), which throws if the number of dofs changes
+     * while views exist. @param self the Python solver object kept alive by the view
+     */
+    py::array_t<double> getSolutionView(py::handle self) {
+        int n = checkInitialized();
+        const size_t numEq = SolutionVector::block_type::dimension;
+        auto owner = std::make_pair(py::reinterpret_borrow<py::object>(self), solutionViews_);
+        return readOnlyView(n > 0 ? &x[0][0] : nullptr, n, numEq, std::move(owner));
+    }
+
     /**
      * Returns the current solution at a cell index
      * for all mpi processes
@@ -642,65 +722,82 @@ public:
      * For a single mpi process. Gathering is done in Python
      */
     virtual std::map<int, double> getAllNeumann(int eqIdx = 0) {
+        checkInitialized();
         std::map<int, double> fluxes;
-        for (const auto& e : Dune::elements(gridGeometry->gridView())) { // soil elements
+        auto faceFluxes = getBoundaryFluxes(eqIdx);
+        for (size_t i = 0; i < boundaryElements_.size(); i++) {
+            int c = boundaryFaceOffset_[i+1] - boundaryFaceOffset_[i];
             double f = 0.;
-            auto fvGeometry = Dumux::localView(*gridGeometry); // soil solution -> volume variable
-            fvGeometry.bindElement(e);
-            int c = 0;
-            for (const auto& scvf : scvfs(fvGeometry)) {
-                if (scvf.boundary()) {
-                    c++;
-                    auto elemVolVars = Dumux::localView(gridVariables->curGridVolVars());
-                    elemVolVars.bindElement(e, fvGeometry, x);
-                    f += problem->neumann(e, fvGeometry, elemVolVars, scvf)[eqIdx]; // [kg / (m2 s)]
-                }
-            }
-            if (c>0) {
-                fluxes[cellIdx->index(e)] = f/c; // mean value
+            for (int j = boundaryFaceOffset_[i]; j < boundaryFaceOffset_[i+1]; j++) {
+                f += faceFluxes[j];
             }
+            fluxes[boundaryCells_[i]] = f/c; // mean value
         }
         return fluxes;
     }
 
     /**
-     * Returns the net flux [kg/s]. TODO crashes, no idea why
+     * Returns the neumann fluxes [kg / (m2 s)] of the current solution for each boundary scvf,
+     * the scvfs of the i-th boundary element are [offset[i], offset[i+1]) @see getBoundaryFaceCells
      *
-     * partly from velocityoutput.hh
+     * Each boundary element is bound once, interior elements are skipped.
      *
      * For a single mpi process. Gathering is done in Python
      */
-    virtual std::vector<double> getNetFlux(int eqIdx = 0) {
-        int n = checkInitialized();
-        std::vector<double> fluxes;
-        fluxes.resize(n);
-
+    virtual std::vector<double> getBoundaryFluxes(int eqIdx = 0) {
+        checkInitialized();
+        std::vector<double> fluxes(boundaryFaceArea_.size());
+        auto fvGeometry = Dumux::localView(*gridGeometry);
         auto elemVolVars = Dumux::localView(gridVariables->curGridVolVars());
-        auto fvGeometry = Dumux::localView(*gridGeometry); // soil solution -> volume variable
-        auto elemFluxVarsCache = Dumux::localView(gridVariables->gridFluxVarsCache());
-
-        // the upwind term to be used for the volume flux evaluation
-        auto upwindTerm = [eqIdx](const auto& volVars) { return volVars.mobility(eqIdx); };
-
-        for (const auto& e : Dune::elements(gridGeometry->gridView())) { // soil elements
-
+        for (size_t i = 0; i < boundaryElements_.size(); i++) {
+            auto e = gridGeometry->element(boundaryElements_[i]);
             fvGeometry.bindElement(e);
             elemVolVars.bindElement(e, fvGeometry, x);
-
-            double f = 0.;
+            int j = boundaryFaceOffset_[i];
             for (const auto& scvf : scvfs(fvGeometry)) {
-
-                if (!scvf.boundary()) {
-                    // bind the element flux variables cache
-                    elemFluxVarsCache.bindElement(e, fvGeometry, elemVolVars);
-                    //                    FluxVariables fluxVars;
-                    //                    fluxVars.init(*problem, e, fvGeometry, elemVolVars, scvf, elemFluxVarsCache);
-                    //                    f += fluxVars.advectiveFlux(eqIdx, upwindTerm);
+                if (scvf.boundary()) {
+                    fluxes[j++] = problem->neumann(e, fvGeometry, elemVolVars, scvf)[eqIdx]; // [kg / (m2 s)]
                 }
-                else { }
+            }
+        }
+        return fluxes;
+    }
 
+    /**
+     * Returns the global element index of each boundary scvf, in the order of getBoundaryFluxes()
+     *
+     * For a single mpi process. Gathering is done in Python
+     */
+    virtual std::vector<int> getBoundaryFaceCells() {
+        checkInitialized();
+        std::vector<int> cells(boundaryFaceArea_.size());
+        for (size_t i = 0; i < boundaryElements_.size(); i++) {
+            std::fill(cells.begin() + boundaryFaceOffset_[i], cells.begin() + boundaryFaceOffset_[i+1], boundaryCells_[i]);
+        }
+        return cells;
+    }
+
+    /**
+     * Returns the net neumann flux [kg/s] over the boundary of each cell (zero for interior cells),
+     * in the order of getCellIndices()
+     *
+     * For a single mpi process. Gathering is done in Python
+     */
+    virtual std::vector<double> getNetFlux(int eqIdx = 0) {
+        checkInitialized();
+        std::vector<double> netFlux(gridGeometry->gridView().size(0));
+        auto faceFluxes = getBoundaryFluxes(eqIdx);
+        for (size_t i = 0; i < boundaryElements_.size(); i++) {
+            double f = 0.;
+            for (int j = boundaryFaceOffset_[i]; j < boundaryFaceOffset_[i+1]; j++) {
+                f += faceFluxes[j]*boundaryFaceArea_[j]; // [kg / (m2 s)] -> [kg / s]
             }
-            fluxes[cellIdx->index(e)] = f;
+            netFlux[boundaryElements_[i]] = f;
+        }
+        std::vector<double> fluxes; // in the order of getCellIndices()
+        fluxes.reserve(netFlux.size());
+        for (const auto& e : elements(gridGeometry->gridView())) {
+            fluxes.push_back(netFlux[gridGeometry->elementMapper().index(e)]);
         }
         return fluxes;
     }
@@ -713,38 +810,61 @@ public:
      */
     virtual int pickCell(VectorType pos) {
         checkInitialized();
-        if (periodic) {
-            auto b = getGridBounds();
-            for (int i = 0; i < 2; i++) { // for x and y, not z
-                double minx = b[i];
-                double xx = b[i+3]-minx;
-                if (!std::isinf(xx)) { // periodic in x
-                    pos[i] -= minx; // start at 0
-                    if (pos[i]>=0) {
-                        pos[i] = pos[i] - int(pos[i]/xx)*xx;
-                    } else {
-                        pos[i] = pos[i] + int((xx-pos[i])/xx)*xx;
-                    }
-                    pos[i] += minx;
-                }
+        int gIdx = pickLocal_(periodicPosition_(pos, getGridBounds()));
+        gIdx = gridGeometry->gridView().comm().max(gIdx); // so clever
+        return gIdx;
+    }
+
+    /**
+     * Picks the cells of many points at once, and returns their global element cell indices (-1 if not found)
+     *
+     * The tree queries are local, the owning ranks are resolved by a single collective for all points.
+     * If pickCache is set, points that equal the points of the last call (at the same position in the list)
+     * are not picked again, e.g. the nodes of a growing root system.
+     */
+    virtual std::vector<int> pickCells(const std::vector<VectorType>& pos) {
+        DUMUX_PROFILE_ZONE("python pickCells");
+        checkInitialized();
+        size_t n = pos.size();
+        size_t start = 0; // points before start are taken from the cache
+        if (pickCache) {
+            size_t m = std::min(n, pickedPoints_.size());
+            while ((start < m) && (pos[start] == pickedPoints_[start])) {
+                start++;
             }
         }
-        auto& bBoxTree = gridGeometry->boundingBoxTree();
-        Dune::FieldVector<double, dim> p;
-        for (int i=0; i<dim; i++) {
-            p[i] = pos[i];
+        std::vector<int> gIdx(n);
+        std::copy(pickedCells_.begin(), pickedCells_.begin() + start, gIdx.begin());
+        auto b = getGridBounds();
+        for (size_t i = start; i < n; i++) {
+            gIdx[i] = pickLocal_(periodicPosition_(pos[i], b));
         }
-        // std::cout << "point: " << pos[0]<<", "<< pos[1] <<","<< pos[2] << " in box "; // <<  getGridBounds();
-        auto entities = Dumux::intersectingEntities(p, bBoxTree);
-        int gIdx = -1;
-        if (!entities.empty()) {
-            auto element = bBoxTree.entitySet().entity(entities[0]);
-            gIdx = cellIdx->index(element);
+        if (n > start) {
+            gridGeometry->gridView().comm().max(gIdx.data() + start, n - start); // one reduction for all points
+        }
+        if (pickCache) {
+            pickedPoints_ = pos;
+            pickedCells_ = gIdx;
         }
-        gIdx = gridGeometry->gridView().comm().max(gIdx); // so clever
         return gIdx;
     }
 
+    /**
+     * Empties the cache of pickCells(), called by initializeProblem()
+     */
+    virtual void clearPickCache() {
+        pickedPoints_.clear();
+        pickedCells_.clear();
+    }
+
+    /**
+     * Writes the profile of all zones (<name>_profile.json, and <name>_trace-<rank>.json), collective.
+     * Zones are only recorded, if the module is compiled with DUMUX_PROFILING=1 (CMake option DUMUX_ROSI_PROFILING)
+     */
+    virtual void writeProfile(std::string name) {
+        Dumux::Profiler::instance().write(name, Dune::MPIHelper::getCollectiveCommunication());
+    }
+
     /**
      * Picks a cell and returns its global element cell index @see pickCell
      */
@@ -774,9 +894,21 @@ public:
         if (simTime>0) {
             msg << "\nSimulation time is "<< simTime/3600/24 << " days, current internal time step is "<< ddt/3600/24 << " days";
         }
+        if (solveCalls>0) {
+            msg << "\n" << solveCalls << " calls of solve() with "<< (persistentSolver ? "persistent" : "new") << " solvers, set up took "
+                << setupTime/solveCalls*1.e3 << " ms, solution took " << solveTime/solveCalls*1.e3 << " ms per call";
+        }
         return msg.str();
     }
 
+    /**
+     * Number of elements of a single mpi process (the length of element wise fields)
+     */
+    int numberOfLocalCells() {
+        checkInitialized();
+        return gridGeometry->gridView().size(0);
+    }
+
     /**
      * Checks if the problem was initialized, and returns number of local dof
      * i.e. initializeProblem() was called
@@ -802,6 +934,105 @@ protected:
 
     using GridData = Dumux::GridData<Grid>;
     using GridView = typename Grid::Traits::LeafGridView;
+    using NonLinearSolver = Dumux::RichardsNewtonSolver<Assembler, LinearSolver>;
+
+    /**
+     * Maps the position into the periodic domain given by the grid bounds @param b (if periodic)
+     */
+    VectorType periodicPosition_(VectorType pos, const std::vector<double>& b) const {
+        if (periodic) {
+            for (int i = 0; i < 2; i++) { // for x and y, not z
+                double minx = b[i];
+                double xx = b[i+3]-minx;
+                if (!std::isinf(xx)) { // periodic in x
+                    pos[i] -= minx; // start at 0
+                    if (pos[i]>=0) {
+                        pos[i] = pos[i] - int(pos[i]/xx)*xx;
+                    } else {
+                        pos[i] = pos[i] + int((xx-pos[i])/xx)*xx;
+                    }
+                    pos[i] += minx;
+                }
+            }
+        }
+        return pos;
+    }
+
+    /**
+     * Caches vertex coordinates and element centers (@see getPoints, getCellCenters, and their views)
+     */
+    void updateGeometry_() {
+        auto points = std::make_shared<std::vector<VectorType>>(); // new memory, views of the old grid keep theirs
+        points->reserve(gridGeometry->gridView().size(dim));
+        for (const auto& v : vertices(gridGeometry->gridView())) {
+            auto p = v.geometry().center();
+            VectorType vp;
+            for (int i=0; i<dim; i++) { // found no better way
+                vp[i] = p[i];
+            }
+            points->push_back(vp);
+        }
+        auto cellCenters = std::make_shared<std::vector<VectorType>>();
+        cellCenters->reserve(gridGeometry->gridView().size(0));
+        for (const auto& e : elements(gridGeometry->gridView())) {
+            auto p = e.geometry().center();
+            VectorType vp;
+            for (int i=0; i<dim; i++) { // found no better way
+                vp[i] = p[i];
+            }
+            cellCenters->push_back(vp);
+        }
+        points_ = points;
+        cellCenters_ = cellCenters;
+    }
+
+    /**
+     * Creates the boundary face index used by getBoundaryFluxes(), getAllNeumann(), and getNetFlux()
+     */
+    void updateBoundaryFaces_() {
+        boundaryElements_.clear();
+        boundaryCells_.clear();
+        boundaryFaceOffset_.assign(1, 0);
+        boundaryFaceArea_.clear();
+        auto fvGeometry = Dumux::localView(*gridGeometry);
+        auto elemVolVars = Dumux::localView(gridVariables->curGridVolVars());
+        for (const auto& e : elements(gridGeometry->gridView())) {
+            if (!e.hasBoundaryIntersections()) {
+                continue;
+            }
+            fvGeometry.bindElement(e);
+            elemVolVars.bindElement(e, fvGeometry, x);
+            size_t c = boundaryFaceArea_.size();
+            for (const auto& scvf : scvfs(fvGeometry)) {
+                if (scvf.boundary()) {
+                    const auto& insideVolVars = elemVolVars[scvf.insideScvIdx()];
+                    boundaryFaceArea_.push_back(scvf.area()*insideVolVars.extrusionFactor());
+                }
+            }
+            if (boundaryFaceArea_.size() > c) {
+                boundaryElements_.push_back(gridGeometry->elementMapper().index(e));
+                boundaryCells_.push_back(cellIdx->index(e));
+                boundaryFaceOffset_.push_back(boundaryFaceArea_.size());
+            }
+        }
+    }
+
+    /**
+     * Global index of the local element containing @param pos, -1 if it is not on this rank
+     */
+    int pickLocal_(const VectorType& pos) const {
+        auto& bBoxTree = gridGeometry->boundingBoxTree();
+        Dune::FieldVector<double, dim> p;
+        for (int i=0; i<dim; i++) {
+            p[i] = pos[i];
+        }
+        auto entities = Dumux::intersectingEntities(p, bBoxTree);
+        if (entities.empty()) {
+            return -1;
+        }
+        auto element = bBoxTree.entitySet().entity(entities[0]);
+        return cellIdx->index(element);
+    }
 
     std::shared_ptr<Grid> grid;
     std::shared_ptr<GridData> gridData;
@@ -815,6 +1046,24 @@ protected:
     std::vector<int> globalPointIdx; // local to global index mapper
 
     SolutionVector x;
+    SolutionVector xOld; // solution of the last time step (within solve)
+    std::shared_ptr<int> solutionViews_ = std::make_shared<int>(0); // shared with each view of x, use_count() - 1 views exist
+
+    std::shared_ptr<const std::vector<VectorType>> points_ = std::make_shared<std::vector<VectorType>>(); // vertex coordinates, in the order of getPointIndices() (updated by initializeProblem)
+    std::shared_ptr<const std::vector<VectorType>> cellCenters_ = std::make_shared<std::vector<VectorType>>(); // element centers, in the order of getCellIndices()
+
+    std::vector<int> boundaryElements_; // local indices of the elements with boundary scvfs (updated by initializeProblem)
+    std::vector<int> boundaryCells_; // their global indices
+    std::vector<int> boundaryFaceOffset_; // the boundary scvfs of the i-th boundary element are [offset[i], offset[i+1])
+    std::vector<double> boundaryFaceArea_; // area times extrusion factor of each boundary scvf [m2]
+
+    std::vector<VectorType> pickedPoints_; // points and cells of the last call of pickCells(), if pickCache
+    std::vector<int> pickedCells_;
+
+    std::shared_ptr<Dumux::CheckPointTimeLoop<double>> timeLoop; // solvers used by solve(), kept if persistentSolver
+    std::shared_ptr<Assembler> assembler;
+    std::shared_ptr<LinearSolver> linearSolver;
+    std::shared_ptr<NonLinearSolver> nonLinearSolver;
 
 };
 
@@ -843,6 +1092,7 @@ void init_solverbase(py::module &m, std::string name) {
 	    				        // simulation
 	    				        .def("solve", &Solver::solve, py::arg("dt"), py::arg("maxDt") = -1)
 	    				        .def("solveSteadyState", &Solver::solveSteadyState)
+	    				        .def("resetSolver", &Solver::resetSolver)
 	    				        // post processing (vtk naming)
 	    				        .def("getPoints", &Solver::getPoints) //
 	    				        .def("getCellCenters", &Solver::getCellCenters)
@@ -854,12 +1104,22 @@ void init_solverbase(py::module &m, std::string name) {
 	    				        .def("getCellIndices", &Solver::getCellIndices)
 	    				        .def("getDofIndices", &Solver::getDofIndices)
 	    				        .def("getSolution", &Solver::getSolution, py::arg("eqIdx") = 0)
+	    				        // zero-copy views (single mpi process, see the getters for their lifetime)
+	    				        .def("getSolutionView", [](py::object self) { return self.cast<Solver&>().getSolutionView(self); })
+	    				        .def("getPointsView", &Solver::getPointsView)
+	    				        .def("getCellCentersView", &Solver::getCellCentersView)
+	    				        .def("numberOfLocalCells", &Solver::numberOfLocalCells)
 	    				        .def("getSolutionAt", &Solver::getSolutionAt, py::arg("gIdx"), py::arg("eqIdx") = 0)
 	    				        .def("getNeumann", &Solver::getNeumann, py::arg("gIdx"), py::arg("eqIdx") = 0)
 	    				        .def("getAllNeumann", &Solver::getAllNeumann, py::arg("eqIdx") = 0)
 	    				        .def("getNetFlux", &Solver::getNetFlux, py::arg("eqIdx") = 0)
+	    				        .def("getBoundaryFluxes", &Solver::getBoundaryFluxes, py::arg("eqIdx") = 0)
+	    				        .def("getBoundaryFaceCells", &Solver::getBoundaryFaceCells)
 	    				        .def("pickCell", &Solver::pickCell)
 	    				        .def("pick", &Solver::pick)
+	    				        .def("pickCells", &Solver::pickCells)
+	    				        .def("clearPickCache", &Solver::clearPickCache)
+	    				        .def("writeProfile", &Solver::writeProfile, py::arg("name")) // needs DUMUX_PROFILING
 	    				        // members
 	    				        .def_readonly("simTime", &Solver::simTime) // read only
 	    				        .def_readwrite("ddt", &Solver::ddt) // initial internal time step
@@ -867,6 +1127,11 @@ void init_solverbase(py::module &m, std::string name) {
 	    				        .def_readonly("maxRank", &Solver::maxRank) // read only
 	    				        .def_readonly("numberOfCells", &Solver::numberOfCells) // read only
 	    				        .def_readonly("periodic", &Solver::periodic) // read only
+	    				        .def_readwrite("persistentSolver", &Solver::persistentSolver) // keep the solvers between calls of solve
+	    				        .def_readonly("setupTime", &Solver::setupTime) // read only
+	    				        .def_readonly("solveTime", &Solver::solveTime) // read only
+	    				        .def_readonly("solveCalls", &Solver::solveCalls) // read only
+	    				        .def_readwrite("pickCache", &Solver::pickCache) // pickCells() reuses the cells of already picked points
 	    				        // useful
 	    				        .def("__str__",&Solver::toString)
 	    				        .def("checkInitialized", &Solver::checkInitialized);
@@ -0,0 +1,122 @@
+import numpy as np
+
+
+class ReducedXylemFlux:
+    """ Reduced order root hydraulic model (following Couvreur et al. 2012)
+
+        The root system is represented by its conductance Krs [cm2 day-1] and the standard uptake fraction
+        (SUF) per soil cell, which are computed from the full xylem model (XylemFluxPython) for a uniform soil.
+        The sink per soil cell is then
+
+            q_c = SUF_c * T - Krs * SUF_c * (sx_c - seq),   with seq = sum_c SUF_c * sx_c,
+
+        where T is the actual transpiration [cm3 day-1] (negative for uptake), limited by the wilting point
+        at the root collar. Cells wetter than seq take up more (compensatory uptake).
+
+        The soil matric potentials sx can be given flat, or as column (n, 1) like RichardsWrapper.getSolutionHead().
+
+        Krs and SUF are recomputed when the root system grows (number of segments changes), or when
+        the conductivities might have changed (simulation time advanced by more than refresh_interval).
+        After each refresh, the sink is compared to the full solve for the current soil state, if the
+        relative error exceeds tol the full model is used until the next refresh (counted in num_fallbacks).
+    """
+
+    def __init__(self, r, refresh_interval :float = 1., tol :float = 0.05, h_ref :float = -500., verbose :bool = False):
+        """ @param r                    the full xylem model (XylemFluxPython, with conductivities and soil grid)
+            @param refresh_interval     [day] maximal simulation time between two refreshs (for age dependent conductivities)
+            @param tol                  maximal relative error of the sink (L1 norm relative to |T|) before falling back to the full model
+            @param h_ref [cm]           collar pressure head used to compute Krs and SUF (the model is linear, any value works)
+            @param verbose              tell me more (each fall back to the full model)
+        """
+        self.r = r
+        self.refresh_interval = refresh_interval
+        self.tol = tol
+        self.h_ref = h_ref
+        self.verbose = verbose
+        self.krs = 0.  # [cm2 day-1]
+        self.cells = np.zeros((0,), dtype = np.int64)  # soil cells with roots
+        self.suf = np.zeros((0,))  # [1] per soil cell
+        self.error = 0.  # relative error of the last accuracy check
+        self.use_full = False  # True, if the last accuracy check failed
+        self.last_refresh_time = -np.inf  # [day]
+        self.last_num_segments = -1
+        self.num_refreshs = 0
+        self.num_fallbacks = 0  # refreshs, after which the full model was used
+
+    def needs_refresh(self, sim_time :float):
+        """ True if the root system grew, or the conductivities might have changed since the last refresh """
+        return (len(self.r.rs.segments) != self.last_num_segments or
+                sim_time - self.last_refresh_time >= self.refresh_interval)
+
+    def refresh(self, sim_time :float, sx, soil_k = []):
+        """ computes Krs and SUF with the full xylem model for a uniform soil
+            @param sim_time [day]   needed for age dependent conductivities
+            @param sx [cm]          soil matric potentials per cell (defines the number of cells, values are not used)
+            @param soil_k [cm/s]    soil conductivities (optional)
+        """
+        sx0 = np.zeros(np.array(sx).shape)
+        rx = self.r.solve_dirichlet(sim_time, self.h_ref, 0., sx0, True, soil_k)
+        fluxes = self.r.soilFluxes(sim_time, rx, sx0, False)  # [cm3 day-1] per cell
+        self.cells = np.array(list(fluxes.keys()), dtype = np.int64)
+        f = np.array(list(fluxes.values()))
+        total = np.sum(f)
+        self.krs = total / self.h_ref  # collar flux per potential difference between collar and soil
+        self.suf = f / total
+        self.last_refresh_time = sim_time
+        self.last_num_segments = len(self.r.rs.segments)
+        self.num_refreshs += 1
+
+    def collar_potential(self, trans :float, sx, wilting_point :float):
+        """ collar pressure head [cm] and actual transpiration [cm3 day-1] for the potential transpiration @param trans (negative) """
+        seq = np.dot(self.suf, np.asarray(sx).reshape(-1)[self.cells])
+        h_collar = seq + trans / self.krs
+        if h_collar < wilting_point:
+            return wilting_point, self.krs * (wilting_point - seq)
+        return h_collar, trans
+
+    def reduced_fluxes(self, trans :float, sx, wilting_point :float):
+        """ sink per soil cell [cm3 day-1] of the reduced model, as numpy array (in the order of self.cells) """
+        sx_c = np.asarray(sx).reshape(-1)[self.cells]
+        seq = np.dot(self.suf, sx_c)
+        _, t_act = self.collar_potential(trans, sx, wilting_point)
+        return self.suf * t_act - self.krs * self.suf * (sx_c - seq)
+
+    def full_fluxes(self, sim_time :float, trans :float, sx, wilting_point :float, soil_k = []):
+        """ sink per soil cell [cm3 day-1] of the full xylem model, as dictionary """
+        cci = self.r.rs.seg2cell[0]  # collar cell index
+        rx = self.r.solve(sim_time, trans, sx[cci], sx, True, wilting_point, soil_k)
+        return self.r.soilFluxes(sim_time, rx, sx, False)
+
+    def check(self, sim_time :float, trans :float, sx, wilting_point :float, soil_k = []):
+        """ relative error (L1 norm of the sink per cell, relative to the actual transpiration) of the reduced model """
+        sx = np.asarray(sx).reshape(-1)
+        full = self.full_fluxes(sim_time, trans, sx, wilting_point, soil_k)
+        reduced = dict(zip(self.cells.tolist(), self.reduced_fluxes(trans, sx, wilting_point)))
+        diff = 0.
+        for c in set(full.keys()) | set(reduced.keys()):
+            diff += abs(full.get(c, 0.) - reduced.get(c, 0.))
+        total = abs(sum(full.values()))
+        return diff / max(total, 1.e-16)
+
+    def soil_fluxes(self, sim_time :float, trans :float, sx, wilting_point :float, soil_k = []):
+        """ sink per soil cell [cm3 day-1] as dictionary (like XylemFlux.soilFluxes),
+            refreshs Krs and SUF if needed, and checks the accuracy after each refresh
+
+            @param sim_time [day]       needed for age dependent conductivities
+            @param trans [cm3 day-1]    potential transpiration (negative)
+            @param sx [cm]              soil matric potentials per cell
+            @param wilting_point [cm]   pressure head
+            @param soil_k [cm/s]        soil conductivities (optional)
+        """
+        if self.needs_refresh(sim_time):
+            self.refresh(sim_time, sx, soil_k)
+            self.error = self.check(sim_time, trans, sx, wilting_point, soil_k)
+            self.use_full = self.error > self.tol
+            if self.use_full:
+                self.num_fallbacks += 1
+                if self.verbose:
+                    print("ReducedXylemFlux: relative error {:g} > {:g}, using the full xylem model until the next refresh".format(self.error, self.tol))
+        if self.use_full:
+            return self.full_fluxes(sim_time, trans, sx, wilting_point, soil_k)
+        return dict(zip(self.cells.tolist(), self.reduced_fluxes(trans, sx, wilting_point).tolist()))
+
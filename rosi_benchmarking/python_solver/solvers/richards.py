@@ -235,6 +235,21 @@ class RichardsWrapper(SolverWrapper):
         self.checkInitialized()
         return self._map(self._flat0(MPI.COMM_WORLD.gather(self.base.getWaterContent(), root = 0)), 2)
 
+    def fillWaterContent(self, theta):
+        """ Writes the water content of the cells of this mpi process into the numpy array theta (float64, local Nc) [1],
+        in the order of base.getCellIndices() """
+        self.base.fillWaterContent(theta)
+
+    def fillSaturation(self, s):
+        """ Writes the saturation of the cells of this mpi process into the numpy array s (float64, local Nc) [1],
+        in the order of base.getCellIndices() """
+        self.base.fillSaturation(s)
+
+    def fillSolutionHead(self, h, eqIdx = 0):
+        """ Writes the current solution of this mpi process into the numpy array h (float64, local Ndof) [cm],
+        in the order of base.getDofIndices() """
+        self.base.fillSolutionHead(h, eqIdx)
+
     def getWaterVolume(self):
         """Returns total water volume of the domain [cm3]"""
         self.checkInitialized()
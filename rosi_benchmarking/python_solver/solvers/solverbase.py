@@ -131,6 +131,21 @@ class SolverWrapper():
         self.checkInitialized()
         return self._map(self._flat0(MPI.COMM_WORLD.gather(self.base.getSolution(eqIdx), root = 0)), 0)
 
+    def getSolutionView(self):
+        """ The current solution of this mpi process as read-only numpy array (local dof, neq) without copying,
+        model dependent units [Pa, ...], in the order of base.getDofIndices(), follows the solution also over initializeProblem() (as long as the number of dofs is unchanged) """
+        return self.base.getSolutionView()
+
+    def getPointsView(self):
+        """ The vertices of this mpi process as read-only numpy array (local Np, 3) without copying [m],
+        in the order of base.getPointIndices(), keeps the vertices of the grid at the time of the call """
+        return self.base.getPointsView()
+
+    def getCellCentersView(self):
+        """ The cell centers of this mpi process as read-only numpy array (local Nc, 3) without copying [m],
+        in the order of base.getCellIndices(), keeps the centers of the grid at the time of the call """
+        return self.base.getCellCentersView()
+
     def getSolutionAt(self, gIdx, eqIdx = 0):
         """Returns the current solution at a cell index, model dependent units [Pa, ...]"""
         return self.base.getSolutionAt(gIdx, eqIdx)
@@ -145,14 +160,22 @@ class SolverWrapper():
         flat_dic = {}
         for d in dics:
             flat_dic.update(d)
-        for key, value in flat_dic:
+        for key, value in flat_dic.items():
             flat_dic[key] = value / 1000 * 24 * 3600 * 100.  # [kg m-2 s-1] / rho = [m s-1] -> cm / day
         return flat_dic
 
     def getNetFlux(self, eqIdx = 0):
-        """ Gathers the net fluxes fir each cell into rank 0 as a map with global index as key [cm3 / day]"""
+        """ Gathers the net boundary fluxes of each cell into rank 0, indexed by the global cell index [cm3 / day]"""
         self.checkInitialized()
-        return self._map(self._flat0(MPI.COMM_WORLD.gather(self.base.getNetFlux(eqIdx), root = 0)), 0) * 1000. *24 * 3600  # kg/s -> cm3/day
+        return self._map(self._flat0(MPI.COMM_WORLD.gather(self.base.getNetFlux(eqIdx), root = 0)), 2) * 1000. *24 * 3600  # kg/s -> cm3/day
+
+    def getBoundaryFluxes(self, eqIdx = 0):
+        """ Gathers the neumann fluxes of all boundary faces into rank 0,
+        returns the global cell index of each face, and the face fluxes [cm / day] """
+        self.checkInitialized()
+        cells = self._flat0(MPI.COMM_WORLD.gather(self.base.getBoundaryFaceCells(), root = 0))
+        fluxes = self._flat0(MPI.COMM_WORLD.gather(self.base.getBoundaryFluxes(eqIdx), root = 0))
+        return np.array(cells, dtype = np.int64), np.array(fluxes) / 1000 * 24 * 3600 * 100.  # [kg m-2 s-1] / rho = [m s-1] -> cm / day
 
     def pickCell(self, pos):
         """ Picks a cell and returns its global element cell index """
@@ -162,6 +185,21 @@ class SolverWrapper():
         """ Picks a cell and returns its global element cell index """
         return self.base.pick(np.array(x) / 100.)  # cm -> m
 
+    def pickCells(self, pos):
+        """ Picks the cells of many points [cm] at once (one MPI reduction),
+        returns their global element cell indices (-1 if not found) """
+        return np.array(self.base.pickCells(np.array(pos) / 100.), dtype = np.int64)  # cm -> m
+
+    @property
+    def pickCache(self):
+        """ if True, pickCells() reuses the cells of points, that equal the points of the last call """
+        return self.base.pickCache
+
+    @pickCache.setter
+    def pickCache(self, value):
+        """ cache the picked cells between calls of pickCells() (True), or pick all points each call (False) """
+        self.base.pickCache = value
+
     def __str__(self):
         """ Solver representation as string """
         return str(self.base)
@@ -195,6 +233,16 @@ class SolverWrapper():
         """ sets internal time step, i.e. Dumux time step [days]"""
         self.base.ddt = value * 24.*3600.  # days -> s
 
+    @property
+    def persistentSolver(self):
+        """ if True, assembler, linear and nonlinear solver are kept alive between calls of solve() """
+        return self.base.persistentSolver
+
+    @persistentSolver.setter
+    def persistentSolver(self, value):
+        """ keep the Dumux solver objects between calls of solve() (True), or rebuild them each call (False) """
+        self.base.persistentSolver = value
+
     def interpolate(self, xi, eq = 0):
         """ interpolates the solution at position ix [cm],
         model dependent units
@@ -218,10 +266,10 @@ class SolverWrapper():
             y = np.zeros((xi.shape[0]))
         else:
             y = []
-        for i in range(0, xi.shape[0]):
-            idx = self.pickCell(xi[i, :])  # cm -> m
-            if rank == 0:
-                y[i] = solution[idx, eq]
+        idx = self.pickCells(xi)
+        if rank == 0:
+            for i in range(0, xi.shape[0]):
+                y[i] = solution[idx[i], eq]
         return y
 
     def writeVTK(self, file :str, small :bool = False):
@@ -0,0 +1,121 @@
+"""
+Tests of the reduced order root model (ReducedXylemFlux, Krs and SUF) against the full xylem model (XylemFluxPython),
+for the static root system of benchmark M1.2 in a uniform and in a heterogeneous soil
+
+needs CPlantBox (plantbox) in the python path, run by ctest (python_test_reduced_xylem_flux), or by hand in this folder
+"""
+import os
+import sys
+path = os.path.dirname(os.path.realpath(__file__))
+sys.path.append(os.path.join(path, "..", "solvers"))  # for pure python solvers
+sys.path.append(os.path.join(path, "..", "coupled"))  # root_conductivities
+
+import unittest
+
+import numpy as np
+
+try:
+    import plantbox as pb
+    from xylem_flux import XylemFluxPython  # Python hybrid solver
+    from reduced_xylem_flux import ReducedXylemFlux  # Krs and SUF
+    from root_conductivities import init_conductivities
+except ImportError:
+    pb = None
+
+min_b = np.array([-4., -4., -15.])
+max_b = np.array([4., 4., 0.])
+cell_number = np.array([8, 8, 15])
+wilting_point = -15000  # cm
+trans = -1.  # cm3 day-1, far from the wilting point
+
+
+def picker(x, y, z):
+    """ index of the soil cell containing (x, y, z), like the rectangular soil grid of the Richards binding """
+    i = np.floor((np.array([x, y, z]) - min_b) / (max_b - min_b) * cell_number).astype(int)
+    i = np.minimum(np.maximum(i, 0), cell_number - 1)
+    return int(i[0] + cell_number[0] * (i[1] + cell_number[1] * i[2]))
+
+
+def create_models():
+    """ root system of benchmark M1.2 with age independent conductivities, and its reduced model """
+    r = XylemFluxPython(os.path.join(path, "..", "grids", "RootSystem.rsml"))
+    r.rs.setRectangularGrid(pb.Vector3d(*min_b), pb.Vector3d(*max_b), pb.Vector3d(*[float(n) for n in cell_number]))
+    init_conductivities(r, False)
+    r.rs.sort()
+    r.rs.setSoilGrid(picker)
+    rs_age = np.max(r.get_ages())
+    return r, ReducedXylemFlux(r), rs_age
+
+
+def heterogeneous_soil():
+    """ matric potentials [cm] per cell, drier at the top, and random per cell """
+    n = int(np.prod(cell_number))
+    z = (np.arange(n) // (cell_number[0] * cell_number[1]) + 0.5) / cell_number[2]  # [1] relative height
+    return -200. - 800. * z - 300. * np.random.default_rng(1).random(n)
+
+
+def l1_error(full, cells, fluxes):
+    """ L1 norm of the difference of the sinks per cell, relative to the total sink of the full model """
+    reduced = dict(zip(cells.tolist(), fluxes))
+    diff = sum(abs(full.get(c, 0.) - reduced.get(c, 0.)) for c in set(full.keys()) | set(reduced.keys()))
+    return diff / abs(sum(full.values()))
+
+
+@unittest.skipIf(pb is None, "needs CPlantBox (plantbox)")
+class TestReducedXylemFlux(unittest.TestCase):
+
+    def test_uniform_soil(self):
+        """ in a uniform soil the sink is the SUF times the transpiration, the reduced model is exact """
+        r, reduced, rs_age = create_models()
+        sx = np.full(int(np.prod(cell_number)), -300.)
+        reduced.refresh(rs_age, sx)
+        self.assertGreater(reduced.krs, 0.)
+        self.assertAlmostEqual(np.sum(reduced.suf), 1., places = 12)
+        self.assertTrue(np.all(reduced.suf >= 0.))
+        self.assertLess(reduced.check(rs_age, trans, sx, wilting_point), 1.e-6)
+
+    def test_heterogeneous_soil(self):
+        """ in a heterogeneous soil the reduced model takes up the transpiration, and more from the wetter cells """
+        r, reduced, rs_age = create_models()
+        sx = heterogeneous_soil()
+        reduced.refresh(rs_age, sx)
+        full = reduced.full_fluxes(rs_age, trans, sx, wilting_point)
+        fluxes = reduced.reduced_fluxes(trans, sx, wilting_point)
+        self.assertAlmostEqual(np.sum(fluxes), trans, places = 10)
+        self.assertAlmostEqual(sum(full.values()), trans, places = 6)
+        # the compensatory uptake must reduce the error of the uncompensated sink SUF * T
+        error = l1_error(full, reduced.cells, fluxes)
+        uncompensated = l1_error(full, reduced.cells, reduced.suf * trans)
+        print("relative L1 error of the sink: reduced model {:g}, without compensation {:g}".format(error, uncompensated))
+        self.assertLess(error, 0.5 * uncompensated)
+        self.assertAlmostEqual(reduced.check(rs_age, trans, sx, wilting_point), error, places = 10)
+
+    def test_column_vector(self):
+        """ the matric potentials can be given as column (n, 1), like RichardsWrapper.getSolutionHead() """
+        r, reduced, rs_age = create_models()
+        sx = heterogeneous_soil()
+        reduced.refresh(rs_age, sx)
+        flat = reduced.reduced_fluxes(trans, sx, wilting_point)
+        column = reduced.reduced_fluxes(trans, sx.reshape(-1, 1), wilting_point)
+        self.assertEqual(column.shape, flat.shape)
+        np.testing.assert_array_equal(column, flat)
+        self.assertEqual(reduced.collar_potential(trans, sx.reshape(-1, 1), wilting_point),
+                         reduced.collar_potential(trans, sx, wilting_point))
+        self.assertAlmostEqual(reduced.check(rs_age, trans, sx.reshape(-1, 1), wilting_point),
+                               reduced.check(rs_age, trans, sx, wilting_point), places = 12)
+
+    def test_fallback(self):
+        """ if the reduced model is not accurate enough after a refresh, the full model is used, and counted """
+        r, _, rs_age = create_models()
+        reduced = ReducedXylemFlux(r, tol = 0.)  # any error is too large
+        sx = heterogeneous_soil()
+        fluxes = reduced.soil_fluxes(rs_age, trans, sx, wilting_point)
+        self.assertTrue(reduced.use_full)
+        self.assertEqual(reduced.num_fallbacks, 1)
+        self.assertEqual(fluxes, reduced.full_fluxes(rs_age, trans, sx, wilting_point))
+        reduced.soil_fluxes(rs_age, trans, sx, wilting_point)  # no refresh, no new fall back
+        self.assertEqual(reduced.num_fallbacks, 1)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,86 @@
+"""
+Tests of SolverBase (solverbase.hh) via the Richards binding: boundary fluxes, and the lifetime of the zero-copy views
+
+run by ctest (python_test_solverbase), or by hand in this folder
+"""
+import sys
+sys.path.append("../../../build-cmake/rosi_benchmarking/python_solver/")
+sys.path.append("../solvers/")  # for pure python solvers
+
+import unittest
+
+import numpy as np
+
+from rosi_richards import RichardsSP  # C++ part (Dumux binding)
+from richards import RichardsWrapper  # Python part
+
+loam = [0.08, 0.43, 0.04, 1.6, 50]
+
+
+def create_solver(top_flux = 0.5):
+    """ a small 2 x 2 x 10 soil column [cm] with a constant flux at the top, and no flux at the bottom """
+    s = RichardsWrapper(RichardsSP())
+    s.initialize([""], False)
+    s.createGrid([-1., -1., -10.], [1., 1., 0.], [2, 2, 10])  # [cm]
+    s.setHomogeneousIC(-100.)  # cm pressure head
+    s.setTopBC("constantFlux", top_flux)  # [cm/day]
+    s.setBotBC("noFlux")
+    s.setVGParameters([loam])
+    return s
+
+
+class TestSolverBase(unittest.TestCase):
+
+    def test_boundary_fluxes(self):
+        """ boundary fluxes directly after createGrid and initializeProblem """
+        s = create_solver()
+        s.initializeProblem()
+        cells, fluxes = s.getBoundaryFluxes()
+        self.assertEqual(len(cells), 2 * 2 * 2 + 4 * 2 * 10)  # all boundary faces
+        self.assertEqual(len(np.unique(cells)), 2 * 2 * 10)  # every cell touches the boundary
+        top = np.nonzero(fluxes)[0]
+        self.assertEqual(len(top), 2 * 2)
+        np.testing.assert_allclose(np.abs(fluxes[top]), 0.5, rtol = 1.e-10)
+        centers = s.getCellCenters()
+        np.testing.assert_allclose(centers[cells[top], 2], -0.5)  # global cell indices of the top layer
+
+    def test_boundary_fluxes_reinitialized(self):
+        """ the boundary face index is rebuilt by a second initializeProblem """
+        s = create_solver()
+        s.initializeProblem()
+        cells, fluxes = s.getBoundaryFluxes()
+        s.initializeProblem()
+        cells2, fluxes2 = s.getBoundaryFluxes()
+        np.testing.assert_array_equal(cells, cells2)
+        np.testing.assert_array_equal(fluxes, fluxes2)
+
+    def test_views_reinitialized(self):
+        """ zero-copy views, held while the problem is initialized again """
+        s = create_solver()
+        s.initializeProblem()
+        sol = s.getSolutionView()
+        points = s.getPointsView()
+        centers = s.getCellCentersView()
+        points0, centers0 = np.array(points), np.array(centers)
+
+        s.setHomogeneousIC(-200.)  # same grid, new initial values
+        s.initializeProblem()
+        np.testing.assert_array_equal(sol, s.getSolutionView())  # the view follows the solution
+        np.testing.assert_array_equal(points, points0)
+        np.testing.assert_array_equal(centers, centers0)
+
+        s.createGrid([-1., -1., -10.], [1., 1., 0.], [2, 2, 20])  # more dofs
+        with self.assertRaises(ValueError):  # the solution view would dangle
+            s.initializeProblem()
+        self.assertEqual(sol.shape[0], 2 * 2 * 10)  # the failed call changed nothing
+        np.testing.assert_array_equal(sol, s.getSolutionView())
+        del sol
+        s.initializeProblem()
+        self.assertEqual(s.getSolutionView().shape[0], 2 * 2 * 20)
+        np.testing.assert_array_equal(points, points0)  # the old grid, still valid
+        np.testing.assert_array_equal(centers, centers0)
+        self.assertEqual(s.getCellCentersView().shape[0], 2 * 2 * 20)
+
+
+if __name__ == '__main__':
+    unittest.main()
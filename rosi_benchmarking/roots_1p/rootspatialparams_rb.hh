@@ -3,10 +3,14 @@
 #ifndef DUMUX_ROOT_SPATIALPARAMS_RB_HH
 #define DUMUX_ROOT_SPATIALPARAMS_RB_HH
 
+#include <algorithm>
+#include <memory>
+
 #include <dune/common/exceptions.hh>
 
 #include <dumux/common/math.hh>
 #include <dumux/common/parameters.hh>
+#include <dumux/common/threadpool.hh>
 #include <dumux/material/spatialparams/fv1p.hh>
 #include <dumux/material/components/simpleh2o.hh>
 
@@ -23,6 +27,9 @@ namespace Dumux {
  *
  * use initParameters to initialize the class with data from the root system model
  *
+ * The age dependent conductivities and radii are evaluated once per time step (in setTime) and
+ * for new segments (in updateParameters), kr, kx, and radius return the cached values.
+ * The evaluation runs on RootSystem.NumThreads threads (default 1).
  */
 template<class FVGridGeometry, class Scalar>
 class RootSpatialParamsRB
@@ -68,6 +75,12 @@ public:
         orders_ = { 0 };
         ctimes_ = { 0. };
         ids_ = { 0 };
+
+        int numThreads = getParam<int>("RootSystem.NumThreads", 1);
+        if (numThreads > 1) {
+            pool_ = std::make_unique<ThreadPool>(numThreads);
+        }
+        updateCache_();
     }
 
     /*!
@@ -108,10 +121,7 @@ public:
 
     // [m]
     Scalar radius(std::size_t eIdx) const {
-        if (eIdx==0) { // todo (will not always be zero)
-            return radius0_.f(this->age(eIdx), eIdx);
-        }
-        return radii_[eIdx]; // m
+        return radius_[eIdx];
     }
 
     // [s]
@@ -121,24 +131,21 @@ public:
 
     //! radial conductivity [m /Pa/s]
     Scalar kr(std::size_t eIdx) const {
-        if (eIdx==0) { // todo (will not always be zero)
-            return kr0_.f(this->age(eIdx), eIdx);
-        }
-        return kr_.f(this->age(eIdx), eIdx);
+        return krs_[eIdx];
     }
 
     //! axial conductivity [m^4/Pa/s]
     Scalar kx(std::size_t eIdx) const {
-        if (eIdx==0) { //  todo (will not always be zero)
-            return kx0_.f(this->age(eIdx), eIdx);
-        }
-        return kx_.f(this->age(eIdx), eIdx);
+        return kxs_[eIdx];
     }
 
-    //! sets the simulation time @param t [s]
+    //! sets the simulation time @param t [s], and evaluates the age dependent parameters of all segments
     void setTime(double t, double dt) {
-        time_ = t;
         dt_ = dt;
+        if (t != time_) {
+            time_ = t;
+            updateCache_();
+        }
     }
 
     //! Update the Root System Parameters (root system must implement GrowthModule::GrowthInterface)
@@ -162,9 +169,12 @@ public:
 
         std::cout << "updateParameters: " << gridView.size(0) << ": " << segs.size() << " new segments " << "\n"<< std::flush;
 
+        std::vector<std::size_t> changed; // elements with new parameters
+        changed.reserve(segs.size());
         for (size_t i = 0; i < segs.size(); i++) {
             size_t rIdx = segs[i][1] - 1; // rootbox segment index = second node index - 1
             size_t eIdx = rs.map2dune(rIdx);
+            changed.push_back(eIdx);
             // std::cout << "updateParameters: age at root index " << rIdx << " element index " << eIdx << " = " <<  segCT[i] << " s = " << segCT[i]/24/3600 << " d \n";
             orders_.at(eIdx) = segO[i];
             ids_.at(eIdx) = segId[i];
@@ -189,6 +199,7 @@ public:
             size_t rIdx = uni[i] - 1; // rootbox segment index = node index - 1
             size_t eIdx = rs.map2dune(rIdx);
             ctimes_.at(eIdx) = cts[i]; // replace time
+            changed.push_back(eIdx);
         }
 
         if ((kr_.type() == InputFileFunction::perType) || (kr_.type() == InputFileFunction::tablePerType)) {
@@ -197,6 +208,7 @@ public:
         if ((kx_.type() == InputFileFunction::perType) || (kx_.type() == InputFileFunction::tablePerType)) {
             kx_.setData(orders_);
         }
+        updateCache_(std::move(changed));
         // std::cout << "updateParameters done\n" << std::flush;
     }
 
@@ -207,6 +219,60 @@ public:
     }
 
 private:
+
+    //! evaluates kr, kx, and radius of element @param eIdx at the current time
+    void evaluate_(std::size_t eIdx) {
+        double a = age(eIdx);
+        if (eIdx==0) { // todo (will not always be zero)
+            krs_[eIdx] = kr0_.f(a, eIdx);
+            kxs_[eIdx] = kx0_.f(a, eIdx);
+            radius_[eIdx] = radius0_.f(a, eIdx);
+        } else {
+            krs_[eIdx] = kr_.f(a, eIdx);
+            kxs_[eIdx] = kx_.f(a, eIdx);
+            radius_[eIdx] = radii_[eIdx]; // m
+        }
+    }
+
+    //! calls @param f (i) for i in [0, @param n), in chunks on the thread pool (if any)
+    template<class F>
+    void forEach_(std::size_t n, F&& f) {
+        const std::size_t chunk = 4096;
+        int numChunks = int((n + chunk - 1) / chunk);
+        if (pool_ && numChunks > 1) {
+            pool_->parallelFor(numChunks, [&](int c) {
+                for (std::size_t i = c*chunk; i < std::min(n, (c + 1)*chunk); i++) {
+                    f(i);
+                }
+            });
+        } else {
+            for (std::size_t i = 0; i < n; i++) {
+                f(i);
+            }
+        }
+    }
+
+    //! resizes the caches to the number of segments
+    void resizeCache_() {
+        krs_.resize(radii_.size());
+        kxs_.resize(radii_.size());
+        radius_.resize(radii_.size());
+    }
+
+    //! evaluates the parameters of all segments
+    void updateCache_() {
+        resizeCache_();
+        forEach_(radii_.size(), [this](std::size_t eIdx) { evaluate_(eIdx); });
+    }
+
+    //! evaluates the parameters of the segments @param indices
+    void updateCache_(std::vector<std::size_t> indices) {
+        resizeCache_();
+        std::sort(indices.begin(), indices.end()); // each element once
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        forEach_(indices.size(), [&](std::size_t i) { evaluate_(indices[i]); });
+    }
+
     InputFileFunction kr_;
     InputFileFunction kx_;
     InputFileFunction kx0_;
@@ -218,6 +284,11 @@ private:
     std::vector<double> ids_; // [1]
     std::vector<double> orders_; // root order, or root type [1]
 
+    std::vector<double> krs_; // cached radial conductivities [m/Pa/s]
+    std::vector<double> kxs_; // cached axial conductivities [m^4/Pa/s]
+    std::vector<double> radius_; // cached radii, including the shoot [m]
+    std::unique_ptr<ThreadPool> pool_; // evaluates the cache in parallel
+
     double time_ = 0.; // [s]
     double dt_ = 0.;
     double time0_ = 0; // initial time [s]
@@ -7,6 +7,9 @@
 #include <map>
 
 #include <dumux/porousmediumflow/problem.hh>
+#include <dumux/multidomain/embedded/pointsourceproblem.hh> // point source map updated after growth
+#include <dumux/io/binarycheckpoint.hh>
+#include <dumux/io/timeseriesrecorder.hh>
 
 #include <dumux/growth/soillookup.hh>
 
@@ -25,9 +28,9 @@ namespace Dumux {
  * with optional coupling to a soil model
  */
 template<class TypeTag>
-class RootsProblem: public PorousMediumFlowProblem<TypeTag> {
+class RootsProblem: public EmbeddedPointSourceProblem<TypeTag> {
 
-    using ParentType = PorousMediumFlowProblem<TypeTag>;
+    using ParentType = EmbeddedPointSourceProblem<TypeTag>;
     using GridView = GetPropType<TypeTag, Properties::GridView>;
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     using ElementVolumeVariables = typename GetPropType<TypeTag, Properties::GridVolumeVariables>::LocalView;
@@ -80,75 +83,39 @@ public:
             collar_.setFunctionScale(1./(24.*3600)); // [kg/day] -> [kg/s]
             bcType_ = bcNeumann;
         }
-        file_at_.open(this->name() + "_actual_transpiration.txt");
+        transpiration_ = makeTimeSeriesRecorder(this->name() + "_actual_transpiration", ".txt");
+        transpiration_->addColumns({ "time", "actualTranspiration", "potentialTranspiration", "maximalTranspiration",
+            "collarPressure", "unused", "simTime" });
     }
 
     //! Destructor - close transpiration file
     virtual ~RootsProblem() {
         delete soil_;
         std::cout << "closing file \n" << std::flush;
-        file_at_.close();
+        transpiration_.reset(); // writes the remaining rows
     }
 
     //! evaluates user defined data for vtk fields
     void userData(std::string name, const SolutionVector& sol) {
+        userData(std::vector<std::string>{ name }, sol);
+    }
+
+    //! evaluates several user defined data fields in a single pass over the elements
+    void userData(const std::vector<std::string>& names, const SolutionVector& sol) {
         const auto& gridView = this->fvGridGeometry().gridView();
-        userData_[name] = std::vector<Scalar>(gridView.size(0));
-        auto eMapper = this->fvGridGeometry().elementMapper();
-        auto vMapper = this->fvGridGeometry().vertexMapper();
+        std::vector<std::pair<UserField, std::vector<Scalar>*>> fields;
+        fields.reserve(names.size());
+        for (const auto& name : names) { // dispatch on the names once, not per element
+            auto& data = userData_[name];
+            data.assign(gridView.size(0), 0.);
+            fields.emplace_back(userField_(name), &data);
+        }
+        const auto& eMapper = this->fvGridGeometry().elementMapper();
         for (const auto& e : elements(gridView)) {
             auto eIdx = eMapper.index(e);
-            double d = 0;
-            if (name=="kr") {
-                d = 1.e4*24.*3600.*this->spatialParams().kr(eIdx); // [m/Pa/s] -> [cm/hPa/day]
-            }
-            if (name=="kx") {
-                d = 1.e10*24.*3600.*this->spatialParams().kx(eIdx); // [m^4/Pa/s] -> [cm^4/hPa/day]
-            }
-            if (name=="age") {
-                d = this->spatialParams().age(eIdx) / 24. / 3600.; // s -> day
-            }
-            if (name=="order") {
-                d = this->spatialParams().order(eIdx);
-            }
-            if (name=="id") {
-                d = this->spatialParams().id(eIdx);
-            }
-            if (name=="radius") {
-                d = this->spatialParams().radius(eIdx);// m
+            for (const auto& f : fields) {
+                (*f.second)[eIdx] = userValue_(f.first, e, eIdx, sol);
             }
-            if (name=="initialPressure") {
-                d = initialAtPos(e.geometry().center()); // Pa
-                d = 100. * (d - pRef_) / rho_ / g_;  // Pa -> cm
-            }
-            if (name=="radialFlux") {
-                auto geo = e.geometry();
-                auto length = geo.volume();
-                auto kr = this->spatialParams().kr(eIdx);
-                auto a = this->spatialParams().radius(eIdx);
-                auto i0 = vMapper.subIndex(e, 0, 1);
-                auto i1 = vMapper.subIndex(e, 1, 1);
-                auto p = geo.center();
-                // kr [m /Pa/s]
-                d =  2 * a * M_PI * length* kr * (soil(p) - (sol[i1] + sol[i0]) / 2); // m^3 / s
-                d = 24.*3600*1.e6*d; // [m^3/s] -> [cm^3/day]
-            }
-            if (name=="axialFlux") {
-                auto geo = e.geometry();
-                auto length = geo.volume();
-                auto kx = this->spatialParams().kx(eIdx);
-                auto i0 = vMapper.subIndex(e, 0, 1);
-                auto i1 = vMapper.subIndex(e, 1, 1);
-                d = kx * ((sol[i1] - sol[i0]) / length - rho_ * g_); // m^3 / s
-                d = 24.*3600*1.e6*d; // [m^3/s] -> [cm^3/day]
-            }
-            if (name=="pSoil") {
-                auto i0 = vMapper.subIndex(e, 0, 1);
-                auto i1 = vMapper.subIndex(e, 1, 1);
-                d = 0.5 * (sol[i1][0] + sol[i0][0]);
-                d = 100. * (d - pRef_) / rho_ / g_;  // Pa -> cm
-            }
-            userData_[name][eIdx] = d;
         }
     }
 
@@ -353,6 +320,16 @@ public:
         dt_ = dt;
     }
 
+    //! stores the problem state that is not part of the solution (see BinaryCheckpointWriter)
+    void writeCheckpoint(BinaryCheckpointWriter& checkpoint) const {
+        checkpoint.write("RootProblem.critical", int(critical_));
+    }
+
+    //! restores the problem state from a checkpoint
+    void readCheckpoint(const BinaryCheckpointReader& checkpoint) {
+        critical_ = checkpoint.read<int>("RootProblem.critical");
+    }
+
     //! if true, sets bc to Dirichlet at criticalCollarPressure (false per default)
     void setCritical(bool b) {
         critical_ = b;
@@ -409,14 +386,20 @@ public:
     }
 
     /*!
-     * Writes the actual transpiration into a text file. Call postTimeStep before using it.
+     * Records the actual transpiration (written to a text or binary file, see makeTimeSeriesRecorder). Call postTimeStep before using it.
      *
      * 0 time [s], 1 actual transpiration [kg/s], 2 potential transpiration [kg/s], 3 maximal transpiration [kg/s],
      * 4 collar pressure [Pa], 5 - (0.) 6 simtime [s]
      */
     void writeTranspirationRate() {
-        file_at_ << neumannTime_ << ", " << actualTrans_ << ", " << potentialTrans_ << ", " << maxTrans_ << ", " << collarP_ << ", "
-            << 0. << ", "<< time_ << "\n";
+        transpiration_->record(neumannTime_, actualTrans_, potentialTrans_, maxTrans_, collarP_, 0., time_);
+    }
+
+    /*!
+     * Writes the recorded transpiration rates to the file (e.g. with a checkpoint)
+     */
+    void flushTimeSeries() {
+        transpiration_->flush();
     }
 
     /**
@@ -445,6 +428,70 @@ public:
 
 private:
 
+    enum class UserField { kr, kx, age, order, id, radius, initialPressure, radialFlux, axialFlux, pSoil, none };
+
+    static UserField userField_(const std::string& name) {
+        static const std::map<std::string, UserField> fields = {
+            { "kr", UserField::kr }, { "kx", UserField::kx }, { "age", UserField::age }, { "order", UserField::order },
+            { "id", UserField::id }, { "radius", UserField::radius }, { "initialPressure", UserField::initialPressure },
+            { "radialFlux", UserField::radialFlux }, { "axialFlux", UserField::axialFlux }, { "pSoil", UserField::pSoil } };
+        auto it = fields.find(name);
+        return (it != fields.end()) ? it->second : UserField::none; // unknown fields are zero
+    }
+
+    //! the user defined data of element e
+    Scalar userValue_(UserField field, const Element& e, std::size_t eIdx, const SolutionVector& sol) const {
+        const auto& vMapper = this->fvGridGeometry().vertexMapper();
+        switch (field) {
+        case UserField::kr:
+            return 1.e4*24.*3600.*this->spatialParams().kr(eIdx); // [m/Pa/s] -> [cm/hPa/day]
+        case UserField::kx:
+            return 1.e10*24.*3600.*this->spatialParams().kx(eIdx); // [m^4/Pa/s] -> [cm^4/hPa/day]
+        case UserField::age:
+            return this->spatialParams().age(eIdx) / 24. / 3600.; // s -> day
+        case UserField::order:
+            return this->spatialParams().order(eIdx);
+        case UserField::id:
+            return this->spatialParams().id(eIdx);
+        case UserField::radius:
+            return this->spatialParams().radius(eIdx);// m
+        case UserField::initialPressure: {
+            double d = initialAtPos(e.geometry().center()); // Pa
+            return 100. * (d - pRef_) / rho_ / g_;  // Pa -> cm
+        }
+        case UserField::radialFlux: {
+            auto geo = e.geometry();
+            auto length = geo.volume();
+            auto kr = this->spatialParams().kr(eIdx);
+            auto a = this->spatialParams().radius(eIdx);
+            auto i0 = vMapper.subIndex(e, 0, 1);
+            auto i1 = vMapper.subIndex(e, 1, 1);
+            auto p = geo.center();
+            // kr [m /Pa/s]
+            double d =  2 * a * M_PI * length* kr * (soil(p) - (sol[i1] + sol[i0]) / 2); // m^3 / s
+            return 24.*3600*1.e6*d; // [m^3/s] -> [cm^3/day]
+        }
+        case UserField::axialFlux: {
+            auto geo = e.geometry();
+            auto length = geo.volume();
+            auto kx = this->spatialParams().kx(eIdx);
+            auto i0 = vMapper.subIndex(e, 0, 1);
+            auto i1 = vMapper.subIndex(e, 1, 1);
+            double d = kx * ((sol[i1] - sol[i0]) / length - rho_ * g_); // m^3 / s
+            return 24.*3600*1.e6*d; // [m^3/s] -> [cm^3/day]
+        }
+        case UserField::pSoil: {
+            auto i0 = vMapper.subIndex(e, 0, 1);
+            auto i1 = vMapper.subIndex(e, 1, 1);
+            double d = 0.5 * (sol[i1][0] + sol[i0][0]);
+            return 100. * (d - pRef_) / rho_ / g_;  // Pa -> cm
+        }
+        default:
+            return 0.;
+        }
+    }
+
+
     bool onUpperBoundary_(const GlobalPosition &globalPos) const {  // on root collar
         return globalPos[dimWorld - 1] > this->fvGridGeometry().bBoxMax()[dimWorld - 1] - eps_;
     }
@@ -464,7 +511,7 @@ private:
     static constexpr Scalar pRef_ = 1.e5; // Pa
     static constexpr Scalar eps_ = 1e-6;
 
-    std::ofstream file_at_; // file for actual transpiration
+    std::unique_ptr<TimeSeriesRecorder> transpiration_; // actual transpiration per time step
     double neumannTime_ = 0;
     double actualTrans_ = 0;
     double potentialTrans_ = 0;
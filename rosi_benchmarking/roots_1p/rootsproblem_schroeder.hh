@@ -5,12 +5,12 @@
 
 #include <math.h>
 #include <map>
-#include <dumux/material/fluidmatrixinteractions/2p/regularizedvangenuchten.hh> // import for MaterialLaw Schroeder
+#include <dumux/material/fluidmatrixinteractions/tabulatedvangenuchten.hh> // import for MaterialLaw Schroeder
 #include <dumux/material/fluidmatrixinteractions/2p/efftoabslaw.hh>             // import for MaterialLaw Schroeder
-#include <dumux/external/brent/brent.hpp>                       //T.S.: Brent algorithm to find roots of function
 
 
 #include <dumux/porousmediumflow/problem.hh>
+#include <dumux/multidomain/embedded/pointsourceproblem.hh> // point source map updated after growth
 
 #include <dumux/growth/soillookup.hh>
 
@@ -29,9 +29,9 @@ namespace Dumux {
  * with optional coupling to a soil model
  */
 template<class TypeTag>
-class RootsProblem: public PorousMediumFlowProblem<TypeTag> {
+class RootsProblem: public EmbeddedPointSourceProblem<TypeTag> {
 
-    using ParentType = PorousMediumFlowProblem<TypeTag>;
+    using ParentType = EmbeddedPointSourceProblem<TypeTag>;
     using GridView = GetPropType<TypeTag, Properties::GridView>;
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     using ElementVolumeVariables = typename GetPropType<TypeTag, Properties::GridVolumeVariables>::LocalView;
@@ -49,7 +49,7 @@ class RootsProblem: public PorousMediumFlowProblem<TypeTag> {
     using SubControlVolumeFace = typename FVElementGeometry::SubControlVolumeFace;
     using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
     using CouplingManager= GetPropType<TypeTag, Properties::CouplingManager>;
-    using MaterialLaw = EffToAbsLaw<RegularizedVanGenuchten<Scalar>>;
+    using MaterialLaw = EffToAbsLaw<TabulatedVanGenuchten<Scalar>>; // same law as RichardsParams
     using MaterialLawParams = typename MaterialLaw::Params;
 
 
@@ -305,28 +305,6 @@ public:
      * that mass is created, negative ones mean that it vanishes.
      */
 
-    // Templates for brent-algorithm taken from https://stackoverflow.com/questions/51931479/conversion-between-stdfunctiondoubledouble-to-double-double
-    // note: function-builder-base and function builder need to be adapteded with 2x const each
-
-    // T.S: Function definition: integration by hand (calculate matric-flux-potential based on the currenct absolute pressure)
-    const Scalar pc_to_MFP(const auto& bulkElement, const Scalar pressure3D_pc, int n, const Scalar dx, const Scalar kc) const
-    {
-        Scalar cumSum =0;
-        for (int i=0; i<n+1; i++)
-        {
-            const auto& soilSpatialParams = couplingManager_->problem(Dune::index_constant<0>{}).spatialParams();
-            MaterialLawParams params = soilSpatialParams.materialLawParams(bulkElement);
-            Scalar xi = pressure3D_pc +i*dx; // pc value for sw call
-            Scalar funValue = MaterialLaw::sw(params, xi);
-            Scalar funValue2 = MaterialLaw::krw(params, funValue);
-            Scalar rectangleArea = funValue2*dx*kc; // height * base length
-            cumSum += rectangleArea*86400;
-            // CHECK UNITS! MFP from cm²/s into cm²/day for comparison with python script, assumption was that MFP should be m²/day, results indicate otherwise
-        }
-        return cumSum;
-    }
-
-
     template<class ElementVolumeVariables>
     void pointSource(PointSource& source, const Element &element, const FVElementGeometry& fvGeometry,
         const ElementVolumeVariables& elemVolVars, const SubControlVolume &scv) const
@@ -365,24 +343,17 @@ public:
                     const auto& soilProblem = couplingManager_->problem(Dune::index_constant<0>{});
                     const auto& gridGeometry = soilProblem.fvGridGeometry();
                     const auto& bulkElement = gridGeometry.element(bulkElementIdx);
-                    MaterialLawParams params = soilSpatialParams.materialLawParams(bulkElement);
+                    const MaterialLawParams& params = soilSpatialParams.materialLawParams(bulkElement);
 
                     // STEP 1) CALCULATE MFP_SOIL
-                    // Integration of soil hydraulic conductivity K(h) from -15.000 cm to current pressure head of soil element
+                    // Integral of soil hydraulic conductivity K(h) from -15.000 cm to current pressure head of soil element,
+                    // looked up from the table of the soil layer (see MFPTable)
 
                     const Scalar pressure3D_pc = -pressure3D + pRef_;
                     // upper integration boundary hc, soil point-source pressure [pc]
-                    const Scalar lowBound = -15000;
-                    const Scalar lowBound_pc = -toPa_(lowBound) +pRef_ ;
-                    // lower integration boundary (-15.000 cm) for MFP [pc]
-                    const int n = getParam<int>("Schroeder.n");
-                    // integration-steps (10000 gives good results for clay & loam, 40000 needed for sand & still not perfect)
-                    const Scalar dx = (const Scalar) (lowBound_pc - pressure3D_pc)/n;
-                    // step-length for integration
-                    Scalar kc = soilSpatialParams.hydraulicConductivity(bulkElement); // [m/s]
-                    // hydraulic conductivity of soil voxel
-                    const Scalar MFP_soil = pc_to_MFP(bulkElement, pressure3D_pc, n, dx, kc);
-                    // MFP of source-point soil voxel, call to integration function
+                    const auto& mfpTable = soilSpatialParams.mfpTable(bulkElement);
+                    const Scalar MFP_soil = mfpTable.mfp(pressure3D_pc);
+                    // MFP of source-point soil voxel
                     //std::cout << " pointSource_root " << source.id() << "MFP_soil (rootsproblem)= " << MFP_soil << "\n";
 
                     // STEP 2) CALCULATE MFP_ROOT (according to non-stressed equation of Schroeder)
@@ -420,13 +391,9 @@ public:
 
 
                     // STEP 3) TRANSFER MFP at root-surface back to a pressure value
-                    // parameters for Brent algorithm (finds zero of a function in a bracketing interval)
-                    double tolerance = brent::r8_epsilon ( );
-                    // error-tolerance parameter of brent-algorithm
-                    auto MFP_to_pressure3D = brent::funcLambda([=](double x) { return  pc_to_MFP(bulkElement, x, n, dx, kc) - MFP_nostress_root; });
-                    double z = brent::zero (lowBound_pc, 0, tolerance, MFP_to_pressure3D);
-                    const Scalar pressure3D_pc_new = z;
-                    const Scalar pressure3D_new = -1*(z-pRef_);
+                    // inverse table look up, clamped to the interval [-15.000 cm, 0 cm]
+                    const Scalar pressure3D_pc_new = mfpTable.inverse(MFP_nostress_root);
+                    const Scalar pressure3D_new = -1*(pressure3D_pc_new-pRef_);
 
 
                     // STEP 4) PASS NEW PRESSURE3D TO SOURCE-TERM
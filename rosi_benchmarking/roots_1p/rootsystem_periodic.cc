@@ -25,12 +25,15 @@
 #include <dumux/common/exceptions.hh>
 #include <dumux/common/properties.hh>
 #include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh> // DUMUX_PROFILE_ZONE
+#include <dumux/common/profiledsolvers.hh>
 #include <dumux/common/dumuxmessage.hh>
 #include <dumux/common/defaultusagemessage.hh>
 #include <dumux/common/geometry/boundingboxtree.hh>
 #include <dumux/common/geometry/geometricentityset.hh>
 #include <dumux/common/geometry/intersectingentities.hh>
 #include <dumux/linear/seqsolverbackend.hh>
+#include <dumux/linear/treeeliminationbackend.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 #include <dumux/assembly/fvassembler.hh>
 #include <dumux/io/grid/gridmanager.hh>
@@ -188,7 +191,7 @@ int main(int argc, char** argv) try
     std::cout << "vtk writer module initialized \n" << std::flush;
 
     // the assembler with time loop for instationary problem
-    using Assembler = FVAssembler<TypeTag, DiffMethod::numeric>;
+    using Assembler = ProfiledAssembler<FVAssembler<TypeTag, DiffMethod::numeric>>;
     std::shared_ptr<Assembler> assembler;
     if (tEnd > 0) {
         assembler = std::make_shared<Assembler>(problem, fvGridGeometry, gridVariables, timeLoop); // dynamic
@@ -197,7 +200,7 @@ int main(int argc, char** argv) try
     }
 
     // the linear solver
-    using LinearSolver = AMGBackend<TypeTag>; // how do i choose umfpack
+    using LinearSolver = ProfiledLinearSolver<TreeEliminationBackend>; // direct O(n) solver for the (periodic) root network
     auto linearSolver = std::make_shared<LinearSolver>(leafGridView, fvGridGeometry->dofMapper());
 
     // the non-linear solver
@@ -219,13 +222,17 @@ int main(int argc, char** argv) try
             problem->writeTranspirationRate(); // add transpiration data into the text file
 
             assembler->setPreviousSolution(xOld); // set previous solution for storage evaluations
-            nonLinearSolver.solve(x, *timeLoop); // solve the non-linear system with time step control
+            {
+                DUMUX_PROFILE_ZONE("newton solve");
+                nonLinearSolver.solve(x, *timeLoop); // solve the non-linear system with time step control
+            }
             xOld = x; // make the new solution the old solution
 
             gridVariables->advanceTimeStep();
             timeLoop->advanceTimeStep(); // advance to the time loop to the next step
 
             if ((timeLoop->isCheckPoint()) || (timeLoop->finished())) { // write vtk output (only at check points)
+                DUMUX_PROFILE_ZONE("output");
                 if (grow) { // prepare static fields also
                     problem->userData("radius", x);
                     problem->userData("order", x);
@@ -253,7 +260,10 @@ int main(int argc, char** argv) try
         std::cout << "a static model \n\n" << std::flush;
 
         assembler->setPreviousSolution(xOld); // set previous solution for storage evaluations
-        nonLinearSolver.solve(x); // solve the non-linear system
+        {
+            DUMUX_PROFILE_ZONE("newton solve");
+            nonLinearSolver.solve(x); // solve the non-linear system
+        }
 
         // write outputs
         problem->userData("p", x);
@@ -276,6 +286,8 @@ int main(int argc, char** argv) try
         Parameters::print();
     }
 
+    Profiler::instance().write(problem->name(), mpiHelper.getCollectiveCommunication()); // only with DUMUX_PROFILING
+
     return 0;
 } // end main
 catch (Dumux::ParameterException &e) {
@@ -8,6 +8,7 @@
 #include <map>
 
 #include <dumux/porousmediumflow/problem.hh>
+#include <dumux/multidomain/embedded/pointsourceproblem.hh> // point source map updated after growth
 #include <dumux/growth/soillookup.hh>
 
 //// maybe we will need it for advective flux approx
@@ -33,9 +34,9 @@ namespace Dumux {
  *
  */
 template<class TypeTag>
-class Roots1P2CProblem: public PorousMediumFlowProblem<TypeTag> {
+class Roots1P2CProblem: public EmbeddedPointSourceProblem<TypeTag> {
 
-    using ParentType = PorousMediumFlowProblem<TypeTag>;
+    using ParentType = EmbeddedPointSourceProblem<TypeTag>;
     using GridView = GetPropType<TypeTag, Properties::GridView>;
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     using ElementVolumeVariables = typename GetPropType<TypeTag, Properties::GridVolumeVariables>::LocalView;
@@ -8,6 +8,9 @@
 #include <map>
 
 #include <dumux/porousmediumflow/problem.hh>
+#include <dumux/multidomain/embedded/pointsourceproblem.hh> // point source map updated after growth
+#include <dumux/io/binarycheckpoint.hh>
+#include <dumux/io/timeseriesrecorder.hh>
 #include <dumux/growth/soillookup.hh>
 
 //// maybe we will need it for advective flux approx
@@ -33,9 +36,9 @@ namespace Dumux {
  *
  */
 template<class TypeTag>
-class RootsStomataProblem: public PorousMediumFlowProblem<TypeTag> {
+class RootsStomataProblem: public EmbeddedPointSourceProblem<TypeTag> {
 
-    using ParentType = PorousMediumFlowProblem<TypeTag>;
+    using ParentType = EmbeddedPointSourceProblem<TypeTag>;
     using GridView = GetPropType<TypeTag, Properties::GridView>;
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     using ElementVolumeVariables = typename GetPropType<TypeTag, Properties::GridVolumeVariables>::LocalView;
@@ -104,7 +107,9 @@ public:
             collar_.setFunctionScale(1./(24.*3600)); // [kg/day] -> [kg/s]
             bcType_ = bcNeumann;
         }
-        file_at_.open(this->name() + "_actual_transpiration.txt");
+        transpiration_ = makeTimeSeriesRecorder(this->name() + "_actual_transpiration", ".txt");
+        transpiration_->addColumns({ "time", "actualTranspiration", "potentialTranspiration", "maximalTranspiration",
+            "collarPressure", "unused", "simTime", "leafMass", "collarFlowRate", "rootMass", "sourceRate" });
 
         leafVolume_ = InputFileFunction("RootSystem.Leaf", "Volume", "VolumeT", 1.); // [cm^3]([day])
         leafVolume_.setVariableScale(1./(24.*3600)); // [s] -> [day]
@@ -139,7 +144,7 @@ public:
     virtual ~RootsStomataProblem() {
         delete soil_;
         std::cout << "closing file \n" << std::flush;
-        file_at_.close();
+        transpiration_.reset(); // writes the remaining rows
     }
 
     //! evaluates user defined data for vtk fields
@@ -449,6 +454,23 @@ public:
         dt_ = dt;
     }
 
+    //! stores the hormone masses and rates, that are integrated over time (see BinaryCheckpointWriter)
+    void writeCheckpoint(BinaryCheckpointWriter& checkpoint) const {
+        checkpoint.write("RootProblem.hormones", std::vector<double>{ mL_, mLRate_, mRoot_, mRootRate_ });
+    }
+
+    //! restores the hormone masses and rates from a checkpoint
+    void readCheckpoint(const BinaryCheckpointReader& checkpoint) {
+        const auto h = checkpoint.readVector<double>("RootProblem.hormones");
+        if (h.size() != 4) {
+            DUNE_THROW(Dune::IOError, "RootsProblem::readCheckpoint: unexpected number of hormone values");
+        }
+        mL_ = h[0];
+        mLRate_ = h[1];
+        mRoot_ = h[2];
+        mRootRate_ = h[3];
+    }
+
     //! sets the criticalCollarPressure [Pa]
     void criticalCollarPressure(Scalar p) {
         critPCollarDirichlet_ = p;
@@ -535,15 +557,22 @@ public:
     }
 
     /*!
-     * Writes the actual transpiration into a text file. Call postTimeStep before using it.
+     * Records the actual transpiration (written to a text or binary file, see makeTimeSeriesRecorder). Call postTimeStep before using it.
      *
      * 0 time [s], 1 actual transpiration [kg/s], 2 potential transpiration [kg/s], 3 maximal transpiration [kg/s],
      * 4 collar pressure [Pa], 5 - (0.), 6 simtime [s], 7 hormone leaf mass [kg],
      * 8 hormone collar flow rate [kg/s], 9 hormone root system mass [kg] , 10 hormone source rate [kg/s]
      */
     void writeTranspirationRate() {
-        file_at_ << neumannTime_ << ", " << actualTrans_ << ", " << potentialTrans_ << ", " << maxTrans_ << ", " << collarP_ << ", "
-            << 0. << ", "<< time_ << " , " << mL_ << ", "<< mLRate_  << ", " << mRoot_ << ", " << mRootRate_ << "\n";
+        transpiration_->record(neumannTime_, actualTrans_, potentialTrans_, maxTrans_, collarP_, 0., time_,
+                               mL_, mLRate_, mRoot_, mRootRate_);
+    }
+
+    /*!
+     * Writes the recorded transpiration rates and hormone masses to the file (e.g. with a checkpoint)
+     */
+    void flushTimeSeries() {
+        transpiration_->flush();
     }
 
     /**
@@ -595,7 +624,7 @@ protected:
     static constexpr Scalar pRef_ = 1.e5; // Pa
     static constexpr Scalar eps_ = 1e-6;
 
-    std::ofstream file_at_; // file for actual transpiration
+    std::unique_ptr<TimeSeriesRecorder> transpiration_; // actual transpiration and hormone masses per time step
     double neumannTime_ = 0;
     double actualTrans_ = 0;
     double potentialTrans_ = 0;
@@ -22,6 +22,8 @@
 // #include <dumux/common/properties.hh> // creates an undefined TypeTag types, and includes the property system
 // #include <dumux/common/properties/propertysystem.hh>
 #include <dumux/common/parameters.hh> // global parameter tree with defaults and parsed from args and .input file
+#include <dumux/common/profiler.hh> // DUMUX_PROFILE_ZONE
+#include <dumux/common/profiledsolvers.hh>
 #include <dumux/common/valgrind.hh> // for debugging
 #include <dumux/common/dumuxmessage.hh> // for fun (a static class)
 #include <dumux/common/defaultusagemessage.hh> // for information (a global function)
@@ -224,7 +226,7 @@ int main(int argc, char** argv) try
     std::cout << "vtk writer module initialized \n" << std::flush;
 
     // the assembler with time loop for instationary problem
-    using Assembler = FVAssembler<TypeTag, DiffMethod::numeric>;
+    using Assembler = ProfiledAssembler<FVAssembler<TypeTag, DiffMethod::numeric>>;
     std::shared_ptr<Assembler> assembler;
     if (tEnd > 0) {
         assembler = std::make_shared<Assembler>(problem, fvGridGeometry, gridVariables, timeLoop); // dynamic
@@ -233,7 +235,7 @@ int main(int argc, char** argv) try
     }
 
     // the linear solver
-    using LinearSolver = AMGBackend<TypeTag>; // how do i choose umfpack
+    using LinearSolver = ProfiledLinearSolver<AMGBackend<TypeTag>>; // how do i choose umfpack
     auto linearSolver = std::make_shared<LinearSolver>(leafGridView, fvGridGeometry->dofMapper());
 
     // the non-linear solver
@@ -283,13 +285,17 @@ int main(int argc, char** argv) try
             }
 
             assembler->setPreviousSolution(xOld); // set previous solution for storage evaluations
-            nonLinearSolver.solve(x, *timeLoop); // solve the non-linear system with time step control
+            {
+                DUMUX_PROFILE_ZONE("newton solve");
+                nonLinearSolver.solve(x, *timeLoop); // solve the non-linear system with time step control
+            }
             xOld = x; // make the new solution the old solution
 
             gridVariables->advanceTimeStep();
             timeLoop->advanceTimeStep(); // advance to the time loop to the next step
 
             if ((timeLoop->isCheckPoint()) || (timeLoop->finished())) { // write vtk output (only at check points)
+                DUMUX_PROFILE_ZONE("output");
                 if (grow) { // prepare static fields also
                     problem->userData("radius", x);
                     problem->userData("order", x);
@@ -317,7 +323,10 @@ int main(int argc, char** argv) try
         std::cout << "a static model \n\n" << std::flush;
 
         assembler->setPreviousSolution(xOld); // set previous solution for storage evaluations
-        nonLinearSolver.solve(x); // solve the non-linear system
+        {
+            DUMUX_PROFILE_ZONE("newton solve");
+            nonLinearSolver.solve(x); // solve the non-linear system
+        }
 
         // write outputs
         problem->userData("p", x);
@@ -340,6 +349,8 @@ int main(int argc, char** argv) try
         Parameters::print();
     }
 
+    Profiler::instance().write(problem->name(), mpiHelper.getCollectiveCommunication()); // only with DUMUX_PROFILING
+
     return 0;
 } // end main
 catch (Dumux::ParameterException &e) {
@@ -19,10 +19,17 @@
 #ifndef RICHARDS_PARAMETERS_HH
 #define RICHARDS_PARAMETERS_HH
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 #include <dumux/material/spatialparams/fv.hh>
 #include <dumux/material/fluidmatrixinteractions/2p/regularizedvangenuchten.hh>
 // #include <dumux/material/fluidmatrixinteractions/2p/vangenuchten.hh>
 #include <dumux/material/fluidmatrixinteractions/2p/efftoabslaw.hh>
+#include <dumux/material/fluidmatrixinteractions/tabulatedvangenuchten.hh>
+#include <dumux/material/fluidmatrixinteractions/mfptable.hh>
 
 #include <dumux/material/components/simpleh2o.hh>
 #include <dumux/material/fluidsystems/1pliquid.hh>
@@ -48,7 +55,7 @@ public:
     using Element = typename GridView::template Codim<0>::Entity;
     using GlobalPosition = typename Element::Geometry::GlobalCoordinate;
     using Water = Components::SimpleH2O<Scalar>;
-    using MaterialLaw = EffToAbsLaw<RegularizedVanGenuchten<Scalar>>;
+    using MaterialLaw = EffToAbsLaw<TabulatedVanGenuchten<Scalar>>;
     using MaterialLawParams = typename MaterialLaw::Params;
     using PermeabilityType = Scalar;
 
@@ -89,8 +96,18 @@ public:
             materialParams_.at(i).setKrnLowSw(eps);
             materialParams_.at(i).setKrwHighSw(1 - eps);
         }
+        // tabulated van Genuchten law (otherwise the analytic law is evaluated)
+        tabulated_ = Dumux::getParam<bool>("Soil.VanGenuchten.Tabulated", false);
+        tableSize_ = Dumux::getParam<int>("Soil.VanGenuchten.TableSize", 1000); // [1]
+        updateTables_();
+
         layerIdx_ = Dumux::getParam<int>("Soil.Grid.layerIdx", 1);
         layer_ = InputFileFunction("Soil.Layer", "Number", "Z", layerIdx_, 0); // [1]([m])
+        updateLayers();
+
+        // matric flux potential tables are only needed by the Schroeder rhizosphere model
+        mfpOn_ = Dumux::hasParam("Schroeder.gradients");
+        updateMFP_();
 
         // std::cout << "RichardsParams created: homogeneous " << homogeneous_ << " " << "\n" << std::endl;
     }
@@ -102,7 +119,7 @@ public:
     Scalar porosity(const Element& element,
                     const SubControlVolume& scv,
                     const ElementSolution& elemSol) const {
-        return phi_.at(index_(element));
+        return phi_[index_(element)];
     }
 
     /*!
@@ -110,7 +127,7 @@ public:
      * simper interface
      */
     Scalar porosity(const Element& element) const {
-        return phi_.at(index_(element));
+        return phi_[index_(element)];
     }
 
     /*!
@@ -125,19 +142,19 @@ public:
 
     //! simpler interface
     PermeabilityType permeability(const Element& element) const {
-        return k_.at(index_(element));
+        return k_[index_(element)];
     }
 
     /*
      * \brief Hydraulic conductivities [m/s], called by the problem for conversions
      */
     const Scalar hydraulicConductivity(const Element& element) const {
-        return kc_.at(index_(element));
+        return kc_[index_(element)];
     }
 
     //! set of VG parameters for the element
     const MaterialLawParams& materialLawParams(const Element& element) const {
-        return materialParams_.at(index_(element));
+        return materialParams_[index_(element)];
     }
 
     /*!
@@ -147,7 +164,16 @@ public:
     const MaterialLawParams& materialLawParams(const Element& element,
         const SubControlVolume& scv,
         const ElementSolution& elemSol) const {
-        return materialParams_.at(index_(element));
+        return materialParams_[index_(element)];
+    }
+
+    /*!
+     * \brief Tabulated matric flux potential of the element's soil layer (Schroeder et al. 2008)
+     *
+     * tables are built in the constructor, if the parameter group Schroeder is present
+     */
+    const MFPTable<MaterialLaw>& mfpTable(const Element& element) const {
+        return mfp_.at(index_(element));
     }
 
     //! pointer to the soils layer input file function
@@ -155,6 +181,65 @@ public:
         return &layer_;
     }
 
+    /**
+     * (Re)evaluates the soil layer of each element, must be called after the grid changed
+     *
+     * The layers are cached per element index (one byte per element),
+     * the parameter accessors are a look up in the cache.
+     */
+    void updateLayers() {
+        layerIndex_.clear();
+        layerElements_.assign(materialParams_.size(), {});
+        if (!homogeneous_) {
+            if (materialParams_.size() > std::numeric_limits<std::uint8_t>::max() + 1) {
+                DUNE_THROW(Dune::InvalidStateException, "RichardsParams: at most 256 soil layers are supported");
+            }
+            const auto& gridView = this->fvGridGeometry().gridView();
+            layerIndex_.resize(gridView.size(0));
+            for (const auto& element : elements(gridView)) {
+                auto eIdx = this->fvGridGeometry().elementMapper().index(element);
+                Scalar z = element.geometry().center()[dimWorld - 1];
+                int l = int(layer_.f(z, eIdx) - 1); // layer number starts with 1 in the input file
+                if ((l < 0) || (l >= int(materialParams_.size()))) {
+                    DUNE_THROW(Dune::InvalidStateException, "RichardsParams: soil layer " << l + 1 << " at z = " << z << " has no van Genuchten parameters");
+                }
+                layerIndex_[eIdx] = std::uint8_t(l);
+                layerElements_[l].push_back(eIdx);
+            }
+        }
+    }
+
+    /**
+     * Saturations [1] of all elements (by element index) at the water pressures pw [Pa] (by element index),
+     * as the Richards volume variables compute them: sw(max(pn - pw, pc(1))), for the cell-centered methods.
+     *
+     * The material law is evaluated per soil layer with the batched TabulatedVanGenuchten::sw.
+     *
+     * @param pw        water pressures [Pa]
+     * @param pn        reference pressure of the non-wetting phase [Pa]
+     * @param s         the saturations, resized to the size of pw
+     */
+    void saturations(const std::vector<Scalar>& pw, Scalar pn, std::vector<Scalar>& s) const {
+        s.resize(pw.size());
+        std::vector<Scalar> pc, swe;
+        for (std::size_t l = 0; l < materialParams_.size(); l++) {
+            const auto& params = materialParams_[l];
+            const std::size_t n = homogeneous_ ? pw.size() : layerElements_[l].size();
+            auto eIdx = [&](std::size_t i) { return homogeneous_ ? i : layerElements_[l][i]; };
+            const Scalar minPc = MaterialLaw::pc(params, 1.);
+            pc.resize(n);
+            swe.resize(n);
+            for (std::size_t i = 0; i < n; i++) {
+                pc[i] = std::max(pn - pw[eIdx(i)], minPc);
+            }
+            TabulatedVanGenuchten<Scalar>::sw(params, pc.data(), swe.data(), n);
+            const Scalar range = 1. - params.swr() - params.snr(); // effective to absolute, as EffToAbsLaw
+            for (std::size_t i = 0; i < n; i++) {
+                s[eIdx(i)] = swe[i] * range + params.swr();
+            }
+        }
+    }
+
     /**
      * Call to change default setting (of 1.e-6 for both)
      *
@@ -168,19 +253,47 @@ public:
             materialParams_.at(i).setKrnLowSw(krEps);
             materialParams_.at(i).setKrwHighSw(1 - krEps);
     	}
+    	updateTables_();
+    	updateMFP_();
     }
 
 private:
 
-    //! returns the index of the soil layer
+    //! (re)builds the van Genuchten tables per soil layer
+    void updateTables_() {
+        for (int i = 0; i < materialParams_.size(); i++) {
+            if (tabulated_) {
+                materialParams_.at(i).buildTable(tableSize_);
+                const auto* t = materialParams_.at(i).table();
+                if (this->fvGridGeometry().gridView().comm().rank() == 0) { // every rank builds the same tables
+                    std::cout << "RichardsParams: van Genuchten table of layer " << i << " (" << tableSize_ << " intervals), max errors: sw "
+                        << t->errorSw() << ", krw " << t->errorKrw() << ", pc (relative) " << t->errorPc() << "\n";
+                }
+            } else {
+                materialParams_.at(i).clearTable();
+            }
+        }
+    }
+
+    //! (re)builds the matric flux potential tables per soil layer
+    void updateMFP_() {
+        mfp_.clear();
+        if (mfpOn_) {
+            Scalar lowBound = Dumux::getParam<Scalar>("Schroeder.LowerBound", -15000); // [cm]
+            int n = Dumux::getParam<int>("Schroeder.TableSize", 2000); // [1]
+            Scalar pcLow = -lowBound / 100. * 1.e3 * g_; // [cm] -> [Pa]
+            for (int i = 0; i < materialParams_.size(); i++) {
+                mfp_.push_back(MFPTable<MaterialLaw>(materialParams_.at(i), kc_.at(i), pcLow, n));
+            }
+        }
+    }
+
+    //! returns the index of the soil layer (cached, see updateLayers)
     size_t index_(const Element& element) const {
         if (homogeneous_) {
             return 0;
         } else {
-            auto eIdx = this->fvGridGeometry().elementMapper().index(element);
-            Scalar z = element.geometry().center()[dimWorld - 1];
-            //std::cout << z << "\n";
-            return size_t(layer_.f(z, eIdx)-1); // layer number starts with 1 in the input file
+            return layerIndex_[this->fvGridGeometry().elementMapper().index(element)];
         }
     }
 
@@ -189,11 +302,19 @@ private:
     bool homogeneous_; // soil is homogeneous
     InputFileFunction layer_;
     int layerIdx_; // index of layer data within the grid
+    std::vector<std::uint8_t> layerIndex_; // soil layer per element index (empty if homogeneous)
+    std::vector<std::vector<std::size_t>> layerElements_; // element indices per soil layer (not used if homogeneous)
 
     std::vector<Scalar> k_; // permeability [m²]
     std::vector<Scalar> kc_; // hydraulic conductivity [m/s]
     std::vector<MaterialLawParams> materialParams_;
 
+    bool tabulated_ = false; // tabulated van Genuchten law
+    int tableSize_ = 1000; // number of table intervals
+
+    bool mfpOn_ = false; // build matric flux potential tables
+    std::vector<MFPTable<MaterialLaw>> mfp_; // per soil layer
+
     static constexpr Scalar g_ = 9.81; // cm / s^2
 
 };
@@ -4,6 +4,8 @@
 #define RICHARDS_PROBLEM_HH
 
 #include <dumux/porousmediumflow/problem.hh> // base class
+#include <dumux/multidomain/embedded/pointsourceproblem.hh> // point source map updated after growth
+#include <dumux/io/timeseriesrecorder.hh>
 
 #include "richardsparams.hh"
 
@@ -15,7 +17,7 @@ namespace Dumux {
  * where most parameters can be set dynamically
  */
 template <class TypeTag>
-class RichardsProblem : public PorousMediumFlowProblem<TypeTag>
+class RichardsProblem : public EmbeddedPointSourceProblem<TypeTag>
 {
 public:
 
@@ -73,7 +75,7 @@ public:
 	 * \brief Constructor: constructed in the main file
 	 */
 	RichardsProblem(std::shared_ptr<const FVGridGeometry> fvGridGeometry)
-	: PorousMediumFlowProblem<TypeTag>(fvGridGeometry) {
+	: EmbeddedPointSourceProblem<TypeTag>(fvGridGeometry) {
 
 		gravityOn_ = Dumux::getParam<bool>("Problem.EnableGravity", true);
 
@@ -94,10 +96,10 @@ public:
 		// IC
 		initialSoil_ = InputFileFunction("Soil.IC", "P", "Z", 0., this->spatialParams().layerIFF()); // [cm]([m]) pressure head, conversions hard coded
 		// Output
-		std::string filestr = this->name() + ".csv"; // output file
 		writeFile_ = getParam<bool>("Soil.Output.File", true);
 		if (writeFile_) {
-			myfile_.open(filestr.c_str());
+			boundaryFluxes_ = makeTimeSeriesRecorder(this->name(), ".csv");
+			boundaryFluxes_->addColumns({ "time", "fluxUpper", "fluxLower" });
 		}
 		std::cout << "RichardsProblem constructed: bcTopType " << bcTopType_ << ", " << bcTopValue_ << "; bcBotType "
 				<<  bcBotType_ << ", " << bcBotValue_ << ",  Output File " << writeFile_
@@ -110,7 +112,7 @@ public:
 	~RichardsProblem() {
 		if (writeFile_) {
 			std::cout << "closing file \n";
-			myfile_.close();
+			boundaryFluxes_.reset(); // writes the remaining rows
 		}
 	}
 
@@ -225,7 +227,7 @@ public:
 
 			Scalar s = elemVolVars[scvf.insideScvIdx()].saturation(0);
 			Scalar kc = this->spatialParams().hydraulicConductivity(element); //  [m/s]
-			MaterialLawParams params = this->spatialParams().materialLawParams(element);
+			const MaterialLawParams& params = this->spatialParams().materialLawParams(element);
 			Scalar p = MaterialLaw::pc(params, s) + pRef_; // [Pa]
 			Scalar h = -toHead_(p); // cm
 			GlobalPosition ePos = element.geometry().center();
@@ -480,11 +482,20 @@ public:
 	}
 
 	/*!
-	 * Writes the actual boundary fluxes (top and bottom) into a text file. Call postTimeStep before using it.
+	 * Records the actual boundary fluxes (top and bottom), see makeTimeSeriesRecorder. Call postTimeStep before using it.
 	 */
 	void writeBoundaryFluxes() {
 		if (writeFile_) {
-			myfile_ << time_ << ", " << bc_flux_upper << ", " << bc_flux_lower << "\n";
+			boundaryFluxes_->record(time_, bc_flux_upper, bc_flux_lower);
+		}
+	}
+
+	/*!
+	 * Writes the recorded boundary fluxes to the file (e.g. with a checkpoint)
+	 */
+	void flushTimeSeries() {
+		if (writeFile_) {
+			boundaryFluxes_->flush();
 		}
 	}
 
@@ -561,7 +572,7 @@ private:
 	Scalar dt_ = 0.;
 
 	bool writeFile_ = true;
-	std::ofstream myfile_;
+	std::unique_ptr<TimeSeriesRecorder> boundaryFluxes_;
 	Scalar bc_flux_upper = 0.;
 	Scalar bc_flux_lower = 0.;
 
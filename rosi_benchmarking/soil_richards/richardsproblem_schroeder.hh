@@ -4,11 +4,9 @@
 #define RICHARDS_PROBLEM_HH
 
 #include <dumux/porousmediumflow/problem.hh> // base class
+#include <dumux/multidomain/embedded/pointsourceproblem.hh> // point source map updated after growth
 
 #include "richardsparams.hh"
-#include <dumux/external/brent/brent.hpp>                  //T.S.: Brent algorithm to find roots of function
-
-
 
 namespace Dumux {
 
@@ -18,7 +16,7 @@ namespace Dumux {
  * where most parameters can be set dynamically
  */
 template <class TypeTag>
-class RichardsProblem : public PorousMediumFlowProblem<TypeTag>
+class RichardsProblem : public EmbeddedPointSourceProblem<TypeTag>
 {
 public:
 
@@ -75,7 +73,7 @@ public:
 	 * \brief Constructor: constructed in the main file
 	 */
 	RichardsProblem(std::shared_ptr<const FVGridGeometry> fvGridGeometry)
-	: PorousMediumFlowProblem<TypeTag>(fvGridGeometry) {
+	: EmbeddedPointSourceProblem<TypeTag>(fvGridGeometry) {
 
 		gravityOn_ = Dumux::getParam<bool>("Problem.EnableGravity", true);
 
@@ -360,49 +358,6 @@ public:
 	 * that mass is created, negative ones mean that it vanishes.
 	 */
 
-    // T.S: Function definition: integration by hand (calculate matric-flux-potential based on the currenct absolute pressure)
-    const Scalar pc_to_MFP(const Element &element, const Scalar pressure3D_pc, int n, const Scalar dx, const Scalar kc) const
-    {
-        Scalar cumSum =0;
-        for (int i=0; i<n+1; i++)
-        {
-
-            MaterialLawParams params = this->spatialParams().materialLawParams(element);
-            Scalar xi = pressure3D_pc +i*dx; // pc value for sw call
-            Scalar funValue = MaterialLaw::sw(params, xi);
-            Scalar funValue2 = MaterialLaw::krw(params, funValue);
-            Scalar rectangleArea = funValue2*dx*kc; // height * base length
-            cumSum += rectangleArea*86400;
-            // CHECK UNITS! MFP from cm²/s into cm²/day for comparison with python script, assumption was that MFP should be m²/day, results indicate otherwise
-        }
-        return cumSum;
-    }
-
-    // Templates for brent-algorithm taken from https://stackoverflow.com/questions/51931479/conversion-between-stdfunctiondoubledouble-to-double-double
-    // note: function-builder-base and function builder need to be adapteded with 2x const each
-
-    template <class Lambda>
-    class FunctionWithState : public brent::func_base, public Lambda {
-      public:
-         FunctionWithState(const Lambda & lambda): Lambda(lambda) {}
-         double operator()(double x) override
-         { return Lambda::operator()(x); }
-    };
-
-    template<class Lambda>
-    const auto function_builder_base (Lambda lambda) const
-    {
-        return FunctionWithState<decltype(lambda)>(lambda);
-    }
-
-
-    const auto function_builder(double a, double b, const Element &element, int n, const Scalar dx, const Scalar kc, const Scalar MFP_nostress_root) const
-    {
-        return function_builder_base([=]( double x) {
-            return  pc_to_MFP(element, x, n, dx, kc) - MFP_nostress_root;
-        });
-    }
-
 	template<class ElementVolumeVariables>
 	void pointSource(PointSource& source,
 			const Element &element,
@@ -433,22 +388,15 @@ public:
             // switch to enable/disable Schroeder and check for macroscopic flow from soil to root (Schroeder only used if source value < 0)
 
                 // STEP 1) CALCULATE MFP_SOIL
-                // Integration of soil hydraulic conductivity K(h) from -15.000 cm to current pressure head of soil element
+                // Integral of soil hydraulic conductivity K(h) from -15.000 cm to current pressure head of soil element,
+                // looked up from the table of the soil layer (see MFPTable)
 
                 const Scalar pressure3D_pc = -pressure3D + pRef_;
                 // upper integration boundary hc, soil point-source pressure [pc]
-                const Scalar lowBound = -15000;
-                const Scalar lowBound_pc = -toPa_(lowBound) +pRef_ ;
-                // lower integration boundary (-15.000 cm) for MFP [pc]
-                const int n = getParam<int>("Schroeder.n");
-                // integration-steps (10000 gives good results for clay & loam, 40000 needed for sand & still not perfect)
-                const Scalar dx = (const Scalar) (lowBound_pc - pressure3D_pc)/n;
-                // step-length for integration
+                const auto& mfpTable = this->spatialParams().mfpTable(element);
                 MaterialLawParams params = this->spatialParams().materialLawParams(element);
-                Scalar kc = this->spatialParams().hydraulicConductivity(element); // [m/s]
-                // hydraulic conductivity of soil voxel
-                const Scalar MFP_soil = pc_to_MFP(element, pressure3D_pc, n, dx, kc);
-                // MFP of source-point soil voxel, call to integration function
+                const Scalar MFP_soil = mfpTable.mfp(pressure3D_pc);
+                // MFP of source-point soil voxel
 
 
                 // STEP 2) CALCULATE MFP_ROOT (according to non-stressed equation of Schroeder)
@@ -487,13 +435,9 @@ public:
 
 
                 // STEP 3) TRANSFER MFP at root-surface back to a pressure value
-                // parameters for Brent algorithm (finds zero of a function in a bracketing interval)
-                double tolerance = brent::r8_epsilon ( );
-                // error-tolerance parameter of brent-algorithm
-                auto MFP_to_pressure3D = function_builder(lowBound_pc,  0, element,   n,   dx,   kc, MFP_nostress_root);
-                double z = brent::zero (lowBound_pc, 0, tolerance, MFP_to_pressure3D);
-                const Scalar pressure3D_pc_new = z;
-                const Scalar pressure3D_new = -1*(z-pRef_);
+                // inverse table look up, clamped to the interval [-15.000 cm, 0 cm]
+                const Scalar pressure3D_pc_new = mfpTable.inverse(MFP_nostress_root);
+                const Scalar pressure3D_new = -1*(pressure3D_pc_new-pRef_);
 
 
 
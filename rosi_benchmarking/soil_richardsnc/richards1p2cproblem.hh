@@ -4,6 +4,7 @@
 #define RICHARDS1P2C_PROBLEM_HH
 
 #include <dumux/porousmediumflow/problem.hh> // base class
+#include <dumux/multidomain/embedded/pointsourceproblem.hh> // point source map updated after growth
 
 #include "../soil_richards/richardsparams.hh"
 
@@ -15,7 +16,7 @@ namespace Dumux {
  * where most parameters can be set dynamically
  */
 template <class TypeTag>
-class Richards1P2CProblem : public PorousMediumFlowProblem<TypeTag>
+class Richards1P2CProblem : public EmbeddedPointSourceProblem<TypeTag>
 {
 public:
 
@@ -78,7 +79,7 @@ public:
 	 * \brief Constructor: constructed in the main file
 	 */
 	Richards1P2CProblem(std::shared_ptr<const FVGridGeometry> fvGridGeometry)
-	: PorousMediumFlowProblem<TypeTag>(fvGridGeometry) {
+	: EmbeddedPointSourceProblem<TypeTag>(fvGridGeometry) {
 
 		gravityOn_ = Dumux::getParam<bool>("Problem.EnableGravity", true);
 
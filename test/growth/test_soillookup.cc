@@ -0,0 +1,124 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test of the soil look up of the root growth (SoilLookUpBBoxTree): the batch evaluation on a
+ *        thread pool (getValues) and concurrent calls of getValue must give the serial results, starting
+ *        with a new look up, and the linear interpolation must reproduce a linear saturation field
+ */
+#include <config.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#include <dumux/common/threadpool.hh>
+#include <dumux/discretization/cellcentered/tpfa/fvgridgeometry.hh>
+#include <dumux/growth/soillookup.hh>
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+
+    Dune::MPIHelper::instance(argc, argv);
+
+    // soil of benchmark M1.2 [m], 8 x 8 x 15 cells
+    using Grid = Dune::YaspGrid<3, Dune::EquidistantOffsetCoordinates<double, 3>>;
+    using GlobalPosition = Dune::FieldVector<double, 3>;
+    const GlobalPosition lower = { -0.04, -0.04, -0.15 }, upper = { 0.04, 0.04, 0. };
+    Grid grid(lower, upper, std::array<int, 3>{ 8, 8, 15 });
+    using FVGridGeometry = CCTpfaFVGridGeometry<typename Grid::LeafGridView>;
+    FVGridGeometry gridGeometry(grid.leafGridView());
+    gridGeometry.update();
+
+    // a linear field is reproduced by the (tri)linear interpolation
+    auto field = [](double x, double y, double z) { return 0.3 + 0.5 * x - 0.8 * y + 1.2 * z; }; // [m]
+    std::vector<double> sat(grid.leafGridView().size(3));
+    for (const auto& vertex : vertices(grid.leafGridView())) {
+        const auto p = vertex.geometry().center();
+        sat[gridGeometry.vertexMapper().index(vertex)] = field(p[0], p[1], p[2]);
+    }
+
+    // sample points along random roots [cm], and some above the soil
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+    auto clamp = [](double x, double a, double b) { return std::min(std::max(x, a), b); };
+    std::vector<CPlantBox::Vector3d> pos;
+    for (int r = 0; r < 200; r++) {
+        CPlantBox::Vector3d p(3.9 * uniform(gen), 3.9 * uniform(gen), -7.5 + 7.4 * uniform(gen));
+        CPlantBox::Vector3d dir(uniform(gen), uniform(gen), -1.);
+        for (int i = 0; i < 500; i++) {
+            dir = CPlantBox::Vector3d(dir.x + 0.1 * uniform(gen), dir.y + 0.1 * uniform(gen), dir.z + 0.1 * uniform(gen));
+            dir.normalize();
+            p = p.plus(dir.times(0.05));
+            p = CPlantBox::Vector3d(clamp(p.x, -3.99, 3.99), clamp(p.y, -3.99, 3.99), clamp(p.z, -14.99, -0.01));
+            pos.push_back(p);
+        }
+        pos.push_back(CPlantBox::Vector3d(p.x, p.y, 1.)); // outside, 0
+    }
+
+    ThreadPool pool(4);
+    int failures = 0;
+
+    // new look up, first used by the pool (the local bases must not be created concurrently)
+    GrowthModule::SoilLookUpBBoxTree<FVGridGeometry> threaded(gridGeometry, sat, false);
+    const auto values = threaded.getValues(pos, &pool);
+
+    GrowthModule::SoilLookUpBBoxTree<FVGridGeometry> serial(gridGeometry, sat, false);
+    const auto serialValues = serial.getValues(pos);
+    std::vector<double> singleValues(pos.size());
+    for (std::size_t i = 0; i < pos.size(); i++) {
+        singleValues[i] = serial.getValue(pos[i]);
+    }
+
+    // concurrent getValue (e.g. the tropisms of different roots)
+    GrowthModule::SoilLookUpBBoxTree<FVGridGeometry> concurrent(gridGeometry, sat, false);
+    std::vector<double> concurrentValues(pos.size());
+    pool.parallelFor(pos.size(), [&](int i) { concurrentValues[i] = concurrent.getValue(pos[i]); });
+
+    double maxError = 0.;
+    for (std::size_t i = 0; i < pos.size(); i++) {
+        const double exact = pos[i].z > 0. ? 0. : field(0.01 * pos[i].x, 0.01 * pos[i].y, 0.01 * pos[i].z);
+        maxError = std::max(maxError, std::fabs(serialValues[i] - exact));
+        // the hint may pick the neighbour of a point within the tolerance of a face, i.e. round off differences
+        const double tol = 1.e-14;
+        if (std::fabs(values[i] - serialValues[i]) > tol || std::fabs(singleValues[i] - serialValues[i]) > tol
+            || std::fabs(concurrentValues[i] - serialValues[i]) > tol) {
+            if (failures < 10) {
+                std::cout << "point " << i << ": getValues " << serialValues[i] << ", getValue " << singleValues[i]
+                          << ", getValues on the thread pool " << values[i] << ", concurrent getValue " << concurrentValues[i] << "\n";
+            }
+            ++failures;
+        }
+    }
+    std::cout << pos.size() << " points, " << failures << " differ from the serial getValues, "
+              << "maximal error of the linear interpolation " << maxError << "\n";
+    if (maxError > 1.e-12) {
+        ++failures;
+    }
+
+    return failures > 0 ? 1 : 0;
+}
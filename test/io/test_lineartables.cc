@@ -0,0 +1,118 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test of the look up tables of InputFileFunction (LinearTables), which must give
+ *        bitwise the same values as Dumux::interpolate<InterpolationPolicy::LinearTable>
+ */
+#include <config.h>
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <dumux/common/math.hh>
+#include <dumux/io/inputfilefunction.hh>
+
+int main()
+{
+    using namespace Dumux;
+    using Table = std::pair<std::vector<double>, std::vector<double>>;
+
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+
+    std::vector<Table> tables;
+    Table t;
+    for (int i = 0; i <= 365; i++) { // equidistant (e.g. daily values), the O(1) look up
+        t.first.push_back(i * 0.1);
+        t.second.push_back(std::sin(i * 0.3));
+    }
+    tables.push_back(t);
+    t = Table();
+    for (int i = 0; i <= 100; i++) { // approximately equidistant, the O(1) estimate is corrected in both directions
+        t.first.push_back(-1. + i * 0.1 + (i % 3 == 1 ? 5.e-4 : 0.) - (i % 3 == 2 ? 5.e-4 : 0.));
+        t.second.push_back(uniform(gen));
+    }
+    tables.push_back(t);
+    t = Table();
+    double x = 0.;
+    for (int i = 0; i < 200; i++) { // not equidistant, binary search or the last interval
+        x += 0.1 + 10. * uniform(gen);
+        t.first.push_back(x);
+        t.second.push_back(uniform(gen) - 0.5);
+    }
+    tables.push_back(t);
+    tables.push_back(Table({-2., -0.5, -0.5, 0.}, {2., 2., 1., 1.})); // a jump (repeated x)
+    tables.push_back(Table({0., 1., 1., 1., 2., 3.}, {0., 1., 2., 3., 4., 5.}));
+    tables.push_back(Table({1.}, {5.})); // constant
+    tables.push_back(Table({-1., 1.}, {0., 2.}));
+
+    LinearTables linearTables;
+    for (const auto& table : tables) {
+        linearTables.push_back(table);
+    }
+
+    long failures = 0;
+    auto check = [&](std::size_t i, double ip)
+    {
+        const double a = interpolate<InterpolationPolicy::LinearTable>(ip, tables[i]);
+        const double b = linearTables(i, ip);
+        if (!(a == b) && !(std::isnan(a) && std::isnan(b))) {
+            if (failures < 10) {
+                std::cout.precision(17);
+                std::cout << "table " << i << " at " << ip << ": LinearTables " << b << ", interpolate " << a << "\n";
+            }
+            failures++;
+        }
+    };
+
+    for (std::size_t i = 0; i < tables.size(); i++) {
+        const auto& xs = tables[i].first;
+        const double lower = xs.front() - 0.1 * (xs.back() - xs.front()) - 1.;
+        const double upper = xs.back() + 0.1 * (xs.back() - xs.front()) + 1.;
+
+        // the sampling points, their neighbouring doubles, and outside of the table range
+        for (double v : xs) {
+            check(i, v);
+            check(i, std::nextafter(v, -std::numeric_limits<double>::infinity()));
+            check(i, std::nextafter(v, std::numeric_limits<double>::infinity()));
+        }
+        check(i, lower);
+        check(i, upper);
+        check(i, -std::numeric_limits<double>::infinity());
+        check(i, std::numeric_limits<double>::infinity());
+        check(i, std::numeric_limits<double>::quiet_NaN());
+
+        // random queries (the interval of the last call is rarely the right one)
+        for (int j = 0; j < 100000; j++) {
+            check(i, lower + (upper - lower) * uniform(gen));
+        }
+        // monotone queries (as a time series, the interval of the last call or its successor)
+        for (int j = 0; j <= 100000; j++) {
+            check(i, lower + (upper - lower) * j / 100000.);
+        }
+    }
+
+    std::cout << "LinearTables: " << failures << " values differ from interpolate<LinearTable>\n";
+    return failures > 0 ? 1 : 0;
+}
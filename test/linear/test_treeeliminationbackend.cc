@@ -0,0 +1,205 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test of the direct tree solver (TreeEliminationBackend) against a dense LU decomposition,
+ *        for the matrix of a root system, of a periodic root system (extra connections closing cycles),
+ *        after the values changed, and after the root system grew
+ */
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/matrixindexset.hh>
+
+#include <dumux/linear/treeeliminationbackend.hh>
+
+namespace Dumux {
+
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+
+/*!
+ * Cell centered matrix of a root network: segment i connects the nodes parent[i] and i + 1,
+ * and is coupled to all segments sharing one of its nodes (the line graph of the tree).
+ * The extra connections couple two segments directly (e.g. across a periodic boundary).
+ * The conductances are random and not symmetric, the diagonal is dominant.
+ */
+Matrix networkMatrix(const std::vector<int>& parent, const std::vector<std::pair<int, int>>& extra, std::mt19937& gen)
+{
+    const int n = parent.size();
+    std::vector<std::vector<int>> nodeSegments(n + 1);
+    for (int i = 0; i < n; i++) {
+        nodeSegments[parent[i]].push_back(i);
+        nodeSegments[i + 1].push_back(i);
+    }
+
+    std::vector<std::pair<int, int>> couplings;
+    for (const auto& segments : nodeSegments) {
+        for (int a : segments) {
+            for (int b : segments) {
+                if (a != b) {
+                    couplings.emplace_back(a, b);
+                }
+            }
+        }
+    }
+    for (const auto& c : extra) {
+        couplings.push_back(c);
+        couplings.emplace_back(c.second, c.first);
+    }
+
+    Dune::MatrixIndexSet pattern(n, n);
+    for (int i = 0; i < n; i++) {
+        pattern.add(i, i);
+    }
+    for (const auto& c : couplings) {
+        pattern.add(c.first, c.second);
+    }
+    Matrix A;
+    pattern.exportIdx(A);
+    A = 0.;
+
+    std::uniform_real_distribution<double> conductance(0.1, 1.);
+    for (int i = 0; i < n; i++) {
+        A[i][i] = 1.e-3; // e.g. the radial conductance to the soil
+    }
+    for (const auto& c : couplings) {
+        const double k = conductance(gen);
+        A[c.first][c.second] -= k;
+        A[c.first][c.first] += 1.01 * k;
+    }
+    return A;
+}
+
+//! random root system with n segments, mostly growing at the last segment (a root), sometimes branching
+std::vector<int> rootSystem(int n, std::mt19937& gen)
+{
+    std::vector<int> parent(n);
+    for (int i = 1; i < n; i++) {
+        parent[i] = (gen() % 10 < 8) ? i : gen() % (i + 1);
+    }
+    return parent;
+}
+
+//! maximal error of the tree solver relative to the dense LU decomposition, -1 if the tree solver failed
+double relativeError(TreeEliminationBackend& solver, const Matrix& A, std::mt19937& gen)
+{
+    const int n = A.N();
+    std::uniform_real_distribution<double> value(-1., 1.);
+    Vector b(n), x(n);
+    Dune::DynamicMatrix<double> dense(n, n, 0.);
+    Dune::DynamicVector<double> denseB(n), denseX(n);
+    for (int i = 0; i < n; i++) {
+        b[i] = denseB[i] = value(gen);
+    }
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            dense[row.index()][col.index()] = (*col)[0][0];
+        }
+    }
+    dense.solve(denseX, denseB);
+
+    if (!solver.solve(A, x, b)) {
+        return -1.;
+    }
+    double error = 0., norm = 0.;
+    for (int i = 0; i < n; i++) {
+        error = std::max(error, std::fabs(x[i][0] - denseX[i]));
+        norm = std::max(norm, std::fabs(denseX[i]));
+    }
+    return error / norm;
+}
+
+} // end namespace Dumux
+
+int main()
+{
+    using namespace Dumux;
+
+    std::mt19937 gen(3);
+    TreeEliminationBackend solver;
+    const double tolerance = 1.e-10;
+    int failures = 0;
+    auto check = [&](const char* name, const Matrix& A)
+    {
+        const double error = relativeError(solver, A, gen);
+        std::cout << name << ": " << A.N() << " segments, " << A.nonzeroes() << " matrix entries, "
+                  << solver.factorSize() << " entries of the factorization, relative error " << error << "\n";
+        if (!(error >= 0. && error < tolerance)) {
+            std::cout << "  the error exceeds the tolerance " << tolerance << "\n";
+            ++failures;
+        }
+    };
+
+    // root system (a tree), elimination without fill in
+    auto parent = rootSystem(400, gen);
+    Matrix A = networkMatrix(parent, {}, gen);
+    check("root system", A);
+    if (solver.factorSize() != A.nonzeroes()) {
+        std::cout << "  the factorization of a tree has fill in\n";
+        ++failures;
+    }
+
+    // same pattern with new values (the ordering is reused)
+    check("root system, new values", networkMatrix(parent, {}, gen));
+
+    // periodic root system, extra connections close cycles
+    std::vector<std::pair<int, int>> periodic;
+    while (periodic.size() < 10) {
+        const int a = gen() % parent.size(), b = gen() % parent.size();
+        if (a != b) {
+            periodic.emplace_back(a, b);
+        }
+    }
+    check("periodic root system", networkMatrix(parent, periodic, gen));
+
+    // grown root system (new pattern), and its periodic version
+    for (int i = 0; i < 100; i++) {
+        const int s = parent.size();
+        parent.push_back((gen() % 10 < 8) ? s : gen() % (s + 1));
+    }
+    check("grown root system", networkMatrix(parent, {}, gen));
+    check("grown periodic root system", networkMatrix(parent, periodic, gen));
+
+    // a vanishing pivot is reported, not solved
+    A = networkMatrix(parent, {}, gen);
+    for (auto col = A[7].begin(); col != A[7].end(); ++col) {
+        *col = 0.;
+    }
+    Vector x(A.N()), b(A.N());
+    b = 1.;
+    if (solver.solve(A, x, b)) {
+        std::cout << "the singular system was solved\n";
+        ++failures;
+    }
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test of the tabulated matric flux potential (MFPTable) against direct integration,
+ *        for the soils and the table size given in test_mfptable.input
+ */
+#include <config.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/material/fluidmatrixinteractions/2p/regularizedvangenuchten.hh>
+#include <dumux/material/fluidmatrixinteractions/2p/efftoabslaw.hh>
+#include <dumux/material/fluidmatrixinteractions/mfptable.hh>
+
+namespace Dumux {
+
+using MaterialLaw = EffToAbsLaw<RegularizedVanGenuchten<double>>;
+using MaterialLawParams = typename MaterialLaw::Params;
+
+//! adaptive Simpson quadrature of krw(sw(pc)) over [a, b]
+double integrate(const MaterialLawParams& params, double a, double b, double fa, double fm, double fb, double whole, double eps, int depth)
+{
+    auto f = [&](double pc) { return MaterialLaw::krw(params, MaterialLaw::sw(params, pc)); };
+    const double m = 0.5 * (a + b);
+    const double lm = 0.5 * (a + m), rm = 0.5 * (m + b);
+    const double flm = f(lm), frm = f(rm);
+    const double left = (m - a) / 6. * (fa + 4. * flm + fm);
+    const double right = (b - m) / 6. * (fm + 4. * frm + fb);
+    if (depth <= 0 || std::fabs(left + right - whole) <= 15. * eps)
+        return left + right + (left + right - whole) / 15.;
+    return integrate(params, a, m, fa, flm, fm, left, 0.5 * eps, depth - 1)
+         + integrate(params, m, b, fm, frm, fb, right, 0.5 * eps, depth - 1);
+}
+
+//! MFP(pc) = 86400 * kc * int_pc^pcLow krw(sw(xi)) dxi, integrated directly
+double directMFP(const MaterialLawParams& params, double kc, double pc, double pcLow)
+{
+    auto f = [&](double p) { return MaterialLaw::krw(params, MaterialLaw::sw(params, p)); };
+    const double fa = f(pc), fm = f(0.5 * (pc + pcLow)), fb = f(pcLow);
+    const double whole = (pcLow - pc) / 6. * (fa + 4. * fm + fb);
+    return 86400. * kc * integrate(params, pc, pcLow, fa, fm, fb, whole, 1.e-13 * (pcLow - pc), 50);
+}
+
+} // end namespace Dumux
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+    Dune::MPIHelper::instance(argc, argv);
+    Parameters::init(argc, argv);
+
+    const double rho = 1000., g = 9.81; // [kg/m^3], [m/s^2]
+    const auto qr = getParam<std::vector<double>>("Soil.VanGenuchten.Qr");
+    const auto qs = getParam<std::vector<double>>("Soil.VanGenuchten.Qs");
+    const auto alpha = getParam<std::vector<double>>("Soil.VanGenuchten.Alpha"); // [1/cm]
+    const auto n = getParam<std::vector<double>>("Soil.VanGenuchten.N");
+    const auto ks = getParam<std::vector<double>>("Soil.VanGenuchten.Ks"); // [cm/day]
+    const double lowerBound = getParam<double>("Schroeder.LowerBound"); // [cm]
+    const int tableSize = getParam<int>("Schroeder.TableSize");
+    const int points = getParam<int>("Test.Points");
+    const double mfpTolerance = getParam<double>("Test.MFPTolerance");
+    const double inverseTolerance = getParam<double>("Test.InverseTolerance");
+    const double pcLow = -lowerBound / 100. * rho * g; // [Pa]
+
+    int failures = 0;
+    for (std::size_t s = 0; s < qr.size(); ++s)
+    {
+        // parameters as in RichardsParams
+        MaterialLawParams params;
+        params.setSwr(qr[s] / qs[s]);
+        params.setSnr(0.);
+        params.setVgAlpha(alpha[s] * 100. / (rho * g));
+        params.setVgn(n[s]);
+        params.setPcLowSw(1.e-4);
+        params.setPcHighSw(1. - 1.e-4);
+        params.setKrnLowSw(1.e-4);
+        params.setKrwHighSw(1. - 1.e-4);
+        const double kc = ks[s] / 100. / 24. / 3600.; // [m/s]
+
+        const MFPTable<MaterialLaw> table(params, kc, pcLow, tableSize);
+        const double mfp0 = directMFP(params, kc, 0., pcLow); // MFP at saturation
+
+        double errorMFP = std::fabs(table.mfp(0.) - mfp0) / mfp0;
+        double errorInverse = 0.;
+        for (int i = 0; i < points; ++i)
+        {
+            const double h = -0.1 * std::pow(-lowerBound / 0.1, double(i) / (points - 1)); // [cm]
+            const double pc = std::min(-h / 100. * rho * g, pcLow); // [Pa]
+            const double mfp = directMFP(params, kc, pc, pcLow);
+            errorMFP = std::max(errorMFP, std::fabs(table.mfp(pc) - mfp) / mfp0);
+            // the inverse is ill-conditioned where krw is small, its error is measured in MFP
+            const double pcInverse = table.inverse(mfp);
+            errorInverse = std::max(errorInverse, std::fabs(directMFP(params, kc, pcInverse, pcLow) - mfp) / mfp0);
+        }
+
+        std::cout << "soil " << s << ": maximal relative error of the MFP " << errorMFP << ", of the inverse " << errorInverse << "\n";
+        if (errorMFP > mfpTolerance)
+        {
+            std::cout << "  MFP error exceeds the tolerance " << mfpTolerance << "\n";
+            ++failures;
+        }
+        if (errorInverse > inverseTolerance)
+        {
+            std::cout << "  inverse error exceeds the tolerance " << inverseTolerance << "\n";
+            ++failures;
+        }
+        // values outside of the table are clamped
+        if (table.inverse(2. * mfp0) != 0. || table.inverse(-1.) != pcLow)
+        {
+            std::cout << "  inverse is not clamped to [0, pcLow]\n";
+            ++failures;
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test of the tabulated van Genuchten law (TabulatedVanGenuchten): the interpolation errors
+ *        of the tables, the derivatives of the law, and the batched evaluation, for the soils given in
+ *        test_tabulatedvangenuchten.input
+ */
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/material/fluidmatrixinteractions/tabulatedvangenuchten.hh>
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+    Dune::MPIHelper::instance(argc, argv);
+    Parameters::init(argc, argv);
+
+    using MaterialLaw = TabulatedVanGenuchten<double>;
+    using MaterialLawParams = typename MaterialLaw::Params;
+
+    const double rho = 1000., g = 9.81; // [kg/m^3], [m/s^2]
+    const auto alpha = getParam<std::vector<double>>("Soil.VanGenuchten.Alpha"); // [1/cm]
+    const auto n = getParam<std::vector<double>>("Soil.VanGenuchten.N");
+    const int tableSize = getParam<int>("Soil.VanGenuchten.TableSize");
+    const double swTolerance = getParam<double>("Test.SwTolerance");
+    const double krwTolerance = getParam<double>("Test.KrwTolerance");
+    const double pcTolerance = getParam<double>("Test.PcTolerance");
+    const double derivativeTolerance = getParam<double>("Test.DerivativeTolerance");
+
+    int failures = 0;
+    auto check = [&](const char* name, double error, double tolerance)
+    {
+        if (error > tolerance)
+        {
+            std::cout << "  " << name << " error " << error << " exceeds the tolerance " << tolerance << "\n";
+            ++failures;
+        }
+    };
+
+    for (std::size_t s = 0; s < alpha.size(); ++s)
+    {
+        // parameters as in RichardsParams
+        MaterialLawParams params;
+        params.setVgAlpha(alpha[s] * 100. / (rho * g));
+        params.setVgn(n[s]);
+        params.setPcLowSw(1.e-4);
+        params.setPcHighSw(1. - 1.e-4);
+        params.setKrnLowSw(1.e-4);
+        params.setKrwHighSw(1. - 1.e-4);
+        params.buildTable(tableSize);
+        const auto* table = params.table();
+
+        // derivatives of the law within the tables, against central differences of the tabulated values
+        // (relative, differences below the round-off of the values are not resolved)
+        double errorDerivative = 0.;
+        auto derivative = [&](double d, double value, double valueMinus, double valuePlus, double h)
+        {
+            const double fd = (valuePlus - valueMinus) / (2. * h);
+            const double scale = std::max(std::fabs(fd), 1.e-11 * std::fabs(value) / h);
+            errorDerivative = std::max(errorDerivative, std::fabs(d - fd) / scale);
+        };
+        const int points = 1000;
+        const double pcMax = MaterialLaw::pc(params, params.pcLowSw());
+        for (int i = 1; i < points; ++i)
+        {
+            const double pc = pcMax * std::pow(1.e-8, double(i) / points); // log-spaced in (0, pcMax)
+            const double hp = 1.e-6 * pc;
+            derivative(MaterialLaw::dswe_dpc(params, pc), MaterialLaw::sw(params, pc),
+                       MaterialLaw::sw(params, pc - hp), MaterialLaw::sw(params, pc + hp), hp);
+
+            const double swe = 1. / (1. + std::exp(9. - 18. * i / points)); // logit-spaced in (1e-4, 1 - 1e-4)
+            const double hs = 1.e-6 * swe * (1. - swe);
+            derivative(MaterialLaw::dpc_dswe(params, swe), MaterialLaw::pc(params, swe),
+                       MaterialLaw::pc(params, swe - hs), MaterialLaw::pc(params, swe + hs), hs);
+            derivative(MaterialLaw::dkrw_dswe(params, swe), MaterialLaw::krw(params, swe),
+                       MaterialLaw::krw(params, swe - hs), MaterialLaw::krw(params, swe + hs), hs);
+        }
+
+        // the batched law must give the values of the pointwise law, also outside of the tables
+        std::vector<double> pcs, swes;
+        for (int i = 0; i <= points; ++i)
+        {
+            pcs.push_back(-1. + 1.1 * pcMax * std::pow(double(i) / points, 4)); // [-1 Pa, 1.1 pcMax]
+            swes.push_back(-0.01 + 1.02 * double(i) / points); // [-0.01, 1.01]
+        }
+        std::vector<double> batchSw(pcs.size()), batchKrw(swes.size()), batchPc(swes.size());
+        MaterialLaw::sw(params, pcs.data(), batchSw.data(), pcs.size());
+        MaterialLaw::krw(params, swes.data(), batchKrw.data(), swes.size());
+        MaterialLaw::pc(params, swes.data(), batchPc.data(), swes.size());
+        int batchDifferences = 0;
+        for (std::size_t i = 0; i < pcs.size(); ++i)
+        {
+            batchDifferences += (batchSw[i] != MaterialLaw::sw(params, pcs[i]));
+            batchDifferences += (batchKrw[i] != MaterialLaw::krw(params, swes[i]));
+            batchDifferences += (batchPc[i] != MaterialLaw::pc(params, swes[i]));
+        }
+
+        std::cout << "soil " << s << ": maximal errors of the tables (" << tableSize << " intervals): sw " << table->errorSw()
+                  << ", krw " << table->errorKrw() << ", pc (relative) " << table->errorPc() << "; derivatives " << errorDerivative
+                  << "; " << batchDifferences << " batched values differ\n";
+        check("batched", batchDifferences, 0);
+        check("sw", table->errorSw(), swTolerance);
+        check("krw", table->errorKrw(), krwTolerance);
+        check("pc", table->errorPc(), pcTolerance);
+        check("derivative", errorDerivative, derivativeTolerance);
+    }
+    return failures > 0 ? 1 : 0;
+}